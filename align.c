@@ -0,0 +1,23 @@
+#include "align.h"
+#include <stdlib.h>
+
+GL_MATRIX_API void* align_alloc(size_t size, size_t alignment) {
+    void* p;
+
+    // posix_memalign takes multiples of the pointer size only
+    if (alignment < sizeof(void*)) {
+        alignment = sizeof(void*);
+    }
+    if (posix_memalign(&p, alignment, size)) {
+        return NULL;
+    }
+    return p;
+}
+
+GL_MATRIX_API void align_free(void* p) {
+    free(p);
+}
+
+GL_MATRIX_API uint8_t align_check(const void* p, size_t alignment) {
+    return ((uintptr_t)p & (alignment - 1)) == 0;
+}
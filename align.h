@@ -0,0 +1,36 @@
+#ifndef ALIGN_H
+#define ALIGN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+
+/**
+ * Allocates memory aligned for the _aligned functions, e.g. an array of n
+ * matrices for mat4_multiply_n_aligned:
+ *
+ *     float* m = align_alloc(n * 16 * sizeof(float), MAT4_ALIGNMENT);
+ *
+ * @param {Number} size number of bytes
+ * @param {Number} alignment power of two, in bytes
+ * @returns {void*} the memory, to free with align_free, or NULL if it could not be allocated
+ */
+GL_MATRIX_API void* align_alloc(size_t size, size_t alignment);
+
+/**
+ * Frees memory from align_alloc
+ *
+ * @param {void*} p the memory, may be NULL
+ */
+GL_MATRIX_API void align_free(void* p);
+
+/**
+ * Returns whether a pointer has the given alignment
+ *
+ * @param {void*} p the pointer
+ * @param {Number} alignment power of two, in bytes
+ * @returns {uint8_t} 1 if p is a multiple of alignment, 0 otherwise
+ */
+GL_MATRIX_API uint8_t align_check(const void* p, size_t alignment);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef API_H
+#define API_H
+
+/**
+ * Prefix of every public function.
+ *
+ * Define GL_MATRIX_HEADER_ONLY before including gl-matrix.h to get every
+ * function as a static inline definition, so calls can be inlined into the
+ * caller without linking gl-matrix.a.
+ *
+ * Otherwise the functions are exported with default visibility, so the
+ * shared library can be built with -fvisibility=hidden and export nothing
+ * else.
+ */
+#ifdef GL_MATRIX_HEADER_ONLY
+#define GL_MATRIX_API static inline
+#elif defined(__GNUC__)
+#define GL_MATRIX_API __attribute__((visibility("default")))
+#else
+#define GL_MATRIX_API
+#endif
+
+/**
+ * Alignment of the storage types for the _aligned functions (mat4_aligned,
+ * vec4_aligned, ...). Compilers other than GCC and clang give them no extra
+ * alignment, so allocate them with align_alloc there.
+ */
+#if defined(__GNUC__)
+#define GL_MATRIX_ALIGNED(n) __attribute__((aligned(n)))
+#else
+#define GL_MATRIX_ALIGNED(n)
+#endif
+
+#endif
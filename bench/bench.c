@@ -0,0 +1,848 @@
+/*
+ * Micro-benchmarks for the public gl-matrix functions.
+ *
+ * Every case is timed in repeated runs after a warm-up. Each run calls the
+ * function enough times to take at least --min-time microseconds, and the
+ * report gives the median and 99th percentile time per call across runs.
+ * Batch cases (the *_n and SoA functions) also report the time per item.
+ *
+ * --baseline reads the csv output of an earlier run, e.g. of another build
+ * profile, and adds the speedup of every case over it and their geometric
+ * mean.
+ *
+ *   bench [--format text|csv|json] [--runs N] [--min-time US] [--filter STR] [--baseline CSV]
+ */
+#include "gl-matrix.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#else
+#define BENCH_HAVE_TSC 0
+#endif
+
+#define POOL 64
+#define BATCH 1024
+
+// Keep the compiler from dropping calls or their results
+#define KEEP(v) __asm__ volatile("" : : "g"(v) : "memory")
+
+enum { KIND_MAT2, KIND_MAT3, KIND_MAT3P, KIND_MAT4, KIND_VEC, KIND_QUAT, KIND_BATCH, KIND_COUNT };
+
+// Read-only operands, one slot per pool entry
+static float mat2s[POOL * 4];
+static float mat3s[POOL * 9];
+static float mat3ps[POOL * 12] GL_MATRIX_ALIGNED(MAT3_ALIGNMENT);
+static float mat4s[POOL * 16] GL_MATRIX_ALIGNED(MAT4_ALIGNMENT);
+static float vecs[POOL * 4];
+static float quats[POOL * 4] GL_MATRIX_ALIGNED(MAT4_ALIGNMENT);
+static float up[3] = { 0, 1, 0 };
+
+// Receiving operands, reset from pristine[kind] before every run
+static float work[POOL * 16] GL_MATRIX_ALIGNED(MAT4_ALIGNMENT);
+static float pristine[KIND_COUNT][POOL * 16];
+
+// Batch operands
+static float batch_work[BATCH * 16] GL_MATRIX_ALIGNED(MAT4_ALIGNMENT);
+static float batch_pristine[BATCH * 16];
+static float batch_src[BATCH * 16] GL_MATRIX_ALIGNED(MAT4_ALIGNMENT);
+static float batch43_work[BATCH * 12];
+static float batch43_pristine[BATCH * 12];
+static float batch43_src[BATCH * 12];
+static float batch_quats[BATCH * 4];
+static float batch_quats_pristine[BATCH * 4];
+static float batch_quats_b[BATCH * 4];
+static float batch_t[BATCH];
+static uint16_t batch_packed48[BATCH * 3];
+static uint32_t batch_packed32[BATCH];
+
+// Packed vertex streams of BATCH vec3s, and BATCH unit normals
+static float batch_normals[BATCH * 3];
+static uint16_t batch_half[BATCH * 3];
+static int16_t batch_snorm[BATCH * 3];
+static uint8_t batch_unorm[BATCH * 3];
+static int16_t batch_oct[BATCH * 2];
+static float batch_out[BATCH];
+static uint8_t batch_bits[BATCH / 8];
+static float planes[24];
+static float soa_a[4][BATCH], soa_b[4][BATCH];
+static vec3soa soa3_a = { soa_a[0], soa_a[1], soa_a[2] };
+static vec3soa soa3_b = { soa_b[0], soa_b[1], soa_b[2] };
+static vec4soa soa4_a = { soa_a[0], soa_a[1], soa_a[2], soa_a[3] };
+static vec4soa soa4_b = { soa_b[0], soa_b[1], soa_b[2], soa_b[3] };
+
+// Double precision copies of the operands above
+static double mat2ds[POOL * 4];
+static double mat3ds[POOL * 9];
+static double mat4ds[POOL * 16];
+static double vecds[POOL * 4];
+static double quatds[POOL * 4];
+static double quat2ds[POOL * 8];
+static double workd[POOL * 16];
+static double pristined[KIND_COUNT][POOL * 16];
+static double batchd_work[BATCH * 16];
+static double batchd_pristine[BATCH * 16];
+static double batchd_src[BATCH * 16];
+static double origin_d[3] = { 6371e3, 1234.5, -42.25 };
+
+// A mesh skinned by the POOL mat4s, or by dual quats of the same transforms
+static uint16_t skin_joints[BATCH * 4];
+static float skin_weights[BATCH * 4];
+static float quat2s[POOL * 8];
+static skin mesh = {
+    batch_src, batch_src + BATCH * 3, skin_joints, skin_weights, mat4s, batch_work, batch_work + BATCH * 3, BATCH
+};
+static skin mesh_dq = {
+    batch_src, batch_src + BATCH * 3, skin_joints, skin_weights, quat2s, batch_work, batch_work + BATCH * 3, BATCH
+};
+
+// A point cloud for the thread pool, large enough to be split
+#define CLOUD (256 * 1024)
+static float cloud_src[CLOUD * 3];
+static float cloud_dst[CLOUD * 3];
+static pool workers;
+static pool_op cloud_op = { POOL_VEC3_TRANSFORM_MAT4, 0, 0, cloud_src, 0, NULL, NULL, NULL };
+
+// A 4-ary tree of BATCH nodes
+static int32_t tree_parent[BATCH];
+static float tree_trs[BATCH * 10];
+static float tree_local[BATCH * 16];
+static float tree_world[BATCH * 16];
+static uint8_t tree_dirty[BATCH];
+static hierarchy tree = {
+    tree_parent, tree_trs, tree_trs + BATCH * 3, tree_trs + BATCH * 7, tree_local, tree_world, tree_dirty, BATCH
+};
+
+/*
+ * X(name, kind, items per call, body)
+ *
+ * Bodies run with d pointing at a receiving slot of the case's kind and
+ * m2, m3, m4, v, u, q, dq, dq2, p48, p32 pointing at read-only operands. Double
+ * precision cases use dd and m2d, m3d, m4d, vd, ud, qd, dqd instead.
+ * mat4_dump is left out since it only writes to stderr.
+ */
+#define CASES(X) \
+    X(mat2_identity, KIND_MAT2, 1, mat2_identity(d)) \
+    X(mat2_copy, KIND_MAT2, 1, mat2_copy(d, m2)) \
+    X(mat2_transpose, KIND_MAT2, 1, mat2_transpose(d)) \
+    X(mat2_invert, KIND_MAT2, 1, mat2_invert(d)) \
+    X(mat2_adjoint, KIND_MAT2, 1, mat2_adjoint(d)) \
+    X(mat2_determinant, KIND_MAT2, 1, KEEP(mat2_determinant(d))) \
+    X(mat2_multiply, KIND_MAT2, 1, mat2_multiply(d, m2)) \
+    X(mat2_rotate, KIND_MAT2, 1, mat2_rotate(d, 0.1f)) \
+    X(mat2_scale, KIND_MAT2, 1, mat2_scale(d, v)) \
+    X(mat2_fromRotation, KIND_MAT2, 1, mat2_fromRotation(d, 0.1f)) \
+    X(mat2_fromScaling, KIND_MAT2, 1, mat2_fromScaling(d, v)) \
+    X(mat2_add, KIND_MAT2, 1, mat2_add(d, m2)) \
+    X(mat2_subtract, KIND_MAT2, 1, mat2_subtract(d, m2)) \
+    X(mat2_equals, KIND_MAT2, 1, KEEP(mat2_equals(d, m2))) \
+    X(mat2_multiplyScalar, KIND_MAT2, 1, mat2_multiplyScalar(d, 1.0f)) \
+    X(mat2_multiplyScalarAndAdd, KIND_MAT2, 1, mat2_multiplyScalarAndAdd(d, m2, 0.5f)) \
+    X(mat3_fromMat4, KIND_MAT3, 1, mat3_fromMat4(d, m4)) \
+    X(mat3_copy, KIND_MAT3, 1, mat3_copy(d, m3)) \
+    X(mat3_set, KIND_MAT3, 1, mat3_set(d, 1, 0, 0, 0, 1, 0, 0, 0, 1)) \
+    X(mat3_identity, KIND_MAT3, 1, mat3_identity(d)) \
+    X(mat3_transpose, KIND_MAT3, 1, mat3_transpose(d)) \
+    X(mat3_invert, KIND_MAT3, 1, mat3_invert(d)) \
+    X(mat3_adjoint, KIND_MAT3, 1, mat3_adjoint(d)) \
+    X(mat3_determinant, KIND_MAT3, 1, KEEP(mat3_determinant(d))) \
+    X(mat3_multiply, KIND_MAT3, 1, mat3_multiply(d, m3)) \
+    X(mat3_translate, KIND_MAT3, 1, mat3_translate(d, v)) \
+    X(mat3_rotate, KIND_MAT3, 1, mat3_rotate(d, 0.1f)) \
+    X(mat3_scale, KIND_MAT3, 1, mat3_scale(d, v)) \
+    X(mat3_fromTranslation, KIND_MAT3, 1, mat3_fromTranslation(d, v)) \
+    X(mat3_fromRotation, KIND_MAT3, 1, mat3_fromRotation(d, 0.1f)) \
+    X(mat3_fromScaling, KIND_MAT3, 1, mat3_fromScaling(d, v)) \
+    X(mat3_fromMat2d, KIND_MAT3, 1, mat3_fromMat2d(d, m3)) \
+    X(mat3_fromQuat, KIND_MAT3, 1, mat3_fromQuat(d, q)) \
+    X(mat3_normalFromMat4, KIND_MAT3, 1, mat3_normalFromMat4(d, m4)) \
+    X(mat3_projection, KIND_MAT3, 1, mat3_projection(d, 640, 480)) \
+    X(mat3_frob, KIND_MAT3, 1, KEEP(mat3_frob(d))) \
+    X(mat3_add, KIND_MAT3, 1, mat3_add(d, m3)) \
+    X(mat3_subtract, KIND_MAT3, 1, mat3_subtract(d, m3)) \
+    X(mat3_multiplyScalar, KIND_MAT3, 1, mat3_multiplyScalar(d, 1.0f)) \
+    X(mat3_multiplyScalarAndAdd, KIND_MAT3, 1, mat3_multiplyScalarAndAdd(d, m3, 0.5f)) \
+    X(mat3_equals, KIND_MAT3, 1, KEEP(mat3_equals(d, m3))) \
+    X(mat3_toPadded, KIND_MAT3P, 1, mat3_toPadded(d, m3)) \
+    X(mat3_fromPadded, KIND_MAT3, 1, mat3_fromPadded(d, p3)) \
+    X(mat3_multiply_padded, KIND_MAT3P, 1, mat3_multiply_padded(d, p3)) \
+    X(mat3_transpose_padded, KIND_MAT3P, 1, mat3_transpose_padded(d)) \
+    X(mat3_invert_padded, KIND_MAT3P, 1, mat3_invert_padded(d)) \
+    X(mat3_normalFromMat4_padded, KIND_MAT3P, 1, mat3_normalFromMat4_padded(d, m4)) \
+    X(mat3_normalFromMat4_padded_n, KIND_BATCH, BATCH, mat3_normalFromMat4_padded_n(batch_work, batch_src, BATCH)) \
+    X(mat4_identity, KIND_MAT4, 1, mat4_identity(d)) \
+    X(mat4_copy, KIND_MAT4, 1, mat4_copy(d, m4)) \
+    X(mat4_set, KIND_MAT4, 1, mat4_set(d, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1)) \
+    X(mat4_transpose, KIND_MAT4, 1, mat4_transpose(d)) \
+    X(mat4_invert, KIND_MAT4, 1, mat4_invert(d)) \
+    X(mat4_invertAffine, KIND_MAT4, 1, mat4_invertAffine(d)) \
+    X(mat4_invertRigid, KIND_MAT4, 1, mat4_invertRigid(d)) \
+    X(mat4_invert_n, KIND_BATCH, BATCH, mat4_invert_n(batch_work, NULL, BATCH)) \
+    X(mat4_invert_n_aligned, KIND_BATCH, BATCH, mat4_invert_n_aligned(batch_work, NULL, BATCH)) \
+    X(mat4_adjoint, KIND_MAT4, 1, mat4_adjoint(d)) \
+    X(mat4_determinant, KIND_MAT4, 1, KEEP(mat4_determinant(d))) \
+    X(mat4_multiply, KIND_MAT4, 1, mat4_multiply(d, m4)) \
+    X(mat4_multiply_aligned, KIND_MAT4, 1, mat4_multiply_aligned(d, m4)) \
+    X(mat4_multiply_n, KIND_BATCH, BATCH, mat4_multiply_n(batch_work, m4, BATCH)) \
+    X(mat4_multiply_n_aligned, KIND_BATCH, BATCH, mat4_multiply_n_aligned(batch_work, m4, BATCH)) \
+    X(mat4_multiplyPairwise_n, KIND_BATCH, BATCH, mat4_multiplyPairwise_n(batch_work, batch_src, BATCH)) \
+    X(mat4_translate, KIND_MAT4, 1, mat4_translate(d, v)) \
+    X(mat4_translatef, KIND_MAT4, 1, mat4_translatef(d, 1, 2, 3)) \
+    X(mat4_scale, KIND_MAT4, 1, mat4_scale(d, v)) \
+    X(mat4_rotate, KIND_MAT4, 1, mat4_rotate(d, 0.1f, v)) \
+    X(mat4_rotateX, KIND_MAT4, 1, mat4_rotateX(d, 0.1f)) \
+    X(mat4_rotateY, KIND_MAT4, 1, mat4_rotateY(d, 0.1f)) \
+    X(mat4_rotateZ, KIND_MAT4, 1, mat4_rotateZ(d, 0.1f)) \
+    X(mat4_fromTranslation, KIND_MAT4, 1, mat4_fromTranslation(d, v)) \
+    X(mat4_fromScaling, KIND_MAT4, 1, mat4_fromScaling(d, v)) \
+    X(mat4_fromRotation, KIND_MAT4, 1, mat4_fromRotation(d, 0.1f, v)) \
+    X(mat4_fromXRotation, KIND_MAT4, 1, mat4_fromXRotation(d, 0.1f)) \
+    X(mat4_fromYRotation, KIND_MAT4, 1, mat4_fromYRotation(d, 0.1f)) \
+    X(mat4_fromZRotation, KIND_MAT4, 1, mat4_fromZRotation(d, 0.1f)) \
+    X(mat4_fromRotationTranslation, KIND_MAT4, 1, mat4_fromRotationTranslation(d, q, v)) \
+    X(mat4_getTranslation, KIND_VEC, 1, mat4_getTranslation(d, m4)) \
+    X(mat4_getScaling, KIND_VEC, 1, mat4_getScaling(d, m4)) \
+    X(mat4_getRotation, KIND_QUAT, 1, mat4_getRotation(d, m4)) \
+    X(mat4_fromRotationTranslationScale, KIND_MAT4, 1, mat4_fromRotationTranslationScale(d, q, v, u)) \
+    X(mat4_fromRotationTranslationScaleOrigin, KIND_MAT4, 1, mat4_fromRotationTranslationScaleOrigin(d, q, v, u, v)) \
+    X(mat4_fromQuat, KIND_MAT4, 1, mat4_fromQuat(d, q)) \
+    X(mat4_frustum, KIND_MAT4, 1, mat4_frustum(d, -1, 1, -1, 1, 0.1f, 100)) \
+    X(mat4_perspective, KIND_MAT4, 1, mat4_perspective(d, 1.0f, 1.5f, 0.1f, 100)) \
+    X(mat4_ortho, KIND_MAT4, 1, mat4_ortho(d, -1, 1, -1, 1, 0.1f, 100)) \
+    X(mat4_lookAt, KIND_MAT4, 1, mat4_lookAt(d, v, u, up)) \
+    X(mat4_targetTo, KIND_MAT4, 1, mat4_targetTo(d, v, u, up)) \
+    X(mat4_frob, KIND_MAT4, 1, KEEP(mat4_frob(d))) \
+    X(mat4_add, KIND_MAT4, 1, mat4_add(d, m4)) \
+    X(mat4_subtract, KIND_MAT4, 1, mat4_subtract(d, m4)) \
+    X(mat4_multiplyScalar, KIND_MAT4, 1, mat4_multiplyScalar(d, 1.0f)) \
+    X(mat4_multiplyScalarAndAdd, KIND_MAT4, 1, mat4_multiplyScalarAndAdd(d, m4, 0.5f)) \
+    X(mat4_equals, KIND_MAT4, 1, KEEP(mat4_equals(d, m4))) \
+    X(mat4x3_fromMat4_n, KIND_BATCH, BATCH, mat4x3_fromMat4_n(batch43_work, batch_src, BATCH)) \
+    X(mat4x3_toMat4_n, KIND_BATCH, BATCH, mat4x3_toMat4_n(batch_work, batch43_src, BATCH)) \
+    X(mat4x3_fromRotationTranslationScale_n, KIND_BATCH, BATCH, \
+        mat4x3_fromRotationTranslationScale_n(batch43_work, batch_quats_b, batch_normals, batch_normals, BATCH)) \
+    X(mat4x3_multiply_n, KIND_BATCH, BATCH, mat4x3_multiply_n(batch43_work, batch43_src, BATCH)) \
+    X(mat4x3_multiplyPairwise_n, KIND_BATCH, BATCH, mat4x3_multiplyPairwise_n(batch43_work, batch43_src, BATCH)) \
+    X(mat4x3_invert_n, KIND_BATCH, BATCH, mat4x3_invert_n(batch43_work, NULL, BATCH)) \
+    X(mat4x3_transformPoint_n, KIND_BATCH, BATCH, mat4x3_transformPoint_n(batch_work, 0, batch_src, 0, batch43_src, BATCH)) \
+    X(mat4x3_transformVector_n, KIND_BATCH, BATCH, mat4x3_transformVector_n(batch_work, 0, batch_src, 0, batch43_src, BATCH)) \
+    X(vec2_copy, KIND_VEC, 1, vec2_copy(d, v)) \
+    X(vec2_set, KIND_VEC, 1, vec2_set(d, 1, 2)) \
+    X(vec2_add, KIND_VEC, 1, vec2_add(d, v)) \
+    X(vec2_subtract, KIND_VEC, 1, vec2_subtract(d, v)) \
+    X(vec2_multiply, KIND_VEC, 1, vec2_multiply(d, v)) \
+    X(vec2_divide, KIND_VEC, 1, vec2_divide(d, v)) \
+    X(vec2_ceil, KIND_VEC, 1, vec2_ceil(d)) \
+    X(vec2_floor, KIND_VEC, 1, vec2_floor(d)) \
+    X(vec2_min, KIND_VEC, 1, vec2_min(d, v)) \
+    X(vec2_max, KIND_VEC, 1, vec2_max(d, v)) \
+    X(vec2_round, KIND_VEC, 1, vec2_round(d)) \
+    X(vec2_scale, KIND_VEC, 1, vec2_scale(d, 1.0f)) \
+    X(vec2_scaleAndAdd, KIND_VEC, 1, vec2_scaleAndAdd(d, v, 0.5f)) \
+    X(vec2_distance, KIND_VEC, 1, KEEP(vec2_distance(d, v))) \
+    X(vec2_squaredDistance, KIND_VEC, 1, KEEP(vec2_squaredDistance(d, v))) \
+    X(vec2_length, KIND_VEC, 1, KEEP(vec2_length(d))) \
+    X(vec2_squaredLength, KIND_VEC, 1, KEEP(vec2_squaredLength(d))) \
+    X(vec2_negate, KIND_VEC, 1, vec2_negate(d)) \
+    X(vec2_inverse, KIND_VEC, 1, vec2_inverse(d)) \
+    X(vec2_normalize, KIND_VEC, 1, vec2_normalize(d)) \
+    X(vec2_dot, KIND_VEC, 1, KEEP(vec2_dot(d, v))) \
+    X(vec2_cross, KIND_VEC, 1, vec2_cross(d, v)) \
+    X(vec2_lerp, KIND_VEC, 1, vec2_lerp(d, v, 0.5f)) \
+    X(vec2_transformMat2, KIND_VEC, 1, vec2_transformMat2(d, m2)) \
+    X(vec2_transformMat2d, KIND_VEC, 1, vec2_transformMat2d(d, m3)) \
+    X(vec2_transformMat3, KIND_VEC, 1, vec2_transformMat3(d, m3)) \
+    X(vec2_transformMat4, KIND_VEC, 1, vec2_transformMat4(d, m4)) \
+    X(vec2_rotate, KIND_VEC, 1, vec2_rotate(d, u, 0.1f)) \
+    X(vec2_angle, KIND_VEC, 1, KEEP(vec2_angle(d, v))) \
+    X(vec2_exactEquals, KIND_VEC, 1, KEEP(vec2_exactEquals(d, v))) \
+    X(vec3_length, KIND_VEC, 1, KEEP(vec3_length(d))) \
+    X(vec3_copy, KIND_VEC, 1, vec3_copy(d, v)) \
+    X(vec3_set, KIND_VEC, 1, vec3_set(d, 1, 2, 3)) \
+    X(vec3_add, KIND_VEC, 1, vec3_add(d, v)) \
+    X(vec3_subtract, KIND_VEC, 1, vec3_subtract(d, v)) \
+    X(vec3_multiply, KIND_VEC, 1, vec3_multiply(d, v)) \
+    X(vec3_divide, KIND_VEC, 1, vec3_divide(d, v)) \
+    X(vec3_ceil, KIND_VEC, 1, vec3_ceil(d)) \
+    X(vec3_floor, KIND_VEC, 1, vec3_floor(d)) \
+    X(vec3_min, KIND_VEC, 1, vec3_min(d, v)) \
+    X(vec3_max, KIND_VEC, 1, vec3_max(d, v)) \
+    X(vec3_round, KIND_VEC, 1, vec3_round(d)) \
+    X(vec3_scale, KIND_VEC, 1, vec3_scale(d, 1.0f)) \
+    X(vec3_scaleAndAdd, KIND_VEC, 1, vec3_scaleAndAdd(d, v, 0.5f)) \
+    X(vec3_distance, KIND_VEC, 1, KEEP(vec3_distance(d, v))) \
+    X(vec3_squaredDistance, KIND_VEC, 1, KEEP(vec3_squaredDistance(d, v))) \
+    X(vec3_squaredLength, KIND_VEC, 1, KEEP(vec3_squaredLength(d))) \
+    X(vec3_negate, KIND_VEC, 1, vec3_negate(d)) \
+    X(vec3_inverse, KIND_VEC, 1, vec3_inverse(d)) \
+    X(vec3_normalize, KIND_VEC, 1, vec3_normalize(d)) \
+    X(vec3_dot, KIND_VEC, 1, KEEP(vec3_dot(d, v))) \
+    X(vec3_cross, KIND_VEC, 1, vec3_cross(d, v)) \
+    X(vec3_lerp, KIND_VEC, 1, vec3_lerp(d, v, 0.5f)) \
+    X(vec3_hermite, KIND_VEC, 1, vec3_hermite(d, v, u, m4, 0.5f)) \
+    X(vec3_bezier, KIND_VEC, 1, vec3_bezier(d, v, u, m4, 0.5f)) \
+    X(vec3_transformMat4, KIND_VEC, 1, vec3_transformMat4(d, m4)) \
+    X(vec3_transformMat4_n, KIND_BATCH, BATCH, vec3_transformMat4_n(batch_work, 0, batch_src, 0, m4, BATCH)) \
+    X(vec4_transformMat4_n, KIND_BATCH, BATCH, vec4_transformMat4_n(batch_work, 0, batch_src, 0, m4, BATCH)) \
+    X(vec3_transformMat4Affine_n, KIND_BATCH, BATCH, vec3_transformMat4Affine_n(batch_work, 0, batch_src, 0, m4, BATCH)) \
+    X(vec3_transformMat3, KIND_VEC, 1, vec3_transformMat3(d, m3)) \
+    X(vec3_transformQuat, KIND_VEC, 1, vec3_transformQuat(d, q)) \
+    X(vec3_rotateX, KIND_VEC, 1, vec3_rotateX(d, u, 0.1f)) \
+    X(vec3_rotateY, KIND_VEC, 1, vec3_rotateY(d, u, 0.1f)) \
+    X(vec3_rotateZ, KIND_VEC, 1, vec3_rotateZ(d, u, 0.1f)) \
+    X(vec3_angle, KIND_VEC, 1, KEEP(vec3_angle(d, v))) \
+    X(vec3_equals, KIND_VEC, 1, KEEP(vec3_equals(d, v))) \
+    X(vec4_copy, KIND_VEC, 1, vec4_copy(d, v)) \
+    X(vec4_set, KIND_VEC, 1, vec4_set(d, 1, 2, 3, 4)) \
+    X(vec4_add, KIND_VEC, 1, vec4_add(d, v)) \
+    X(vec4_subtract, KIND_VEC, 1, vec4_subtract(d, v)) \
+    X(vec4_multiply, KIND_VEC, 1, vec4_multiply(d, v)) \
+    X(vec4_divide, KIND_VEC, 1, vec4_divide(d, v)) \
+    X(vec4_ceil, KIND_VEC, 1, vec4_ceil(d)) \
+    X(vec4_floor, KIND_VEC, 1, vec4_floor(d)) \
+    X(vec4_min, KIND_VEC, 1, vec4_min(d, v)) \
+    X(vec4_max, KIND_VEC, 1, vec4_max(d, v)) \
+    X(vec4_round, KIND_VEC, 1, vec4_round(d)) \
+    X(vec4_scale, KIND_VEC, 1, vec4_scale(d, 1.0f)) \
+    X(vec4_scaleAndAdd, KIND_VEC, 1, vec4_scaleAndAdd(d, v, 0.5f)) \
+    X(vec4_distance, KIND_VEC, 1, KEEP(vec4_distance(d, v))) \
+    X(vec4_squaredDistance, KIND_VEC, 1, KEEP(vec4_squaredDistance(d, v))) \
+    X(vec4_length, KIND_VEC, 1, KEEP(vec4_length(d))) \
+    X(vec4_squaredLength, KIND_VEC, 1, KEEP(vec4_squaredLength(d))) \
+    X(vec4_negate, KIND_VEC, 1, vec4_negate(d)) \
+    X(vec4_inverse, KIND_VEC, 1, vec4_inverse(d)) \
+    X(vec4_normalize, KIND_VEC, 1, vec4_normalize(d)) \
+    X(vec4_dot, KIND_VEC, 1, KEEP(vec4_dot(d, v))) \
+    X(vec4_lerp, KIND_VEC, 1, vec4_lerp(d, v, 0.5f)) \
+    X(vec4_transformMat4, KIND_VEC, 1, vec4_transformMat4(d, m4)) \
+    X(vec4_transformMat4_aligned, KIND_VEC, 1, vec4_transformMat4_aligned(d, m4)) \
+    X(vec4_transformQuat, KIND_VEC, 1, vec4_transformQuat(d, q)) \
+    X(vec4_equals, KIND_VEC, 1, KEEP(vec4_equals(d, v))) \
+    X(quat_identity, KIND_QUAT, 1, quat_identity(d)) \
+    X(quat_setAxisAngle, KIND_QUAT, 1, quat_setAxisAngle(d, v, 0.1f)) \
+    X(quat_getAxisAngle, KIND_VEC, 1, KEEP(quat_getAxisAngle(d, q))) \
+    X(quat_multiply, KIND_QUAT, 1, quat_multiply(d, q)) \
+    X(quat_multiply_aligned, KIND_QUAT, 1, quat_multiply_aligned(d, q)) \
+    X(quat_rotateX, KIND_QUAT, 1, quat_rotateX(d, 0.1f)) \
+    X(quat_rotateY, KIND_QUAT, 1, quat_rotateY(d, 0.1f)) \
+    X(quat_rotateZ, KIND_QUAT, 1, quat_rotateZ(d, 0.1f)) \
+    X(quat_calculateW, KIND_QUAT, 1, quat_calculateW(d)) \
+    X(quat_slerp, KIND_QUAT, 1, quat_slerp(d, q, 0.5f)) \
+    X(quat_slerp_n_polynomial, KIND_BATCH, BATCH, quat_slerp_n(batch_quats, batch_quats_b, batch_t, BATCH, QUAT_SLERP_POLYNOMIAL)) \
+    X(quat_slerp_n_nlerp, KIND_BATCH, BATCH, quat_slerp_n(batch_quats, batch_quats_b, batch_t, BATCH, QUAT_SLERP_NLERP)) \
+    X(quat_invert, KIND_QUAT, 1, quat_invert(d)) \
+    X(quat_conjugate, KIND_QUAT, 1, quat_conjugate(d)) \
+    X(quat_fromMat3, KIND_QUAT, 1, quat_fromMat3(d, m3)) \
+    X(quat_fromEuler, KIND_QUAT, 1, quat_fromEuler(d, 10, 20, 30)) \
+    X(quat_pack48, KIND_VEC, 1, quat_pack48((uint16_t*)d, q)) \
+    X(quat_unpack48, KIND_QUAT, 1, quat_unpack48(d, p48)) \
+    X(quat_unpack48_n, KIND_BATCH, BATCH, quat_unpack48_n(batch_quats, batch_packed48, BATCH)) \
+    X(quat_pack32, KIND_VEC, 1, quat_pack32((uint32_t*)d, q)) \
+    X(quat_unpack32, KIND_QUAT, 1, quat_unpack32(d, p32)) \
+    X(quat_unpack32_n, KIND_BATCH, BATCH, quat_unpack32_n(batch_quats, batch_packed32, BATCH)) \
+    X(quat2_identity, KIND_QUAT, 1, quat2_identity(d)) \
+    X(quat2_copy, KIND_QUAT, 1, quat2_copy(d, dq)) \
+    X(quat2_fromRotationTranslation, KIND_QUAT, 1, quat2_fromRotationTranslation(d, q, v)) \
+    X(quat2_fromTranslation, KIND_QUAT, 1, quat2_fromTranslation(d, v)) \
+    X(quat2_getTranslation, KIND_VEC, 1, quat2_getTranslation(d, dq)) \
+    X(quat2_multiply, KIND_QUAT, 1, quat2_multiply(d, dq)) \
+    X(quat2_conjugate, KIND_QUAT, 1, quat2_conjugate(d)) \
+    X(quat2_invert, KIND_QUAT, 1, quat2_invert(d)) \
+    X(quat2_normalize, KIND_QUAT, 1, quat2_normalize(d)) \
+    X(quat2_dot, KIND_QUAT, 1, KEEP(quat2_dot(d, dq))) \
+    X(quat2_lerp, KIND_QUAT, 1, quat2_lerp(d, dq, 0.5f)) \
+    X(quat2_sclerp, KIND_QUAT, 1, quat2_copy(d, dq); quat2_sclerp(d, dq2, 0.5f)) \
+    X(quat2_transformPoint, KIND_VEC, 1, quat2_transformPoint(d, dq)) \
+    X(quat2_equals, KIND_QUAT, 1, KEEP(quat2_equals(d, dq))) \
+    X(mat4_fromQuat2, KIND_MAT4, 1, mat4_fromQuat2(d, dq)) \
+    X(dmat2_invert, KIND_MAT2, 1, dmat2_invert(dd)) \
+    X(dmat2_multiply, KIND_MAT2, 1, dmat2_multiply(dd, m2d)) \
+    X(dmat3_fromMat4, KIND_MAT3, 1, dmat3_fromMat4(dd, m4d)) \
+    X(dmat3_invert, KIND_MAT3, 1, dmat3_invert(dd)) \
+    X(dmat3_multiply, KIND_MAT3, 1, dmat3_multiply(dd, m3d)) \
+    X(dmat3_fromQuat, KIND_MAT3, 1, dmat3_fromQuat(dd, qd)) \
+    X(dmat3_normalFromMat4, KIND_MAT3, 1, dmat3_normalFromMat4(dd, m4d)) \
+    X(dmat4_invert, KIND_MAT4, 1, dmat4_invert(dd)) \
+    X(dmat4_invertAffine, KIND_MAT4, 1, dmat4_invertAffine(dd)) \
+    X(dmat4_invert_n, KIND_BATCH, BATCH, dmat4_invert_n(batchd_work, NULL, BATCH)) \
+    X(dmat4_determinant, KIND_MAT4, 1, KEEP(dmat4_determinant(dd))) \
+    X(dmat4_multiply, KIND_MAT4, 1, dmat4_multiply(dd, m4d)) \
+    X(dmat4_multiply_n, KIND_BATCH, BATCH, dmat4_multiply_n(batchd_work, m4d, BATCH)) \
+    X(dmat4_multiplyPairwise_n, KIND_BATCH, BATCH, dmat4_multiplyPairwise_n(batchd_work, batchd_src, BATCH)) \
+    X(dmat4_translate, KIND_MAT4, 1, dmat4_translate(dd, vd)) \
+    X(dmat4_rotate, KIND_MAT4, 1, dmat4_rotate(dd, 0.1, vd)) \
+    X(dmat4_fromRotationTranslation, KIND_MAT4, 1, dmat4_fromRotationTranslation(dd, qd, vd)) \
+    X(dmat4_fromRotationTranslationScale, KIND_MAT4, 1, dmat4_fromRotationTranslationScale(dd, qd, vd, ud)) \
+    X(dmat4_fromQuat, KIND_MAT4, 1, dmat4_fromQuat(dd, qd)) \
+    X(dmat4_perspective, KIND_MAT4, 1, dmat4_perspective(dd, 1.0, 1.5, 0.1, 100)) \
+    X(dmat4_lookAt, KIND_MAT4, 1, dmat4_lookAt(dd, vd, ud, origin_d)) \
+    X(dvec2_normalize, KIND_VEC, 1, dvec2_normalize(dd)) \
+    X(dvec2_transformMat3, KIND_VEC, 1, dvec2_transformMat3(dd, m3d)) \
+    X(dvec3_normalize, KIND_VEC, 1, dvec3_normalize(dd)) \
+    X(dvec3_cross, KIND_VEC, 1, dvec3_cross(dd, vd)) \
+    X(dvec3_transformMat4, KIND_VEC, 1, dvec3_transformMat4(dd, m4d)) \
+    X(dvec3_transformMat4_n, KIND_BATCH, BATCH, dvec3_transformMat4_n(batchd_work, 0, batchd_src, 0, m4d, BATCH)) \
+    X(dvec3_transformMat4Affine_n, KIND_BATCH, BATCH, dvec3_transformMat4Affine_n(batchd_work, 0, batchd_src, 0, m4d, BATCH)) \
+    X(dvec3_transformQuat, KIND_VEC, 1, dvec3_transformQuat(dd, qd)) \
+    X(dvec4_transformMat4, KIND_VEC, 1, dvec4_transformMat4(dd, m4d)) \
+    X(dvec4_transformMat4_n, KIND_BATCH, BATCH, dvec4_transformMat4_n(batchd_work, 0, batchd_src, 0, m4d, BATCH)) \
+    X(dquat_multiply, KIND_QUAT, 1, dquat_multiply(dd, qd)) \
+    X(dquat_setAxisAngle, KIND_QUAT, 1, dquat_setAxisAngle(dd, vd, 0.1)) \
+    X(dquat_slerp, KIND_QUAT, 1, dquat_slerp(dd, qd, 0.5)) \
+    X(dquat_fromMat3, KIND_QUAT, 1, dquat_fromMat3(dd, m3d)) \
+    X(dquat2_fromRotationTranslation, KIND_QUAT, 1, dquat2_fromRotationTranslation(dd, qd, vd)) \
+    X(dquat2_multiply, KIND_QUAT, 1, dquat2_multiply(dd, dqd)) \
+    X(dquat2_transformPoint, KIND_VEC, 1, dquat2_transformPoint(dd, dqd)) \
+    X(relative_vec3, KIND_VEC, 1, relative_vec3(d, vd, origin_d)) \
+    X(relative_vec3_n, KIND_BATCH, BATCH, relative_vec3_n(batch_work, batchd_src, origin_d, BATCH)) \
+    X(relative_model, KIND_MAT4, 1, relative_model(d, m4d, origin_d)) \
+    X(relative_view, KIND_MAT4, 1, relative_view(d, m4d, origin_d)) \
+    X(pack_toHalf_n, KIND_BATCH, BATCH, pack_toHalf_n(batch_half, batch_src, BATCH * 3)) \
+    X(pack_fromHalf_n, KIND_BATCH, BATCH, pack_fromHalf_n(batch_work, batch_half, BATCH * 3)) \
+    X(pack_toSnorm16_n, KIND_BATCH, BATCH, pack_toSnorm16_n(batch_snorm, batch_src, BATCH * 3)) \
+    X(pack_fromSnorm16_n, KIND_BATCH, BATCH, pack_fromSnorm16_n(batch_work, batch_snorm, BATCH * 3)) \
+    X(pack_toUnorm8_n, KIND_BATCH, BATCH, pack_toUnorm8_n(batch_unorm, batch_src, BATCH * 3)) \
+    X(pack_fromUnorm8_n, KIND_BATCH, BATCH, pack_fromUnorm8_n(batch_work, batch_unorm, BATCH * 3)) \
+    X(pack_toOctahedral_n, KIND_BATCH, BATCH, pack_toOctahedral_n(batch_oct, batch_normals, BATCH)) \
+    X(pack_fromOctahedral_n, KIND_BATCH, BATCH, pack_fromOctahedral_n(batch_work, batch_oct, BATCH)) \
+    X(vec3soa_fromInterleaved, KIND_BATCH, BATCH, vec3soa_fromInterleaved(&soa3_a, batch_src, 0, BATCH)) \
+    X(vec3soa_toInterleaved, KIND_BATCH, BATCH, vec3soa_toInterleaved(batch_work, 0, &soa3_a, BATCH)) \
+    X(vec3soa_add, KIND_BATCH, BATCH, vec3soa_add(&soa3_a, &soa3_b, BATCH)) \
+    X(vec3soa_scale, KIND_BATCH, BATCH, vec3soa_scale(&soa3_a, 1.0f, BATCH)) \
+    X(vec3soa_scaleAndAdd, KIND_BATCH, BATCH, vec3soa_scaleAndAdd(&soa3_a, &soa3_b, 0.5f, BATCH)) \
+    X(vec3soa_dot, KIND_BATCH, BATCH, vec3soa_dot(batch_out, &soa3_a, &soa3_b, BATCH)) \
+    X(vec3soa_cross, KIND_BATCH, BATCH, vec3soa_cross(&soa3_a, &soa3_b, BATCH)) \
+    X(vec3soa_normalize, KIND_BATCH, BATCH, vec3soa_normalize(&soa3_a, BATCH)) \
+    X(vec3soa_length, KIND_BATCH, BATCH, vec3soa_length(batch_out, &soa3_a, BATCH)) \
+    X(vec3soa_lerp, KIND_BATCH, BATCH, vec3soa_lerp(&soa3_a, &soa3_b, 0.5f, BATCH)) \
+    X(vec3soa_transformMat4, KIND_BATCH, BATCH, vec3soa_transformMat4(&soa3_a, m4, BATCH)) \
+    X(vec4soa_fromInterleaved, KIND_BATCH, BATCH, vec4soa_fromInterleaved(&soa4_a, batch_src, 0, BATCH)) \
+    X(vec4soa_toInterleaved, KIND_BATCH, BATCH, vec4soa_toInterleaved(batch_work, 0, &soa4_a, BATCH)) \
+    X(vec4soa_add, KIND_BATCH, BATCH, vec4soa_add(&soa4_a, &soa4_b, BATCH)) \
+    X(vec4soa_scale, KIND_BATCH, BATCH, vec4soa_scale(&soa4_a, 1.0f, BATCH)) \
+    X(vec4soa_scaleAndAdd, KIND_BATCH, BATCH, vec4soa_scaleAndAdd(&soa4_a, &soa4_b, 0.5f, BATCH)) \
+    X(vec4soa_dot, KIND_BATCH, BATCH, vec4soa_dot(batch_out, &soa4_a, &soa4_b, BATCH)) \
+    X(vec4soa_normalize, KIND_BATCH, BATCH, vec4soa_normalize(&soa4_a, BATCH)) \
+    X(vec4soa_length, KIND_BATCH, BATCH, vec4soa_length(batch_out, &soa4_a, BATCH)) \
+    X(vec4soa_lerp, KIND_BATCH, BATCH, vec4soa_lerp(&soa4_a, &soa4_b, 0.5f, BATCH)) \
+    X(vec4soa_transformMat4, KIND_BATCH, BATCH, vec4soa_transformMat4(&soa4_a, m4, BATCH)) \
+    X(frustum_fromMat4, KIND_VEC, 1, frustum_fromMat4(planes, m4)) \
+    X(frustum_testSphere, KIND_VEC, 1, KEEP(frustum_testSphere(planes, v, 0.5f))) \
+    X(frustum_testAABB, KIND_VEC, 1, KEEP(frustum_testAABB(planes, v, u))) \
+    X(frustum_cullSpheres, KIND_BATCH, BATCH, KEEP(frustum_cullSpheres(batch_bits, planes, &soa4_a, BATCH))) \
+    X(frustum_cullAABBs, KIND_BATCH, BATCH, KEEP(frustum_cullAABBs(batch_bits, planes, &soa3_a, &soa3_b, BATCH))) \
+    X(skin_linearBlend, KIND_BATCH, BATCH, skin_linearBlend(&mesh, 0, BATCH)) \
+    X(skin_linearBlend_pool, KIND_BATCH, BATCH, skin_linearBlend_pool(&mesh, &workers)) \
+    X(skin_dualQuat, KIND_BATCH, BATCH, skin_dualQuat(&mesh_dq, 0, BATCH)) \
+    X(skin_dualQuat_pool, KIND_BATCH, BATCH, skin_dualQuat_pool(&mesh_dq, &workers)) \
+    X(hierarchy_update, KIND_BATCH, BATCH, hierarchy_markAllDirty(&tree); hierarchy_update(&tree)) \
+    X(hierarchy_updateLeaf, KIND_BATCH, 1, hierarchy_markDirty(&tree, BATCH - 1); hierarchy_update(&tree)) \
+    X(vec3_transformMat4_n_cloud, KIND_BATCH, CLOUD, vec3_transformMat4_n(cloud_dst, 0, cloud_src, 0, m4, CLOUD)) \
+    X(pool_run_vec3_transformMat4, KIND_BATCH, CLOUD, cloud_op.b = m4; pool_run(&workers, cloud_dst, CLOUD, &cloud_op)) \
+    X(cpu_features, KIND_VEC, 1, KEEP(cpu_features())) \
+    X(cpu_level, KIND_VEC, 1, KEEP(cpu_level()))
+
+#define DEFINE_CASE(name, kind, items, ...) \
+    static void bench_##name(size_t iters) { \
+        size_t i; \
+        for (i = 0; i < iters; i++) { \
+            size_t k = i & (POOL - 1); \
+            float* d = work + k * 16; \
+            float* m2 = mat2s + k * 4; \
+            float* m3 = mat3s + k * 9; \
+            float* p3 = mat3ps + k * 12; \
+            float* m4 = mat4s + k * 16; \
+            float* v = vecs + k * 4; \
+            float* u = vecs + ((k + 1) & (POOL - 1)) * 4; \
+            float* q = quats + k * 4; \
+            float* dq = quat2s + k * 8; \
+            float* dq2 = quat2s + ((k + 1) & (POOL - 1)) * 8; \
+            uint16_t* p48 = batch_packed48 + k * 3; \
+            uint32_t* p32 = batch_packed32 + k; \
+            double* dd = workd + k * 16; \
+            double* m2d = mat2ds + k * 4; \
+            double* m3d = mat3ds + k * 9; \
+            double* m4d = mat4ds + k * 16; \
+            double* vd = vecds + k * 4; \
+            double* ud = vecds + ((k + 1) & (POOL - 1)) * 4; \
+            double* qd = quatds + k * 4; \
+            double* dqd = quat2ds + k * 8; \
+            (void)m2; (void)m3; (void)p3; (void)m4; (void)v; (void)u; (void)q; (void)dq; (void)dq2; (void)p48; (void)p32; \
+            (void)dd; (void)m2d; (void)m3d; (void)m4d; (void)vd; (void)ud; (void)qd; (void)dqd; \
+            __VA_ARGS__; \
+            KEEP(d); \
+        } \
+    }
+
+CASES(DEFINE_CASE)
+
+struct bench_case {
+    const char* name;
+    int kind;
+    size_t items;
+    void (*run)(size_t iters);
+    // Median ns per call in the --baseline run, 0 if it has none
+    double baseline_ns;
+};
+
+#define TABLE_ENTRY(name, kind, items, ...) { #name, kind, items, bench_##name },
+
+static struct bench_case cases[] = {
+    CASES(TABLE_ENTRY)
+};
+
+struct bench_result {
+    size_t iters;
+    double ns_median;
+    double ns_p99;
+    double ns_min;
+    double cycles_median;
+};
+
+static float frand(void) {
+    return (float)rand() / RAND_MAX * 2 - 1;
+}
+
+static void random_unit(float* dst, int n) {
+    float len = 0;
+    int i;
+    for (i = 0; i < n; i++) {
+        dst[i] = frand();
+        len += dst[i] * dst[i];
+    }
+    len = 1 / sqrtf(len);
+    for (i = 0; i < n; i++) {
+        dst[i] *= len;
+    }
+}
+
+static void to_double(double* dst, float* src, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        dst[i] = src[i];
+    }
+}
+
+static void setup(void) {
+    float projection[16];
+    int i, j;
+    srand(1);
+    for (i = 0; i < POOL; i++) {
+        float q[4], t[3], axis[3];
+        random_unit(q, 4);
+        random_unit(axis, 3);
+        t[0] = frand(); t[1] = frand(); t[2] = frand();
+
+        mat2_fromRotation(mat2s + i * 4, frand());
+        mat3_fromQuat(mat3s + i * 9, q);
+        mat4_fromRotationTranslation(mat4s + i * 16, q, t);
+        quat2_fromRotationTranslation(quat2s + i * 8, q, t);
+        random_unit(vecs + i * 4, 4);
+        random_unit(quats + i * 4, 4);
+
+        memcpy(pristine[KIND_MAT2] + i * 16, mat2s + i * 4, 4 * sizeof(float));
+        memcpy(pristine[KIND_MAT3] + i * 16, mat3s + i * 9, 9 * sizeof(float));
+        mat3_toPadded(mat3ps + i * 12, mat3s + i * 9);
+        memcpy(pristine[KIND_MAT3P] + i * 16, mat3ps + i * 12, 12 * sizeof(float));
+        memcpy(pristine[KIND_MAT4] + i * 16, mat4s + i * 16, 16 * sizeof(float));
+        random_unit(pristine[KIND_VEC] + i * 16, 4);
+        random_unit(pristine[KIND_QUAT] + i * 16, 4);
+    }
+    for (i = 0; i < BATCH; i++) {
+        memcpy(batch_pristine + i * 16, mat4s + (i % POOL) * 16, 16 * sizeof(float));
+        memcpy(batch_src + i * 16, mat4s + ((i + 1) % POOL) * 16, 16 * sizeof(float));
+        random_unit(batch_quats_pristine + i * 4, 4);
+        random_unit(batch_quats_b + i * 4, 4);
+        quat_pack48(batch_packed48 + i * 3, batch_quats_pristine + i * 4);
+        quat_pack32(batch_packed32 + i, batch_quats_pristine + i * 4);
+        random_unit(batch_normals + i * 3, 3);
+        batch_t[i] = (float)rand() / RAND_MAX;
+
+        for (j = 0; j < 4; j++) {
+            skin_joints[i * 4 + j] = rand() % POOL;
+            skin_weights[i * 4 + j] = 0.25f;
+        }
+
+        tree_parent[i] = i ? (i - 1) / 4 : -1;
+        memcpy(tree.translation + i * 3, vecs + (i % POOL) * 4, 3 * sizeof(float));
+        memcpy(tree.rotation + i * 4, quats + (i % POOL) * 4, 4 * sizeof(float));
+        vec3_set(tree.scale + i * 3, 1, 1, 1);
+    }
+    pack_toHalf_n(batch_half, batch_src, BATCH * 3);
+    pack_toSnorm16_n(batch_snorm, batch_src, BATCH * 3);
+    pack_toUnorm8_n(batch_unorm, batch_src, BATCH * 3);
+    pack_toOctahedral_n(batch_oct, batch_normals, BATCH);
+    to_double(mat2ds, mat2s, POOL * 4);
+    to_double(mat3ds, mat3s, POOL * 9);
+    to_double(mat4ds, mat4s, POOL * 16);
+    to_double(vecds, vecs, POOL * 4);
+    to_double(quatds, quats, POOL * 4);
+    to_double(quat2ds, quat2s, POOL * 8);
+    to_double(pristined[0], pristine[0], KIND_COUNT * POOL * 16);
+    to_double(batchd_pristine, batch_pristine, BATCH * 16);
+    to_double(batchd_src, batch_src, BATCH * 16);
+    mat4x3_fromMat4_n(batch43_pristine, batch_pristine, BATCH);
+    mat4x3_fromMat4_n(batch43_src, batch_src, BATCH);
+    mat4_perspective(projection, 1.0f, 1.5f, 0.1f, 100);
+    frustum_fromMat4(planes, projection);
+
+    for (i = 0; i < CLOUD * 3; i++) {
+        cloud_src[i] = frand();
+    }
+    if (!pool_init(&workers, 0)) {
+        fprintf(stderr, "could not start the thread pool\n");
+        exit(1);
+    }
+}
+
+static void reset(int kind) {
+    if (kind == KIND_BATCH) {
+        memcpy(batch_work, batch_pristine, sizeof(batch_work));
+        memcpy(batch43_work, batch43_pristine, sizeof(batch43_work));
+        memcpy(batch_quats, batch_quats_pristine, sizeof(batch_quats));
+        memcpy(batchd_work, batchd_pristine, sizeof(batchd_work));
+        vec4soa_fromInterleaved(&soa4_a, batch_pristine, 0, BATCH);
+        vec4soa_fromInterleaved(&soa4_b, batch_src, 0, BATCH);
+    }
+    else {
+        memcpy(work, pristine[kind], sizeof(work));
+        memcpy(workd, pristined[kind], sizeof(workd));
+    }
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint64_t cycles(void) {
+#if BENCH_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double run_once(struct bench_case* c, size_t iters, double* cyc) {
+    double t0, t1;
+    uint64_t c0, c1;
+
+    reset(c->kind);
+    t0 = now_ns();
+    c0 = cycles();
+    c->run(iters);
+    c1 = cycles();
+    t1 = now_ns();
+    *cyc = (double)(c1 - c0) / iters;
+    return (t1 - t0) / iters;
+}
+
+static void measure(struct bench_case* c, int runs, double min_time_ns, struct bench_result* r) {
+    double* ns = malloc(runs * sizeof(double));
+    double* cyc = malloc(runs * sizeof(double));
+    double unused, warm_end;
+    size_t iters = 1;
+    int i;
+
+    // Grow the run length until a single run takes at least min_time_ns
+    while (run_once(c, iters, &unused) * iters < min_time_ns && iters < ((size_t)1 << 30)) {
+        iters *= 2;
+    }
+
+    // Warm up caches, branch predictors and clocks for a few run lengths
+    warm_end = now_ns() + 5 * min_time_ns;
+    while (now_ns() < warm_end) {
+        run_once(c, iters, &unused);
+    }
+
+    for (i = 0; i < runs; i++) {
+        ns[i] = run_once(c, iters, &cyc[i]);
+    }
+    qsort(ns, runs, sizeof(double), compare_double);
+    qsort(cyc, runs, sizeof(double), compare_double);
+
+    r->iters = iters;
+    r->ns_median = ns[runs / 2];
+    r->ns_p99 = ns[(int)ceil(runs * 0.99) - 1];
+    r->ns_min = ns[0];
+    r->cycles_median = cyc[runs / 2];
+
+    free(ns);
+    free(cyc);
+}
+
+static const char* features_string(void) {
+    static char buf[64];
+    uint32_t f = cpu_features();
+    buf[0] = 0;
+    if (f & CPU_SSE41) strcat(buf, "sse4.1 ");
+    if (f & CPU_AVX2) strcat(buf, "avx2 ");
+    if (f & CPU_FMA) strcat(buf, "fma ");
+    if (f & CPU_F16C) strcat(buf, "f16c ");
+    if (cpu_level() > 1) sprintf(buf + strlen(buf), "x86-64-v%u ", (unsigned)cpu_level());
+    if (buf[0]) buf[strlen(buf) - 1] = 0;
+    return buf;
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [--format text|csv|json] [--runs N] [--min-time US] [--filter STR] [--baseline CSV]\n",
+        argv0);
+    exit(2);
+}
+
+// Reads the ns_median column of an earlier run with --format csv
+static void load_baseline(const char* path) {
+    size_t i, count = sizeof(cases) / sizeof(cases[0]);
+    char line[512], name[256];
+    double ns;
+    FILE* f = fopen(path, "r");
+
+    if (!f) {
+        fprintf(stderr, "cannot open %s\n", path);
+        exit(2);
+    }
+    while (fgets(line, sizeof(line), f)) {
+        // name,items,iters,runs,ns_median,... and the header, which does not parse
+        if (sscanf(line, "%255[^,],%*[^,],%*[^,],%*[^,],%lf", name, &ns) != 2) {
+            continue;
+        }
+        for (i = 0; i < count; i++) {
+            if (!strcmp(cases[i].name, name)) {
+                cases[i].baseline_ns = ns;
+            }
+        }
+    }
+    fclose(f);
+}
+
+int main(int argc, char** argv) {
+    const char* format = "text";
+    const char* filter = NULL;
+    const char* baseline = NULL;
+    int runs = 25;
+    double min_time_ns = 200e3;
+    size_t i, count = sizeof(cases) / sizeof(cases[0]);
+    int first = 1;
+    double log_speedup = 0;
+    size_t compared = 0;
+    int a;
+
+    for (a = 1; a < argc; a++) {
+        if (!strcmp(argv[a], "--format") && a + 1 < argc) {
+            format = argv[++a];
+        }
+        else if (!strcmp(argv[a], "--runs") && a + 1 < argc) {
+            runs = atoi(argv[++a]);
+        }
+        else if (!strcmp(argv[a], "--min-time") && a + 1 < argc) {
+            min_time_ns = atof(argv[++a]) * 1e3;
+        }
+        else if (!strcmp(argv[a], "--filter") && a + 1 < argc) {
+            filter = argv[++a];
+        }
+        else if (!strcmp(argv[a], "--baseline") && a + 1 < argc) {
+            baseline = argv[++a];
+        }
+        else {
+            usage(argv[0]);
+        }
+    }
+    if (runs < 1 || (strcmp(format, "text") && strcmp(format, "csv") && strcmp(format, "json"))) {
+        usage(argv[0]);
+    }
+
+    if (baseline) {
+        load_baseline(baseline);
+    }
+    setup();
+
+    if (!strcmp(format, "csv")) {
+        printf("name,items,iters,runs,ns_median,ns_p99,ns_min,ops_per_sec,cycles_median,ns_per_item%s\n",
+            baseline ? ",speedup" : "");
+    }
+    else if (!strcmp(format, "json")) {
+        printf("{\n  \"features\": \"%s\",\n  \"runs\": %d,\n  \"threads\": %zu,\n  \"results\": [",
+            features_string(), runs, workers.count);
+    }
+    else {
+        printf("# cpu features: %s, %d runs per case, %zu pool threads\n",
+            features_string()[0] ? features_string() : "none", runs, workers.count);
+        printf("%-42s %10s %10s %14s %10s %10s%s\n", "function", "ns/op", "p99", "ops/sec", "cycles", "ns/item",
+            baseline ? "    speedup" : "");
+    }
+
+    for (i = 0; i < count; i++) {
+        struct bench_case* c = &cases[i];
+        struct bench_result r;
+        double ops, per_item, speedup = 0;
+
+        if (filter && !strstr(c->name, filter)) {
+            continue;
+        }
+        measure(c, runs, min_time_ns, &r);
+        ops = r.ns_median > 0 ? 1e9 / r.ns_median : 0;
+        per_item = r.ns_median / c->items;
+        if (c->baseline_ns > 0 && r.ns_median > 0) {
+            speedup = c->baseline_ns / r.ns_median;
+            log_speedup += log(speedup);
+            compared++;
+        }
+
+        if (!strcmp(format, "csv")) {
+            printf("%s,%zu,%zu,%d,%.3f,%.3f,%.3f,%.0f,%.1f,%.3f",
+                c->name, c->items, r.iters, runs, r.ns_median, r.ns_p99, r.ns_min, ops, r.cycles_median, per_item);
+            if (baseline) {
+                printf(",%.3f", speedup);
+            }
+            printf("\n");
+        }
+        else if (!strcmp(format, "json")) {
+            printf("%s\n    {\"name\": \"%s\", \"items\": %zu, \"iters\": %zu, \"ns_median\": %.3f, \"ns_p99\": %.3f, "
+                "\"ns_min\": %.3f, \"ops_per_sec\": %.0f, \"cycles_median\": %.1f, \"ns_per_item\": %.3f",
+                first ? "" : ",", c->name, c->items, r.iters, r.ns_median, r.ns_p99, r.ns_min, ops, r.cycles_median, per_item);
+            if (baseline) {
+                printf(", \"speedup\": %.3f", speedup);
+            }
+            printf("}");
+        }
+        else {
+            printf("%-42s %10.2f %10.2f %14.0f %10.1f %10.3f",
+                c->name, r.ns_median, r.ns_p99, ops, r.cycles_median, per_item);
+            if (speedup > 0) {
+                printf(" %10.3fx", speedup);
+            }
+            else if (baseline) {
+                printf(" %11s", "-");
+            }
+            printf("\n");
+        }
+        first = 0;
+        fflush(stdout);
+    }
+
+    // The geometric mean, so a few cases with large speedups do not dominate
+    if (!strcmp(format, "json")) {
+        printf("\n  ]");
+        if (baseline) {
+            printf(",\n  \"speedup\": %.3f", compared ? exp(log_speedup / compared) : 0);
+        }
+        printf("\n}\n");
+    }
+    else if (!strcmp(format, "text") && baseline) {
+        printf("# speedup over %s: %.3fx geometric mean of %zu cases\n",
+            baseline, compared ? exp(log_speedup / compared) : 0, compared);
+    }
+    pool_destroy(&workers);
+    return 0;
+}
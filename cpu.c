@@ -0,0 +1,64 @@
+#include "cpu.h"
+#include "simd.h"
+
+#if GL_MATRIX_SIMD
+#include <cpuid.h>
+#endif
+
+/**
+ * Returns the instruction set extensions of the running CPU that the
+ * vectorized kernels can use. The result is queried once with cpuid
+ * and cached.
+ *
+ * @returns {uint32_t} bitmask of CPU_* flags, 0 on non-x86 targets
+ */
+GL_MATRIX_API uint32_t cpu_features(void) {
+#if GL_MATRIX_SIMD
+    static uint32_t features = 0;
+    static uint8_t detected = 0;
+
+    if (!detected) {
+        // Safe to call from constructors that run before libgcc's own
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.1"))
+            features |= CPU_SSE41;
+        if (__builtin_cpu_supports("avx2"))
+            features |= CPU_AVX2;
+        if (__builtin_cpu_supports("fma"))
+            features |= CPU_FMA;
+        // __builtin_cpu_supports does not know f16c on older compilers
+        unsigned int eax, ebx, ecx, edx;
+        if (__builtin_cpu_supports("avx") && __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_F16C))
+            features |= CPU_F16C;
+        detected = 1;
+    }
+    return features;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Returns the x86-64 microarchitecture level of the function variants
+ * that run. Some hot scalar functions are compiled for x86-64-v2, v3 and
+ * v4 as well as the baseline, and the best one for the running CPU is
+ * picked at load time.
+ *
+ * @returns {uint32_t} 2, 3 or 4 for x86-64-v2 to v4, 1 for the baseline,
+ * 0 when the library was built without the variants
+ */
+GL_MATRIX_API uint32_t cpu_level(void) {
+#if GL_MATRIX_CLONES
+    // Same order as the resolvers of the target_clones functions
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("x86-64-v4"))
+        return 4;
+    if (__builtin_cpu_supports("x86-64-v3"))
+        return 3;
+    if (__builtin_cpu_supports("x86-64-v2"))
+        return 2;
+    return 1;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,32 @@
+#ifndef CPU_H
+#define CPU_H
+
+#include <stdint.h>
+#include "api.h"
+
+#define CPU_SSE41 0x01
+#define CPU_AVX2 0x02
+#define CPU_FMA 0x04
+#define CPU_F16C 0x08
+
+/**
+ * Returns the instruction set extensions of the running CPU that the
+ * vectorized kernels can use. The result is queried once with cpuid
+ * and cached.
+ *
+ * @returns {uint32_t} bitmask of CPU_* flags, 0 on non-x86 targets
+ */
+GL_MATRIX_API uint32_t cpu_features(void);
+
+/**
+ * Returns the x86-64 microarchitecture level of the function variants
+ * that run. Some hot scalar functions are compiled for x86-64-v2, v3 and
+ * v4 as well as the baseline, and the best one for the running CPU is
+ * picked at load time.
+ *
+ * @returns {uint32_t} 2, 3 or 4 for x86-64-v2 to v4, 1 for the baseline,
+ * 0 when the library was built without the variants
+ */
+GL_MATRIX_API uint32_t cpu_level(void);
+
+#endif
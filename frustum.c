@@ -0,0 +1,209 @@
+#include "frustum.h"
+#include "cpu.h"
+#include "simd.h"
+#include <math.h>
+
+// The AVX2 kernels handle whole blocks of 8 and return how many volumes
+// they processed; the scalar loops in the public functions finish the tail.
+static uint8_t frustum_use_avx2 = 0;
+
+__attribute__((constructor))
+static void frustum_dispatch(void) {
+    frustum_use_avx2 = (cpu_features() & CPU_AVX2) != 0;
+}
+
+#if GL_MATRIX_SIMD
+// Same evaluation order as frustum_testSphere and without FMA, so both paths
+// cull exactly the same spheres
+SIMD_AVX2_NOFMA static size_t frustum_cullSpheres_avx2(uint8_t* dst, float* a, vec4soa* spheres, size_t n, size_t* visible) {
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    size_t i;
+    uint8_t j;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(spheres->x + i);
+        __m256 y = _mm256_loadu_ps(spheres->y + i);
+        __m256 z = _mm256_loadu_ps(spheres->z + i);
+        __m256 r = _mm256_xor_ps(_mm256_loadu_ps(spheres->w + i), sign);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (j = 0; j < 24; j += 4) {
+            __m256 d = _mm256_mul_ps(_mm256_set1_ps(a[j]), x);
+            d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(a[j + 1]), y));
+            d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(a[j + 2]), z));
+            d = _mm256_add_ps(d, _mm256_set1_ps(a[j + 3]));
+            // !(d < -radius) like the scalar test, so NaN volumes stay visible
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, r, _CMP_NLT_UQ));
+        }
+        dst[i >> 3] = (uint8_t)_mm256_movemask_ps(inside);
+        *visible += __builtin_popcount(dst[i >> 3]);
+    }
+    return i;
+}
+
+// Same evaluation order as frustum_testAABB and without FMA
+SIMD_AVX2_NOFMA static size_t frustum_cullAABBs_avx2(uint8_t* dst, float* a, vec3soa* centers, vec3soa* extents, size_t n, size_t* visible) {
+    __m256 magnitude = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    size_t i;
+    uint8_t j;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(centers->x + i);
+        __m256 y = _mm256_loadu_ps(centers->y + i);
+        __m256 z = _mm256_loadu_ps(centers->z + i);
+        __m256 ex = _mm256_loadu_ps(extents->x + i);
+        __m256 ey = _mm256_loadu_ps(extents->y + i);
+        __m256 ez = _mm256_loadu_ps(extents->z + i);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (j = 0; j < 24; j += 4) {
+            __m256 pa = _mm256_set1_ps(a[j]), pb = _mm256_set1_ps(a[j + 1]), pc = _mm256_set1_ps(a[j + 2]);
+            // Distance of the center, plus the box's projected radius on the normal
+            __m256 d = _mm256_mul_ps(pa, x);
+            __m256 r = _mm256_mul_ps(_mm256_and_ps(pa, magnitude), ex);
+            d = _mm256_add_ps(d, _mm256_mul_ps(pb, y));
+            d = _mm256_add_ps(d, _mm256_mul_ps(pc, z));
+            d = _mm256_add_ps(d, _mm256_set1_ps(a[j + 3]));
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_and_ps(pb, magnitude), ey));
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_and_ps(pc, magnitude), ez));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(d, r), _mm256_setzero_ps(), _CMP_NLT_UQ));
+        }
+        dst[i >> 3] = (uint8_t)_mm256_movemask_ps(inside);
+        *visible += __builtin_popcount(dst[i >> 3]);
+    }
+    return i;
+}
+#endif
+
+/**
+ * Extracts the normalized planes of a view-projection matrix
+ *
+ * @param {frustum} out the receiving planes
+ * @param {mat4} m projection or view-projection matrix with clip z in [-w, w]
+ */
+GL_MATRIX_API void frustum_fromMat4(float* dst, float* m) {
+    uint8_t i;
+
+    // Each plane is the last row of m plus or minus one of the other rows
+    for (i = 0; i < 3; i++) {
+        float* lo = dst + i * 8;
+        float* hi = lo + 4;
+        lo[0] = m[3] + m[i];
+        lo[1] = m[7] + m[4 + i];
+        lo[2] = m[11] + m[8 + i];
+        lo[3] = m[15] + m[12 + i];
+        hi[0] = m[3] - m[i];
+        hi[1] = m[7] - m[4 + i];
+        hi[2] = m[11] - m[8 + i];
+        hi[3] = m[15] - m[12 + i];
+    }
+
+    for (i = 0; i < 24; i += 4) {
+        float len = sqrtf(dst[i] * dst[i] + dst[i + 1] * dst[i + 1] + dst[i + 2] * dst[i + 2]);
+        if (len > 0) {
+            len = 1 / len;
+        }
+        dst[i] *= len;
+        dst[i + 1] *= len;
+        dst[i + 2] *= len;
+        dst[i + 3] *= len;
+    }
+}
+
+/**
+ * Tests a single sphere against a frustum
+ *
+ * @param {frustum} a the frustum planes
+ * @param {vec3} center center of the sphere
+ * @param {Number} radius radius of the sphere
+ * @returns {uint8_t} 1 if the sphere may be visible, 0 if it is outside
+ */
+GL_MATRIX_API uint8_t frustum_testSphere(float* a, float* center, float radius) {
+    uint8_t i;
+    for (i = 0; i < 24; i += 4) {
+        if (a[i] * center[0] + a[i + 1] * center[1] + a[i + 2] * center[2] + a[i + 3] < -radius) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Tests a single axis aligned box against a frustum
+ *
+ * @param {frustum} a the frustum planes
+ * @param {vec3} center center of the box
+ * @param {vec3} extent half size of the box along each axis
+ * @returns {uint8_t} 1 if the box may be visible, 0 if it is outside
+ */
+GL_MATRIX_API uint8_t frustum_testAABB(float* a, float* center, float* extent) {
+    uint8_t i;
+    for (i = 0; i < 24; i += 4) {
+        float d = a[i] * center[0] + a[i + 1] * center[1] + a[i + 2] * center[2] + a[i + 3];
+        float r = fabsf(a[i]) * extent[0] + fabsf(a[i + 1]) * extent[1] + fabsf(a[i + 2]) * extent[2];
+        if (d + r < 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Tests a batch of spheres against a frustum
+ *
+ * @param {uint8_t[]} out the receiving bitmask, (n + 7) / 8 bytes
+ * @param {frustum} a the frustum planes
+ * @param {vec4soa} spheres centers in x, y, z and radii in w
+ * @param {Number} n number of spheres
+ * @returns {Number} number of spheres that may be visible
+ */
+GL_MATRIX_API size_t frustum_cullSpheres(uint8_t* dst, float* a, vec4soa* spheres, size_t n) {
+    size_t i = 0, visible = 0;
+#if GL_MATRIX_SIMD
+    if (frustum_use_avx2) {
+        i = frustum_cullSpheres_avx2(dst, a, spheres, n, &visible);
+    }
+#endif
+    for (; i < n; i++) {
+        float center[3] = { spheres->x[i], spheres->y[i], spheres->z[i] };
+        uint8_t bit = 1 << (i & 7);
+        if (frustum_testSphere(a, center, spheres->w[i])) {
+            dst[i >> 3] |= bit;
+            visible++;
+        }
+        else {
+            dst[i >> 3] &= ~bit;
+        }
+    }
+    return visible;
+}
+
+/**
+ * Tests a batch of axis aligned boxes against a frustum
+ *
+ * @param {uint8_t[]} out the receiving bitmask, (n + 7) / 8 bytes
+ * @param {frustum} a the frustum planes
+ * @param {vec3soa} centers centers of the boxes
+ * @param {vec3soa} extents half sizes of the boxes along each axis
+ * @param {Number} n number of boxes
+ * @returns {Number} number of boxes that may be visible
+ */
+GL_MATRIX_API size_t frustum_cullAABBs(uint8_t* dst, float* a, vec3soa* centers, vec3soa* extents, size_t n) {
+    size_t i = 0, visible = 0;
+#if GL_MATRIX_SIMD
+    if (frustum_use_avx2) {
+        i = frustum_cullAABBs_avx2(dst, a, centers, extents, n, &visible);
+    }
+#endif
+    for (; i < n; i++) {
+        float center[3] = { centers->x[i], centers->y[i], centers->z[i] };
+        float extent[3] = { extents->x[i], extents->y[i], extents->z[i] };
+        uint8_t bit = 1 << (i & 7);
+        if (frustum_testAABB(a, center, extent)) {
+            dst[i >> 3] |= bit;
+            visible++;
+        }
+        else {
+            dst[i >> 3] &= ~bit;
+        }
+    }
+    return visible;
+}
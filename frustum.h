@@ -0,0 +1,76 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+#include "vec3soa.h"
+#include "vec4soa.h"
+
+/**
+ * A frustum is six planes of 4 floats each, 24 floats in total, in the
+ * order left, right, bottom, top, near, far. Plane [a, b, c, d] has a unit
+ * normal [a, b, c] pointing into the frustum, so a point p is inside when
+ * a * p.x + b * p.y + c * p.z + d >= 0 for every plane.
+ *
+ * The batch tests write one bit per volume: bit (i & 7) of dst[i >> 3] is
+ * set when volume i may be visible. They run 8 volumes at a time with
+ * AVX2 when the CPU supports it, in the same order as the single tests and
+ * without FMA, so both agree on every volume. Like all plane tests they are
+ * conservative: volumes near a corner of the frustum can pass while being
+ * outside it. A volume with a NaN component is never culled, by the single
+ * tests or by either path of the batch tests.
+ */
+
+/**
+ * Extracts the normalized planes of a view-projection matrix
+ *
+ * @param {frustum} out the receiving planes
+ * @param {mat4} m projection or view-projection matrix with clip z in [-w, w]
+ */
+GL_MATRIX_API void frustum_fromMat4(float* dst, float* m);
+
+/**
+ * Tests a single sphere against a frustum
+ *
+ * @param {frustum} a the frustum planes
+ * @param {vec3} center center of the sphere
+ * @param {Number} radius radius of the sphere
+ * @returns {uint8_t} 1 if the sphere may be visible, 0 if it is outside
+ */
+GL_MATRIX_API uint8_t frustum_testSphere(float* a, float* center, float radius);
+
+/**
+ * Tests a single axis aligned box against a frustum
+ *
+ * @param {frustum} a the frustum planes
+ * @param {vec3} center center of the box
+ * @param {vec3} extent half size of the box along each axis
+ * @returns {uint8_t} 1 if the box may be visible, 0 if it is outside
+ */
+GL_MATRIX_API uint8_t frustum_testAABB(float* a, float* center, float* extent);
+
+/**
+ * Tests a batch of spheres against a frustum
+ *
+ * @param {uint8_t[]} out the receiving bitmask, (n + 7) / 8 bytes
+ * @param {frustum} a the frustum planes
+ * @param {vec4soa} spheres centers in x, y, z and radii in w
+ * @param {Number} n number of spheres
+ * @returns {Number} number of spheres that may be visible
+ */
+GL_MATRIX_API size_t frustum_cullSpheres(uint8_t* dst, float* a, vec4soa* spheres, size_t n);
+
+/**
+ * Tests a batch of axis aligned boxes against a frustum
+ *
+ * @param {uint8_t[]} out the receiving bitmask, (n + 7) / 8 bytes
+ * @param {frustum} a the frustum planes
+ * @param {vec3soa} centers centers of the boxes
+ * @param {vec3soa} extents half sizes of the boxes along each axis
+ * @param {Number} n number of boxes
+ * @returns {Number} number of boxes that may be visible
+ */
+GL_MATRIX_API size_t frustum_cullAABBs(uint8_t* dst, float* a, vec3soa* centers, vec3soa* extents, size_t n);
+
+#endif
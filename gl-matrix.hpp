@@ -0,0 +1,394 @@
+#ifndef GL_MATRIX_HPP
+#define GL_MATRIX_HPP
+
+/**
+ * Optional C++17 layer over gl-matrix.h.
+ *
+ * vec2, vec3, vec4, quat, mat3 and mat4 are value types holding exactly the
+ * floats the C functions take, so data() passes them to any function of
+ * gl-matrix.h. vec3_ref and friends view an existing float array as one of
+ * them without copying it.
+ *
+ * The element-wise operations (+, -, * and / per component or by a scalar,
+ * unary -, lerp, min and max) build expression templates instead of
+ * results. Assigning an expression computes every component in one pass,
+ * so a chain like a * s + b - c reads each operand once and stores once,
+ * and rounds exactly like the same chain of C calls.
+ *
+ * Operations that mix components (quat and matrix products, transforms,
+ * cross, normalize) run the C function right away on a copy held inside
+ * the expression, which then takes part in the chain like any operand:
+ *
+ *   vec3 p = m * (a * s + b) + offset;
+ *
+ * Expressions refer to their operands, so assign them within the same
+ * statement rather than keeping them in auto variables.
+ *
+ * The constructors are constexpr, so the initializer macros of the C
+ * headers build constant values at compile time:
+ *
+ *   constexpr mat4 proj = MAT4_ORTHO(0, 1280, 0, 720, -1, 1);
+ *
+ * MAT4_PERSPECTIVE calls tanf, which is only constexpr from C++26 on.
+ * GCC folds it anyway, other compilers need a const value instead.
+ */
+#include "gl-matrix.h"
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace gl_matrix {
+
+// The kinds of values. vector kinds multiply per component, the others
+// with their own product
+struct vec2_kind { static constexpr std::size_t size = 2; static constexpr bool vector = true; };
+struct vec3_kind { static constexpr std::size_t size = 3; static constexpr bool vector = true; };
+struct vec4_kind { static constexpr std::size_t size = 4; static constexpr bool vector = true; };
+struct quat_kind { static constexpr std::size_t size = 4; static constexpr bool vector = false; };
+struct mat3_kind { static constexpr std::size_t size = 9; static constexpr bool vector = false; };
+struct mat4_kind { static constexpr std::size_t size = 16; static constexpr bool vector = false; };
+
+namespace detail {
+
+// An expression has a kind and gives its components with operator[]
+template <class E, class = void>
+struct is_expr : std::false_type {};
+
+template <class E>
+struct is_expr<E, std::void_t<typename E::kind>> : std::true_type {};
+
+template <class A, class B>
+using same_kind = std::enable_if_t<is_expr<A>::value && is_expr<B>::value &&
+    std::is_same_v<typename A::kind, typename B::kind>>;
+
+template <class E, class K>
+using of_kind = std::enable_if_t<is_expr<E>::value && std::is_same_v<typename E::kind, K>>;
+
+template <class E>
+inline void evaluate(float* dst, const E& e) {
+    for (std::size_t i = 0; i < E::kind::size; i++) {
+        dst[i] = e[i];
+    }
+}
+
+} // namespace detail
+
+/**
+ * A vector, quaternion or matrix by value, laid out like the C arrays.
+ */
+template <class K>
+struct value {
+    using kind = K;
+    static constexpr std::size_t size = K::size;
+
+    float v[K::size];
+
+    constexpr value() : v{} {}
+
+    template <class... F, class = std::enable_if_t<sizeof...(F) == K::size && (std::is_arithmetic_v<F> && ...)>>
+    constexpr value(F... f) : v{ static_cast<float>(f)... } {}
+
+    template <class E, class = detail::of_kind<E, K>, class = std::enable_if_t<!std::is_same_v<E, value>>>
+    value(const E& e) {
+        detail::evaluate(v, e);
+    }
+
+    template <class E, class = detail::of_kind<E, K>>
+    value& operator=(const E& e) {
+        detail::evaluate(v, e);
+        return *this;
+    }
+
+    constexpr float* data() { return v; }
+    constexpr const float* data() const { return v; }
+    constexpr float& operator[](std::size_t i) { return v[i]; }
+    constexpr float operator[](std::size_t i) const { return v[i]; }
+};
+
+using vec2 = value<vec2_kind>;
+using vec3 = value<vec3_kind>;
+using vec4 = value<vec4_kind>;
+using quat = value<quat_kind>;
+using mat3 = value<mat3_kind>;
+using mat4 = value<mat4_kind>;
+
+/**
+ * Views floats owned elsewhere, e.g. a vertex in a buffer, as a value.
+ * Assigning to it writes through to them.
+ */
+template <class K>
+struct ref {
+    using kind = K;
+    static constexpr std::size_t size = K::size;
+
+    float* p;
+
+    explicit ref(float* p) : p(p) {}
+    ref(value<K>& v) : p(v.v) {}
+    ref(const ref&) = default;
+
+    ref& operator=(const ref& r) {
+        detail::evaluate(p, r);
+        return *this;
+    }
+
+    template <class E, class = detail::of_kind<E, K>>
+    ref& operator=(const E& e) {
+        detail::evaluate(p, e);
+        return *this;
+    }
+
+    float* data() const { return p; }
+    float& operator[](std::size_t i) const { return p[i]; }
+};
+
+using vec2_ref = ref<vec2_kind>;
+using vec3_ref = ref<vec3_kind>;
+using vec4_ref = ref<vec4_kind>;
+using quat_ref = ref<quat_kind>;
+using mat3_ref = ref<mat3_kind>;
+using mat4_ref = ref<mat4_kind>;
+
+namespace detail {
+
+// Values are kept by reference in expressions, everything else by value
+template <class E>
+using stored = std::conditional_t<std::is_same_v<E, value<typename E::kind>>, const E&, E>;
+
+template <class K>
+struct broadcast {
+    using kind = K;
+    float s;
+    float operator[](std::size_t) const { return s; }
+};
+
+template <class Op, class A, class B>
+struct binary {
+    using kind = typename A::kind;
+    stored<A> a;
+    stored<B> b;
+    float operator[](std::size_t i) const { return Op::apply(a[i], b[i]); }
+};
+
+template <class A>
+struct negate {
+    using kind = typename A::kind;
+    stored<A> a;
+    float operator[](std::size_t i) const { return -a[i]; }
+};
+
+struct add { static float apply(float a, float b) { return a + b; } };
+struct subtract { static float apply(float a, float b) { return a - b; } };
+struct multiply { static float apply(float a, float b) { return a * b; } };
+struct divide { static float apply(float a, float b) { return a / b; } };
+struct min { static float apply(float a, float b) { return std::fmin(a, b); } };
+struct max { static float apply(float a, float b) { return std::fmax(a, b); } };
+
+template <class Op, class A, class B>
+inline binary<Op, A, B> make(const A& a, const B& b) {
+    return { a, b };
+}
+
+// A component mixing result, computed when the expression is built
+template <class K>
+struct result {
+    using kind = K;
+    float v[K::size];
+    float operator[](std::size_t i) const { return v[i]; }
+};
+
+template <class E>
+inline result<typename E::kind> materialize(const E& e) {
+    result<typename E::kind> r;
+    evaluate(r.v, e);
+    return r;
+}
+
+// The floats of an operand that a C function only reads: values and refs
+// in place, anything else evaluated into tmp
+template <class E>
+inline float* operand(const E& e, result<typename E::kind>& tmp) {
+    if constexpr (std::is_same_v<E, value<typename E::kind>>) {
+        return const_cast<float*>(e.v);
+    }
+    else if constexpr (std::is_same_v<E, ref<typename E::kind>>) {
+        return e.p;
+    }
+    else {
+        evaluate(tmp.v, e);
+        return tmp.v;
+    }
+}
+
+inline void product(float* a, float* b, quat_kind) { quat_multiply(a, b); }
+inline void product(float* a, float* b, mat3_kind) { mat3_multiply(a, b); }
+inline void product(float* a, float* b, mat4_kind) { mat4_multiply(a, b); }
+
+inline void transform(float* v, float* m, vec3_kind, mat3_kind) { vec3_transformMat3(v, m); }
+inline void transform(float* v, float* m, vec3_kind, mat4_kind) { vec3_transformMat4(v, m); }
+inline void transform(float* v, float* m, vec4_kind, mat4_kind) { vec4_transformMat4(v, m); }
+inline void transform(float* v, float* q, vec3_kind, quat_kind) { vec3_transformQuat(v, q); }
+inline void transform(float* v, float* q, vec4_kind, quat_kind) { vec4_transformQuat(v, q); }
+
+template <class V, class M, class = void>
+struct transforms : std::false_type {};
+
+template <class V, class M>
+struct transforms<V, M, std::void_t<decltype(transform(nullptr, nullptr, V{}, M{}))>> : std::true_type {};
+
+inline float dot(float* a, float* b, vec2_kind) { return vec2_dot(a, b); }
+inline float dot(float* a, float* b, vec3_kind) { return vec3_dot(a, b); }
+inline float dot(float* a, float* b, vec4_kind) { return vec4_dot(a, b); }
+inline float dot(float* a, float* b, quat_kind) { return vec4_dot(a, b); }
+
+inline void normalize(float* a, vec2_kind) { vec2_normalize(a); }
+inline void normalize(float* a, vec3_kind) { vec3_normalize(a); }
+inline void normalize(float* a, vec4_kind) { vec4_normalize(a); }
+inline void normalize(float* a, quat_kind) { vec4_normalize(a); }
+
+} // namespace detail
+
+template <class A, class B, class = detail::same_kind<A, B>>
+inline auto operator+(const A& a, const B& b) {
+    return detail::make<detail::add>(a, b);
+}
+
+template <class A, class B, class = detail::same_kind<A, B>>
+inline auto operator-(const A& a, const B& b) {
+    return detail::make<detail::subtract>(a, b);
+}
+
+template <class A, class = std::enable_if_t<detail::is_expr<A>::value>>
+inline auto operator-(const A& a) {
+    return detail::negate<A>{ a };
+}
+
+/**
+ * Vectors multiply per component. Quaternions and matrices multiply with
+ * quat_multiply and matN_multiply, so a * b applies b first. A mat3, mat4
+ * or quat times a vec3 or vec4 transforms it, as vec3_transformMat4 and
+ * friends do.
+ */
+template <class A, class B, class = std::enable_if_t<detail::is_expr<A>::value && detail::is_expr<B>::value &&
+    (std::is_same_v<typename A::kind, typename B::kind> || detail::transforms<typename B::kind, typename A::kind>::value)>>
+inline auto operator*(const A& a, const B& b) {
+    using K = typename A::kind;
+    if constexpr (!std::is_same_v<K, typename B::kind>) {
+        detail::result<typename B::kind> r = detail::materialize(b);
+        detail::result<K> tmp;
+        detail::transform(r.v, detail::operand(a, tmp), typename B::kind{}, K{});
+        return r;
+    }
+    else if constexpr (K::vector) {
+        return detail::make<detail::multiply>(a, b);
+    }
+    else {
+        detail::result<K> r = detail::materialize(a), tmp;
+        detail::product(r.v, detail::operand(b, tmp), K{});
+        return r;
+    }
+}
+
+template <class A, class = std::enable_if_t<detail::is_expr<A>::value>>
+inline auto operator*(const A& a, float s) {
+    return detail::make<detail::multiply>(a, detail::broadcast<typename A::kind>{ s });
+}
+
+template <class A, class = std::enable_if_t<detail::is_expr<A>::value>>
+inline auto operator*(float s, const A& a) {
+    return detail::make<detail::multiply>(a, detail::broadcast<typename A::kind>{ s });
+}
+
+template <class A, class B, class = detail::same_kind<A, B>, class = std::enable_if_t<A::kind::vector>>
+inline auto operator/(const A& a, const B& b) {
+    return detail::make<detail::divide>(a, b);
+}
+
+template <class A, class = std::enable_if_t<detail::is_expr<A>::value>>
+inline auto operator/(const A& a, float s) {
+    return detail::make<detail::divide>(a, detail::broadcast<typename A::kind>{ s });
+}
+
+template <class K, class B, class = detail::of_kind<B, K>>
+inline value<K>& operator+=(value<K>& a, const B& b) {
+    return a = a + b;
+}
+
+template <class K, class B, class = detail::of_kind<B, K>>
+inline value<K>& operator-=(value<K>& a, const B& b) {
+    return a = a - b;
+}
+
+template <class K>
+inline value<K>& operator*=(value<K>& a, float s) {
+    return a = a * s;
+}
+
+/**
+ * Linear interpolation, a + t * (b - a) per component like vecN_lerp.
+ */
+template <class A, class B, class = detail::same_kind<A, B>>
+inline auto lerp(const A& a, const B& b, float t) {
+    return a + t * (b - a);
+}
+
+template <class A, class B, class = detail::same_kind<A, B>, class = std::enable_if_t<A::kind::vector>>
+inline auto min(const A& a, const B& b) {
+    return detail::make<detail::min>(a, b);
+}
+
+template <class A, class B, class = detail::same_kind<A, B>, class = std::enable_if_t<A::kind::vector>>
+inline auto max(const A& a, const B& b) {
+    return detail::make<detail::max>(a, b);
+}
+
+template <class A, class B, class = detail::same_kind<A, B>>
+inline float dot(const A& a, const B& b) {
+    detail::result<typename A::kind> tmp_a, tmp_b;
+    return detail::dot(detail::operand(a, tmp_a), detail::operand(b, tmp_b), typename A::kind{});
+}
+
+template <class A, class = std::enable_if_t<detail::is_expr<A>::value>>
+inline auto normalize(const A& a) {
+    detail::result<typename A::kind> r = detail::materialize(a);
+    detail::normalize(r.v, typename A::kind{});
+    return r;
+}
+
+template <class A, class B, class = detail::same_kind<A, B>, class = detail::of_kind<A, vec3_kind>>
+inline auto cross(const A& a, const B& b) {
+    detail::result<vec3_kind> r = detail::materialize(a), tmp;
+    vec3_cross(r.v, detail::operand(b, tmp));
+    return r;
+}
+
+template <class A, class B, class = detail::same_kind<A, B>, class = detail::of_kind<A, quat_kind>>
+inline auto slerp(const A& a, const B& b, float t) {
+    detail::result<quat_kind> r = detail::materialize(a), tmp;
+    quat_slerp(r.v, detail::operand(b, tmp), t);
+    return r;
+}
+
+template <class A, class = detail::of_kind<A, quat_kind>>
+inline auto conjugate(const A& a) {
+    detail::result<quat_kind> r = detail::materialize(a);
+    quat_conjugate(r.v);
+    return r;
+}
+
+template <class A, class = std::enable_if_t<std::is_same_v<typename A::kind, mat3_kind> ||
+    std::is_same_v<typename A::kind, mat4_kind>>>
+inline auto transpose(const A& a) {
+    detail::result<typename A::kind> r = detail::materialize(a);
+    if constexpr (std::is_same_v<typename A::kind, mat3_kind>) {
+        mat3_transpose(r.v);
+    }
+    else {
+        mat4_transpose(r.v);
+    }
+    return r;
+}
+
+} // namespace gl_matrix
+
+#endif
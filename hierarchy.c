@@ -0,0 +1,157 @@
+#include "hierarchy.h"
+#include "mat4.h"
+#include "cpu.h"
+#include "simd.h"
+#include <string.h>
+
+static uint8_t hierarchy_use_avx2 = 0;
+
+__attribute__((constructor))
+static void hierarchy_dispatch(void) {
+    hierarchy_use_avx2 = (cpu_features() & CPU_AVX2) != 0;
+}
+
+#if GL_MATRIX_SIMD
+// mat4_fromRotationTranslationScale for the dirty nodes of eight consecutive
+// ones, in the same evaluation order and without FMA, so results are
+// bit-identical
+SIMD_AVX2_NOFMA static void hierarchy_local_avx2(float* dst, float* t, float* r, float* s, uint8_t* dirty) {
+    __m256i idx3 = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    __m256i idx4 = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+    __m256 x = _mm256_i32gather_ps(r, idx4, 4);
+    __m256 y = _mm256_i32gather_ps(r + 1, idx4, 4);
+    __m256 z = _mm256_i32gather_ps(r + 2, idx4, 4);
+    __m256 w = _mm256_i32gather_ps(r + 3, idx4, 4);
+    __m256 sx = _mm256_i32gather_ps(s, idx3, 4);
+    __m256 sy = _mm256_i32gather_ps(s + 1, idx3, 4);
+    __m256 sz = _mm256_i32gather_ps(s + 2, idx3, 4);
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 m[16];
+    uint8_t j;
+
+    __m256 x2 = _mm256_add_ps(x, x);
+    __m256 y2 = _mm256_add_ps(y, y);
+    __m256 z2 = _mm256_add_ps(z, z);
+    __m256 xx = _mm256_mul_ps(x, x2);
+    __m256 xy = _mm256_mul_ps(x, y2);
+    __m256 xz = _mm256_mul_ps(x, z2);
+    __m256 yy = _mm256_mul_ps(y, y2);
+    __m256 yz = _mm256_mul_ps(y, z2);
+    __m256 zz = _mm256_mul_ps(z, z2);
+    __m256 wx = _mm256_mul_ps(w, x2);
+    __m256 wy = _mm256_mul_ps(w, y2);
+    __m256 wz = _mm256_mul_ps(w, z2);
+
+    m[0] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), sx);
+    m[1] = _mm256_mul_ps(_mm256_add_ps(xy, wz), sx);
+    m[2] = _mm256_mul_ps(_mm256_sub_ps(xz, wy), sx);
+    m[3] = zero;
+    m[4] = _mm256_mul_ps(_mm256_sub_ps(xy, wz), sy);
+    m[5] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, zz)), sy);
+    m[6] = _mm256_mul_ps(_mm256_add_ps(yz, wx), sy);
+    m[7] = zero;
+    m[8] = _mm256_mul_ps(_mm256_add_ps(xz, wy), sz);
+    m[9] = _mm256_mul_ps(_mm256_sub_ps(yz, wx), sz);
+    m[10] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, yy)), sz);
+    m[11] = zero;
+    m[12] = _mm256_i32gather_ps(t, idx3, 4);
+    m[13] = _mm256_i32gather_ps(t + 1, idx3, 4);
+    m[14] = _mm256_i32gather_ps(t + 2, idx3, 4);
+    m[15] = one;
+
+    // Element k of all eight matrices is in m[k], turn that into one matrix
+    // per node. Clean nodes keep their local matrix, even if their TRS was
+    // changed without marking them dirty.
+    simd_transpose8_ps(m);
+    simd_transpose8_ps(m + 8);
+    for (j = 0; j < 8; j++) {
+        if (!dirty[j]) {
+            continue;
+        }
+        _mm256_storeu_ps(dst + j * 16, m[j]);
+        _mm256_storeu_ps(dst + j * 16 + 8, m[j + 8]);
+    }
+}
+#endif
+
+GL_MATRIX_API uint8_t hierarchy_validate(hierarchy* a) {
+    size_t i;
+    for (i = 0; i < a->count; i++) {
+        if (a->parent[i] < -1 || a->parent[i] >= (int64_t)i) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+GL_MATRIX_API void hierarchy_setTRS(hierarchy* dst, size_t node, float* t, float* r, float* s) {
+    memcpy(dst->translation + node * 3, t, 3 * sizeof(float));
+    memcpy(dst->rotation + node * 4, r, 4 * sizeof(float));
+    memcpy(dst->scale + node * 3, s, 3 * sizeof(float));
+    dst->dirty[node] = 1;
+}
+
+GL_MATRIX_API void hierarchy_markDirty(hierarchy* dst, size_t node) {
+    dst->dirty[node] = 1;
+}
+
+GL_MATRIX_API void hierarchy_markAllDirty(hierarchy* dst) {
+    memset(dst->dirty, 1, dst->count);
+}
+
+GL_MATRIX_API size_t hierarchy_update(hierarchy* dst) {
+    size_t i, j, block, n = dst->count, updated = 0;
+
+    // Blocks of 8 nodes. Parents always come first, so their world
+    // matrices are final by the time a child is reached.
+    for (i = 0; i < n; i += block) {
+        uint8_t any = 0;
+        block = n - i < 8 ? n - i : 8;
+
+        for (j = i; j < i + block; j++) {
+            int32_t p = dst->parent[j];
+            if (p >= 0 && dst->dirty[p]) {
+                dst->dirty[j] = 1;
+            }
+            any |= dst->dirty[j];
+        }
+        if (!any) {
+            continue;
+        }
+
+#if GL_MATRIX_SIMD
+        // Computing the clean nodes of the block too is cheaper than
+        // splitting it, only the dirty ones are stored
+        if (hierarchy_use_avx2 && block == 8) {
+            hierarchy_local_avx2(dst->local + i * 16, dst->translation + i * 3, dst->rotation + i * 4, dst->scale + i * 3, dst->dirty + i);
+        }
+        else
+#endif
+        for (j = i; j < i + block; j++) {
+            if (dst->dirty[j]) {
+                mat4_fromRotationTranslationScale(dst->local + j * 16, dst->rotation + j * 4, dst->translation + j * 3, dst->scale + j * 3);
+            }
+        }
+
+        for (j = i; j < i + block; j++) {
+            float* world = dst->world + j * 16;
+            int32_t p = dst->parent[j];
+
+            if (!dst->dirty[j]) {
+                continue;
+            }
+            if (p < 0) {
+                mat4_copy(world, dst->local + j * 16);
+            }
+            else {
+                mat4_copy(world, dst->world + p * 16);
+                mat4_multiply(world, dst->local + j * 16);
+            }
+            updated++;
+        }
+    }
+
+    memset(dst->dirty, 0, n);
+    return updated;
+}
@@ -0,0 +1,82 @@
+#ifndef HIERARCHY_H
+#define HIERARCHY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+
+/**
+ * A transform hierarchy of count nodes. Every node has a translation,
+ * rotation and scale relative to its parent, from which hierarchy_update
+ * derives the node's local and world matrices.
+ *
+ * Nodes must be stored in topological order: parent[i] is -1 for a root
+ * and less than i otherwise. All arrays are caller storage of count
+ * entries: vec3s for translation and scale, quats for rotation, mat4s for
+ * local and world, and one 0/1 flag per node for dirty.
+ *
+ * Set a node's dirty flag after changing its translation, rotation or
+ * scale. hierarchy_update recomputes exactly the dirty nodes and their
+ * descendants.
+ */
+typedef struct {
+    int32_t* parent;
+    float* translation;
+    float* rotation;
+    float* scale;
+    float* local;
+    float* world;
+    uint8_t* dirty;
+    size_t count;
+} hierarchy;
+
+/**
+ * Checks that every parent index is -1 or comes before its child
+ *
+ * @param {hierarchy} a the hierarchy to check
+ * @returns {uint8_t} 1 if the nodes are in topological order, 0 otherwise
+ */
+GL_MATRIX_API uint8_t hierarchy_validate(hierarchy* a);
+
+/**
+ * Sets the translation, rotation and scale of a node and marks it dirty
+ *
+ * @param {hierarchy} out the hierarchy
+ * @param {Number} node index of the node
+ * @param {vec3} t translation relative to the parent
+ * @param {quat} r rotation relative to the parent
+ * @param {vec3} s scale relative to the parent
+ */
+GL_MATRIX_API void hierarchy_setTRS(hierarchy* dst, size_t node, float* t, float* r, float* s);
+
+/**
+ * Marks a node dirty, so it and its descendants are recomputed by the
+ * next hierarchy_update
+ *
+ * @param {hierarchy} out the hierarchy
+ * @param {Number} node index of the node
+ */
+GL_MATRIX_API void hierarchy_markDirty(hierarchy* dst, size_t node);
+
+/**
+ * Marks every node dirty
+ *
+ * @param {hierarchy} out the hierarchy
+ */
+GL_MATRIX_API void hierarchy_markAllDirty(hierarchy* dst);
+
+/**
+ * Recomputes the local and world matrices of dirty nodes and their
+ * descendants in a single pass, then clears all dirty flags.
+ * local = mat4_fromRotationTranslationScale(rotation, translation, scale)
+ * world = parent world * local, or local for roots
+ *
+ * With AVX2, the local matrices are built eight nodes at a time, with the
+ * same results as mat4_fromRotationTranslationScale.
+ *
+ * @param {hierarchy} out the hierarchy
+ * @returns {Number} number of nodes that were recomputed
+ */
+GL_MATRIX_API size_t hierarchy_update(hierarchy* dst);
+
+#endif
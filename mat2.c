@@ -1,25 +1,25 @@
 #include "mat2.h"
 #include <math.h>
 
-void mat2_identity(float* dst) {
+GL_MATRIX_API void mat2_identity(float* dst) {
     dst[0] = 1;
     dst[3] = 1;
 }
 
-void mat2_copy(float* dst, float* src) {
+GL_MATRIX_API void mat2_copy(float* dst, float* src) {
     dst[0] = src[0];
     dst[1] = src[1];
     dst[2] = src[2];
     dst[3] = src[3];
 }
 
-void mat2_transpose(float* dst) {
+GL_MATRIX_API void mat2_transpose(float* dst) {
     float a1 = dst[1];
     dst[1] = dst[2];
     dst[2] = a1;
 }
 
-void mat2_invert(float* dst) {
+GL_MATRIX_API void mat2_invert(float* dst) {
     float a0 = dst[0];
     float a1 = dst[1];
     float a2 = dst[2];
@@ -38,7 +38,7 @@ void mat2_invert(float* dst) {
     dst[3] =  a0 * det;
 }
 
-void mat2_adjoint(float* dst) {
+GL_MATRIX_API void mat2_adjoint(float* dst) {
     float a0 = dst[0];
     dst[0] =  dst[3];
     dst[1] = -dst[1];
@@ -46,11 +46,11 @@ void mat2_adjoint(float* dst) {
     dst[3] =  a0;
 }
 
-float mat2_determinant(float* dst) {
+GL_MATRIX_API float mat2_determinant(float* dst) {
     return dst[0] * dst[3] - dst[2] * dst[1];
 }
 
-void mat2_multiply(float* dst, float* op) {
+GL_MATRIX_API void mat2_multiply(float* dst, float* op) {
     float a0 = dst[0], a1 = dst[1], a2 = dst[2], a3 = dst[3];
     float b0 = op[0], b1 = op[1], b2 = op[2], b3 = op[3];
     dst[0] = a0 * b0 + a2 * b1;
@@ -59,7 +59,7 @@ void mat2_multiply(float* dst, float* op) {
     dst[3] = a1 * b2 + a3 * b3;
 }
 
-void mat2_rotate(float* dst, float rad) {
+GL_MATRIX_API void mat2_rotate(float* dst, float rad) {
     float a0 = dst[0], a1 = dst[1], a2 = dst[2], a3 = dst[3];
     float s = sinf(rad);
     float c = cosf(rad);
@@ -69,7 +69,7 @@ void mat2_rotate(float* dst, float rad) {
     dst[3] = (a1 * -s) + (a3 * c);
 }
 
-void mat2_scale(float* dst, float* v) {
+GL_MATRIX_API void mat2_scale(float* dst, float* v) {
     float a0 = dst[0], a1 = dst[1], a2 = dst[2], a3 = dst[3];
     float v0 = v[0], v1 = v[1];
     dst[0] = a0 * v0;
@@ -78,7 +78,7 @@ void mat2_scale(float* dst, float* v) {
     dst[3] = a3 * v1;
 }
 
-void mat2_fromRotation(float* dst, float rad) {
+GL_MATRIX_API void mat2_fromRotation(float* dst, float rad) {
     float s = sinf(rad);
     float c = cosf(rad);
     dst[0] = c;
@@ -87,39 +87,39 @@ void mat2_fromRotation(float* dst, float rad) {
     dst[3] = c;
 }
 
-void mat2_fromScaling(float* dst, float* v) {
+GL_MATRIX_API void mat2_fromScaling(float* dst, float* v) {
     dst[0] = v[0];
     dst[1] = 0;
     dst[2] = 0;
     dst[3] = v[1];
 }
 
-void mat2_add(float* dst, float* b) {
+GL_MATRIX_API void mat2_add(float* dst, float* b) {
     dst[0] = dst[0] + b[0];
     dst[1] = dst[1] + b[1];
     dst[2] = dst[2] + b[2];
     dst[3] = dst[3] + b[3];
 }
 
-void mat2_subtract(float* dst, float* b) {
+GL_MATRIX_API void mat2_subtract(float* dst, float* b) {
     dst[0] = dst[0] - b[0];
     dst[1] = dst[1] - b[1];
     dst[2] = dst[2] - b[2];
     dst[3] = dst[3] - b[3];
 }
 
-uint8_t mat2_equals(float* a, float* b) {
+GL_MATRIX_API uint8_t mat2_equals(float* a, float* b) {
   return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
 }
 
-void mat2_multiplyScalar(float* dst, float b) {
+GL_MATRIX_API void mat2_multiplyScalar(float* dst, float b) {
     dst[0] = dst[0] * b;
     dst[1] = dst[1] * b;
     dst[2] = dst[2] * b;
     dst[3] = dst[3] * b;
 }
 
-void mat2_multiplyScalarAndAdd(float* dst, float* b, float scale) {
+GL_MATRIX_API void mat2_multiplyScalarAndAdd(float* dst, float* b, float scale) {
     dst[0] = dst[0] + (b[0] * scale);
     dst[1] = dst[1] + (b[1] * scale);
     dst[2] = dst[2] + (b[2] * scale);
@@ -2,13 +2,14 @@
 #define MAT2_H
 
 #include <stdint.h>
+#include "api.h"
 
 /**
  * Set a mat2 to the identity matrix
  *
  * @param {mat2} out the receiving matrix
  */
-void mat2_identity(float* dst);
+GL_MATRIX_API void mat2_identity(float* dst);
 
 /**
  * Copy a mat2 to another mat2
@@ -16,28 +17,28 @@ void mat2_identity(float* dst);
  * @param {mat2} out the receiving matrix
  * @param {mat2} out the source matrix
  */
-void mat2_copy(float* dst, float* src);
+GL_MATRIX_API void mat2_copy(float* dst, float* src);
 
 /**
  * Transpose the values of a mat2
  *
  * @param {mat2} the matrix
  */
-void mat2_transpose(float* dst);
+GL_MATRIX_API void mat2_transpose(float* dst);
 
 /**
  * Inverts a mat2
  *
  * @param {mat2} the matrix
  */
-void mat2_invert(float* dst);
+GL_MATRIX_API void mat2_invert(float* dst);
 
 /**
  * Calculates the adjugate of a mat2
  *
  * @param {mat2} the matrix
  */
-void mat2_adjoint(float* dst);
+GL_MATRIX_API void mat2_adjoint(float* dst);
 
 /**
  * Calculates the determinant of a mat2
@@ -45,7 +46,7 @@ void mat2_adjoint(float* dst);
  * @param {mat2} a the source matrix
  * @returns {float} determinant of a
  */
-float mat2_determinant(float* dst);
+GL_MATRIX_API float mat2_determinant(float* dst);
 
 /**
  * Multiplies two mat2's
@@ -53,7 +54,7 @@ float mat2_determinant(float* dst);
  * @param {mat2} out the receiving matrix
  * @param {mat2} the operand
  */
-void mat2_multiply(float* dst, float* op);
+GL_MATRIX_API void mat2_multiply(float* dst, float* op);
 
 /**
  * Rotates a mat2 by the given angle
@@ -61,7 +62,7 @@ void mat2_multiply(float* dst, float* op);
  * @param {mat2} out the receiving matrix
  * @param {Number} rad the angle to rotate the matrix by
  */
-void mat2_rotate(float* dst, float rad);
+GL_MATRIX_API void mat2_rotate(float* dst, float rad);
 
 /**
  * Scales the mat2 by the dimensions in the given vec2
@@ -69,7 +70,7 @@ void mat2_rotate(float* dst, float rad);
  * @param {mat2} out the receiving matrix
  * @param {vec2} v the vec2 to scale the matrix by
  **/
-void mat2_scale(float* dst, float* v);
+GL_MATRIX_API void mat2_scale(float* dst, float* v);
 
 /**
  * Creates a matrix from a given angle
@@ -81,7 +82,7 @@ void mat2_scale(float* dst, float* v);
  * @param {mat2} out mat2 receiving operation result
  * @param {Number} rad the angle to rotate the matrix by
  */
-void mat2_fromRotation(float* dst, float rad);
+GL_MATRIX_API void mat2_fromRotation(float* dst, float rad);
 
 /**
  * Creates a matrix from a vector scaling
@@ -93,7 +94,7 @@ void mat2_fromRotation(float* dst, float rad);
  * @param {mat2} out mat2 receiving operation result
  * @param {vec2} v Scaling vector
  */
-void mat2_fromScaling(float* dst, float* v);
+GL_MATRIX_API void mat2_fromScaling(float* dst, float* v);
 
 /**
  * Adds two mat2's
@@ -101,7 +102,7 @@ void mat2_fromScaling(float* dst, float* v);
  * @param {mat2} the receiving matrix
  * @param {mat2} the operand
  */
-void mat2_add(float* dst, float* a);
+GL_MATRIX_API void mat2_add(float* dst, float* a);
 
 /**
  * Subtracts matrix b from matrix a
@@ -109,7 +110,7 @@ void mat2_add(float* dst, float* a);
  * @param {mat2} the receiving matrix
  * @param {mat2} the operand
  */
-void mat2_subtract(float* dst, float* b);
+GL_MATRIX_API void mat2_subtract(float* dst, float* b);
 
 /**
  * Returns whether or not the matrices have exactly the same elements.
@@ -118,7 +119,7 @@ void mat2_subtract(float* dst, float* b);
  * @param {mat2} b The second matrix.
  * @returns {uint8_t} 1 if the matrices are equal, 0 otherwise.
  */
-uint8_t mat2_equals(float* a, float* b);
+GL_MATRIX_API uint8_t mat2_equals(float* a, float* b);
 
 /**
  * Multiply each element of the matrix by a scalar.
@@ -126,7 +127,7 @@ uint8_t mat2_equals(float* a, float* b);
  * @param {mat2} out the receiving matrix
  * @param {Number} b amount to scale the matrix's elements by
  */
-void mat2_multiplyScalar(float* dst, float b);
+GL_MATRIX_API void mat2_multiplyScalar(float* dst, float b);
 
 /**
  * Adds two mat2's after multiplying each element of the second operand by a scalar value.
@@ -135,6 +136,14 @@ void mat2_multiplyScalar(float* dst, float b);
  * @param {mat2} b the second operand
  * @param {Number} scale the amount to scale b's elements by before adding
  */
-void mat2_multiplyScalarAndAdd(float* dst, float* b, float scale);
+GL_MATRIX_API void mat2_multiplyScalarAndAdd(float* dst, float* b, float scale);
+
+/*
+ * Initializers for constant matrices, with the same elements as the
+ * functions of the same name. See MAT4_IDENTITY.
+ */
+#define MAT2_IDENTITY { 1, 0, 0, 1 }
+
+#define MAT2_FROM_SCALING(x, y) { (float)(x), 0, 0, (float)(y) }
 
 #endif
@@ -1,4 +1,6 @@
 #include "mat3.h"
+#include "cpu.h"
+#include "simd.h"
 #include <math.h>
 
 /**
@@ -7,7 +9,7 @@
  * @param {mat3} out the receiving 3x3 matrix
  * @param {mat4} a   the source 4x4 matrix
  */
-void mat3_fromMat4(float* dst, float* a) {
+GL_MATRIX_API void mat3_fromMat4(float* dst, float* a) {
     dst[0] = a[0];
     dst[1] = a[1];
     dst[2] = a[2];
@@ -25,7 +27,7 @@ void mat3_fromMat4(float* dst, float* a) {
  * @param {mat3} out the receiving matrix
  * @param {mat3} a the source matrix
  */
-void mat3_copy(float* dst, float* a) {
+GL_MATRIX_API void mat3_copy(float* dst, float* a) {
     dst[0] = a[0];
     dst[1] = a[1];
     dst[2] = a[2];
@@ -51,7 +53,7 @@ void mat3_copy(float* dst, float* a) {
  * @param {Number} m21 Component in column 2, row 1 position (index 7)
  * @param {Number} m22 Component in column 2, row 2 position (index 8)
  */
-void mat3_set(float* dst, float m00, float m01, float m02, float m10, float m11, float m12, float m20, float m21, float m22) {
+GL_MATRIX_API void mat3_set(float* dst, float m00, float m01, float m02, float m10, float m11, float m12, float m20, float m21, float m22) {
     dst[0] = m00;
     dst[1] = m01;
     dst[2] = m02;
@@ -68,7 +70,7 @@ void mat3_set(float* dst, float m00, float m01, float m02, float m10, float m11,
  *
  * @param {mat3} out the receiving matrix
  */
-void mat3_identity(float* dst) {
+GL_MATRIX_API void mat3_identity(float* dst) {
     dst[0] = 1;
     dst[1] = 0;
     dst[2] = 0;
@@ -85,7 +87,7 @@ void mat3_identity(float* dst) {
  *
  * @param {mat3} out the receiving matrix
  */
-void mat3_transpose(float* dst) {
+GL_MATRIX_API void mat3_transpose(float* dst) {
     // If we are transposing ourselves we can skip a few steps but have to cache some values
     float a01 = dst[1], a02 = dst[2], a12 = dst[5];
     dst[1] = dst[3];
@@ -102,7 +104,7 @@ void mat3_transpose(float* dst) {
  * @param {mat3} out the receiving matrix
  * @returns {mat3} out
  */
-void mat3_invert(float* dst) {
+GL_MATRIX_API void mat3_invert(float* dst) {
     float a00 = dst[0], a01 = dst[1], a02 = dst[2];
     float a10 = dst[3], a11 = dst[4], a12 = dst[5];
     float a20 = dst[6], a21 = dst[7], a22 = dst[8];
@@ -135,7 +137,7 @@ void mat3_invert(float* dst) {
  *
  * @param {mat3} out the receiving matrix
  */
-void mat3_adjoint(float* dst) {
+GL_MATRIX_API void mat3_adjoint(float* dst) {
     float a00 = dst[0], a01 = dst[1], a02 = dst[2];
     float a10 = dst[3], a11 = dst[4], a12 = dst[5];
     float a20 = dst[6], a21 = dst[7], a22 = dst[8];
@@ -157,7 +159,7 @@ void mat3_adjoint(float* dst) {
  * @param {mat3} a the source matrix
  * @returns {Number} determinant of a
  */
-float mat3_determinant(float* dst) {
+GL_MATRIX_API float mat3_determinant(float* dst) {
     float a00 = dst[0], a01 = dst[1], a02 = dst[2];
     float a10 = dst[3], a11 = dst[4], a12 = dst[5];
     float a20 = dst[6], a21 = dst[7], a22 = dst[8];
@@ -171,7 +173,7 @@ float mat3_determinant(float* dst) {
  * @param {mat3} out the receiving matrix
  * @param {mat3} b the second operand
  */
-void mat3_multiply(float* dst, float* b) {
+GL_MATRIX_API void mat3_multiply(float* dst, float* b) {
     float a00 = dst[0], a01 = dst[1], a02 = dst[2];
     float a10 = dst[3], a11 = dst[4], a12 = dst[5];
     float a20 = dst[6], a21 = dst[7], a22 = dst[8];
@@ -199,7 +201,7 @@ void mat3_multiply(float* dst, float* b) {
  * @param {mat3} out the receiving matrix
  * @param {vec2} v vector to translate by
  */
-void mat3_translate(float* dst, float* v) {
+GL_MATRIX_API void mat3_translate(float* dst, float* v) {
     float a00 = dst[0], a01 = dst[1], a02 = dst[2],
         a10 = dst[3], a11 = dst[4], a12 = dst[5],
         a20 = dst[6], a21 = dst[7], a22 = dst[8],
@@ -224,7 +226,7 @@ void mat3_translate(float* dst, float* v) {
  * @param {mat3} out the receiving matrix
  * @param {Number} rad the angle to rotate the matrix by
  */
-void mat3_rotate(float* dst, float rad) {
+GL_MATRIX_API void mat3_rotate(float* dst, float rad) {
     float a00 = dst[0], a01 = dst[1], a02 = dst[2],
         a10 = dst[3], a11 = dst[4], a12 = dst[5],
         a20 = dst[6], a21 = dst[7], a22 = dst[8],
@@ -251,7 +253,7 @@ void mat3_rotate(float* dst, float rad) {
  * @param {mat3} out the receiving matrix
  * @param {vec2} v the vec2 to scale the matrix by
  **/
-void mat3_scale(float* dst, float* v) {
+GL_MATRIX_API void mat3_scale(float* dst, float* v) {
     float x = v[0], y = v[1];
 
     dst[0] = x * dst[0];
@@ -277,7 +279,7 @@ void mat3_scale(float* dst, float* v) {
  * @param {mat3} out mat3 receiving operation result
  * @param {vec2} v Translation vector
  */
-void mat3_fromTranslation(float* dst, float* v) {
+GL_MATRIX_API void mat3_fromTranslation(float* dst, float* v) {
     dst[0] = 1;
     dst[1] = 0;
     dst[2] = 0;
@@ -300,7 +302,7 @@ void mat3_fromTranslation(float* dst, float* v) {
  * @param {Number} rad the angle to rotate the matrix by
  * @returns {mat3} out
  */
-void mat3_fromRotation(float* dst, float rad) {
+GL_MATRIX_API void mat3_fromRotation(float* dst, float rad) {
     float s = sinf(rad), c = cosf(rad);
 
     dst[0] = c;
@@ -326,7 +328,7 @@ void mat3_fromRotation(float* dst, float rad) {
  * @param {mat3} out mat3 receiving operation result
  * @param {vec2} v Scaling vector
  */
-void mat3_fromScaling(float* dst, float* v) {
+GL_MATRIX_API void mat3_fromScaling(float* dst, float* v) {
     dst[0] = v[0];
     dst[1] = 0;
     dst[2] = 0;
@@ -346,7 +348,7 @@ void mat3_fromScaling(float* dst, float* v) {
  * @param {mat3} out the receiving matrix
  * @param {mat2d} a the matrix to copy
  **/
-void mat3_fromMat2d(float* dst, float* a) {
+GL_MATRIX_API void mat3_fromMat2d(float* dst, float* a) {
     dst[0] = a[0];
     dst[1] = a[1];
     dst[2] = 0;
@@ -366,7 +368,7 @@ void mat3_fromMat2d(float* dst, float* a) {
 * @param {mat3} out mat3 receiving operation result
 * @param {quat} q Quaternion to create matrix from
 */
-void mat3_fromQuat(float* dst, float* q) {
+GL_MATRIX_API void mat3_fromQuat(float* dst, float* q) {
     float x = q[0], y = q[1], z = q[2], w = q[3];
     float x2 = x + x;
     float y2 = y + y;
@@ -401,7 +403,7 @@ void mat3_fromQuat(float* dst, float* q) {
 * @param {mat3} out mat3 receiving operation result
 * @param {mat4} a Mat4 to derive the normal matrix from
 */
-void mat3_normalFromMat4(float* dst, float* a) {
+GL_MATRIX_API void mat3_normalFromMat4(float* dst, float* a) {
     float a00 = a[0], a01 = a[1], a02 = a[2], a03 = a[3];
     float a10 = a[4], a11 = a[5], a12 = a[6], a13 = a[7];
     float a20 = a[8], a21 = a[9], a22 = a[10], a23 = a[11];
@@ -448,7 +450,7 @@ void mat3_normalFromMat4(float* dst, float* a) {
  * @param {number} width Width of your gl context
  * @param {number} height Height of gl context
  */
-void mat3_projection(float* dst, float width, float height) {
+GL_MATRIX_API void mat3_projection(float* dst, float width, float height) {
     dst[0] = 2 / width;
     dst[1] = 0;
     dst[2] = 0;
@@ -466,7 +468,7 @@ void mat3_projection(float* dst, float width, float height) {
  * @param {mat3} a the matrix to calculate Frobenius norm of
  * @returns {Number} Frobenius norm
  */
-float mat3_frob(float* a) {
+GL_MATRIX_API float mat3_frob(float* a) {
   return (sqrtf(powf(a[0], 2) + powf(a[1], 2) + powf(a[2], 2) + powf(a[3], 2) + powf(a[4], 2) + powf(a[5], 2) + powf(a[6], 2) + powf(a[7], 2) + powf(a[8], 2)));
 }
 
@@ -476,7 +478,7 @@ float mat3_frob(float* a) {
  * @param {mat3} out the receiving matrix
  * @param {mat3} b the second operand
  */
-void mat3_add(float* dst, float* b) {
+GL_MATRIX_API void mat3_add(float* dst, float* b) {
     dst[0] = dst[0] + b[0];
     dst[1] = dst[1] + b[1];
     dst[2] = dst[2] + b[2];
@@ -494,7 +496,7 @@ void mat3_add(float* dst, float* b) {
  * @param {mat3} out the receiving matrix
  * @param {mat3} b the second operand
  */
-void mat3_subtract(float* dst, float* b) {
+GL_MATRIX_API void mat3_subtract(float* dst, float* b) {
     dst[0] = dst[0] - b[0];
     dst[1] = dst[1] - b[1];
     dst[2] = dst[2] - b[2];
@@ -512,7 +514,7 @@ void mat3_subtract(float* dst, float* b) {
  * @param {mat3} out the receiving matrix
  * @param {Number} b amount to scale the matrix's elements by
  */
-void mat3_multiplyScalar(float* dst, float b) {
+GL_MATRIX_API void mat3_multiplyScalar(float* dst, float b) {
     dst[0] = dst[0] * b;
     dst[1] = dst[1] * b;
     dst[2] = dst[2] * b;
@@ -531,7 +533,7 @@ void mat3_multiplyScalar(float* dst, float b) {
  * @param {mat3} b the second operand
  * @param {Number} scale the amount to scale b's elements by before adding
  */
-void mat3_multiplyScalarAndAdd(float* dst, float* b, float scale) {
+GL_MATRIX_API void mat3_multiplyScalarAndAdd(float* dst, float* b, float scale) {
     dst[0] = dst[0] + (b[0] * scale);
     dst[1] = dst[1] + (b[1] * scale);
     dst[2] = dst[2] + (b[2] * scale);
@@ -550,8 +552,397 @@ void mat3_multiplyScalarAndAdd(float* dst, float* b, float scale) {
  * @param {mat3} b The second matrix.
  * @returns {uint8_t} 1 if the matrices are equal, 0 otherwise.
  */
-uint8_t mat3_equals(float* a, float* b) {
+GL_MATRIX_API uint8_t mat3_equals(float* a, float* b) {
     return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] &&
         a[3] == b[3] && a[4] == b[4] && a[5] == b[5] &&
         a[6] == b[6] && a[7] == b[7] && a[8] == b[8];
 }
+
+// Float only
+/**
+ * Copies a mat3 into the padded layout
+ *
+ * @param {mat3_aligned} out the receiving padded matrix, may be a itself if it has room for 12 floats
+ * @param {mat3} a the source matrix
+ */
+GL_MATRIX_API void mat3_toPadded(float* dst, float* a) {
+    // Backwards, so that a may be dst
+    dst[11] = 0;
+    dst[10] = a[8];
+    dst[9] = a[7];
+    dst[8] = a[6];
+    dst[7] = 0;
+    dst[6] = a[5];
+    dst[5] = a[4];
+    dst[4] = a[3];
+    dst[3] = 0;
+    dst[2] = a[2];
+    dst[1] = a[1];
+    dst[0] = a[0];
+}
+
+/**
+ * Copies a padded mat3 into the packed layout
+ *
+ * @param {mat3} out the receiving matrix, may be a itself
+ * @param {mat3_aligned} a the source padded matrix
+ */
+GL_MATRIX_API void mat3_fromPadded(float* dst, float* a) {
+    dst[0] = a[0];
+    dst[1] = a[1];
+    dst[2] = a[2];
+    dst[3] = a[4];
+    dst[4] = a[5];
+    dst[5] = a[6];
+    dst[6] = a[8];
+    dst[7] = a[9];
+    dst[8] = a[10];
+}
+
+// The columns of the cofactor matrix of the 3x3 block whose columns start
+// 4 floats apart in a, a mat3_aligned or a mat4: a1 x a2, a2 x a0 and
+// a0 x a1. Returns the determinant.
+static float mat3_cofactorsPadded(float* dst, float* a) {
+    float a00 = a[0], a01 = a[1], a02 = a[2];
+    float a10 = a[4], a11 = a[5], a12 = a[6];
+    float a20 = a[8], a21 = a[9], a22 = a[10];
+
+    dst[0] = a11 * a22 - a12 * a21;
+    dst[1] = a12 * a20 - a10 * a22;
+    dst[2] = a10 * a21 - a11 * a20;
+    dst[3] = 0;
+    dst[4] = a21 * a02 - a22 * a01;
+    dst[5] = a22 * a00 - a20 * a02;
+    dst[6] = a20 * a01 - a21 * a00;
+    dst[7] = 0;
+    dst[8] = a01 * a12 - a02 * a11;
+    dst[9] = a02 * a10 - a00 * a12;
+    dst[10] = a00 * a11 - a01 * a10;
+    dst[11] = 0;
+    return a00 * dst[0] + a01 * dst[1] + a02 * dst[2];
+}
+
+static void mat3_multiplyPadded_scalar(float* dst, float* b) {
+    float a00 = dst[0], a01 = dst[1], a02 = dst[2];
+    float a10 = dst[4], a11 = dst[5], a12 = dst[6];
+    float a20 = dst[8], a21 = dst[9], a22 = dst[10];
+
+    float b00 = b[0], b01 = b[1], b02 = b[2];
+    float b10 = b[4], b11 = b[5], b12 = b[6];
+    float b20 = b[8], b21 = b[9], b22 = b[10];
+
+    dst[0] = b00 * a00 + b01 * a10 + b02 * a20;
+    dst[1] = b00 * a01 + b01 * a11 + b02 * a21;
+    dst[2] = b00 * a02 + b01 * a12 + b02 * a22;
+    dst[3] = 0;
+
+    dst[4] = b10 * a00 + b11 * a10 + b12 * a20;
+    dst[5] = b10 * a01 + b11 * a11 + b12 * a21;
+    dst[6] = b10 * a02 + b11 * a12 + b12 * a22;
+    dst[7] = 0;
+
+    dst[8] = b20 * a00 + b21 * a10 + b22 * a20;
+    dst[9] = b20 * a01 + b21 * a11 + b22 * a21;
+    dst[10] = b20 * a02 + b21 * a12 + b22 * a22;
+    dst[11] = 0;
+}
+
+static void mat3_transposePadded_scalar(float* dst) {
+    float a01 = dst[1], a02 = dst[2], a12 = dst[6];
+    dst[1] = dst[4];
+    dst[2] = dst[8];
+    dst[3] = 0;
+    dst[4] = a01;
+    dst[6] = dst[9];
+    dst[7] = 0;
+    dst[8] = a02;
+    dst[9] = a12;
+    dst[11] = 0;
+}
+
+static void mat3_invertPadded_scalar(float* dst) {
+    float c[12];
+    float det = mat3_cofactorsPadded(c, dst);
+
+    if (!det) {
+        return;
+    }
+    det = 1.0 / det;
+
+    // The inverse is the transposed cofactor matrix over the determinant
+    dst[0] = c[0] * det;
+    dst[1] = c[4] * det;
+    dst[2] = c[8] * det;
+    dst[3] = 0;
+    dst[4] = c[1] * det;
+    dst[5] = c[5] * det;
+    dst[6] = c[9] * det;
+    dst[7] = 0;
+    dst[8] = c[2] * det;
+    dst[9] = c[6] * det;
+    dst[10] = c[10] * det;
+    dst[11] = 0;
+}
+
+static void mat3_normalFromMat4Padded_scalar(float* dst, float* a) {
+    float c[12];
+    float det = mat3_cofactorsPadded(c, a);
+    uint8_t i;
+
+    if (!det) {
+        return;
+    }
+    det = 1.0 / det;
+
+    // The inverse transpose is the cofactor matrix over the determinant
+    for (i = 0; i < 12; i++) {
+        dst[i] = c[i] * det;
+    }
+}
+
+#if GL_MATRIX_SIMD
+// a x b in the x, y and z lanes, in the same order as the scalar code
+SIMD_SSE41 static SIMD_INLINE __m128 mat3_cross_sse41(__m128 a, __m128 b) {
+    __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 a_zxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+    __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 b_zxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+    return _mm_sub_ps(_mm_mul_ps(a_yzx, b_zxy), _mm_mul_ps(a_zxy, b_yzx));
+}
+
+// a.x * b.x + a.y * b.y + a.z * b.z, summed left to right like the scalar code
+SIMD_SSE41 static SIMD_INLINE float mat3_dot_sse41(__m128 a, __m128 b) {
+    __m128 p = _mm_mul_ps(a, b);
+    return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(p, _mm_shuffle_ps(p, p, 0x55)), _mm_movehl_ps(p, p)));
+}
+
+// The kernels below evaluate like the scalar code, so results are
+// bit-identical, and write 0 to the padding
+SIMD_SSE41 static void mat3_multiplyPadded_sse41(float* dst, float* b) {
+    __m128 a0 = _mm_load_ps(dst);
+    __m128 a1 = _mm_load_ps(dst + 4);
+    __m128 a2 = _mm_load_ps(dst + 8);
+    __m128 col[3] = { _mm_load_ps(b), _mm_load_ps(b + 4), _mm_load_ps(b + 8) };
+    uint8_t i;
+
+    for (i = 0; i < 3; i++) {
+        __m128 r = _mm_mul_ps(_mm_shuffle_ps(col[i], col[i], 0x00), a0);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(col[i], col[i], 0x55), a1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(col[i], col[i], 0xaa), a2));
+        _mm_store_ps(dst + i * 4, _mm_blend_ps(r, _mm_setzero_ps(), 0x8));
+    }
+}
+
+SIMD_SSE41 static void mat3_transposePadded_sse41(float* dst) {
+    __m128 c0 = _mm_load_ps(dst);
+    __m128 c1 = _mm_load_ps(dst + 4);
+    __m128 c2 = _mm_load_ps(dst + 8);
+    __m128 c3 = _mm_setzero_ps();
+
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_store_ps(dst, c0);
+    _mm_store_ps(dst + 4, c1);
+    _mm_store_ps(dst + 8, c2);
+}
+
+SIMD_SSE41 static void mat3_invertPadded_sse41(float* dst) {
+    __m128 a0 = _mm_load_ps(dst);
+    __m128 a1 = _mm_load_ps(dst + 4);
+    __m128 a2 = _mm_load_ps(dst + 8);
+    __m128 c0 = mat3_cross_sse41(a1, a2);
+    __m128 c1 = mat3_cross_sse41(a2, a0);
+    __m128 c2 = mat3_cross_sse41(a0, a1);
+    __m128 c3 = _mm_setzero_ps();
+    float det = mat3_dot_sse41(a0, c0);
+
+    if (!det) {
+        return;
+    }
+    __m128 inv = _mm_set1_ps(1.0f / det);
+
+    // The padding lanes of the cofactors end up in c3, which is dropped
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_store_ps(dst, _mm_mul_ps(c0, inv));
+    _mm_store_ps(dst + 4, _mm_mul_ps(c1, inv));
+    _mm_store_ps(dst + 8, _mm_mul_ps(c2, inv));
+}
+
+SIMD_SSE41 static void mat3_normalFromMat4Padded_sse41(float* dst, float* a) {
+    __m128 a0 = _mm_loadu_ps(a);
+    __m128 a1 = _mm_loadu_ps(a + 4);
+    __m128 a2 = _mm_loadu_ps(a + 8);
+    __m128 c0 = mat3_cross_sse41(a1, a2);
+    __m128 c1 = mat3_cross_sse41(a2, a0);
+    __m128 c2 = mat3_cross_sse41(a0, a1);
+    float det = mat3_dot_sse41(a0, c0);
+
+    if (!det) {
+        return;
+    }
+    __m128 inv = _mm_set1_ps(1.0f / det);
+
+    _mm_store_ps(dst, _mm_blend_ps(_mm_mul_ps(c0, inv), _mm_setzero_ps(), 0x8));
+    _mm_store_ps(dst + 4, _mm_blend_ps(_mm_mul_ps(c1, inv), _mm_setzero_ps(), 0x8));
+    _mm_store_ps(dst + 8, _mm_blend_ps(_mm_mul_ps(c2, inv), _mm_setzero_ps(), 0x8));
+}
+
+// Eight matrices at a time, element k of all of them in one register, with
+// the same evaluation order as the scalar code and no FMA
+SIMD_AVX2_NOFMA static size_t mat3_normalFromMat4Padded_n_avx2(float* dst, float* a, size_t n) {
+    __m256 zero = _mm256_setzero_ps();
+    size_t i;
+    uint8_t j;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        float* p = a + i * 16;
+        float* q = dst + i * 12;
+        __m256 m[16], r[16];
+
+        for (j = 0; j < 8; j++) {
+            m[j] = _mm256_loadu_ps(p + j * 16);
+            m[j + 8] = _mm256_loadu_ps(p + j * 16 + 8);
+        }
+        simd_transpose8_ps(m);
+        simd_transpose8_ps(m + 8);
+
+        r[0] = _mm256_sub_ps(_mm256_mul_ps(m[5], m[10]), _mm256_mul_ps(m[6], m[9]));
+        r[1] = _mm256_sub_ps(_mm256_mul_ps(m[6], m[8]), _mm256_mul_ps(m[4], m[10]));
+        r[2] = _mm256_sub_ps(_mm256_mul_ps(m[4], m[9]), _mm256_mul_ps(m[5], m[8]));
+        r[4] = _mm256_sub_ps(_mm256_mul_ps(m[9], m[2]), _mm256_mul_ps(m[10], m[1]));
+        r[5] = _mm256_sub_ps(_mm256_mul_ps(m[10], m[0]), _mm256_mul_ps(m[8], m[2]));
+        r[6] = _mm256_sub_ps(_mm256_mul_ps(m[8], m[1]), _mm256_mul_ps(m[9], m[0]));
+        r[8] = _mm256_sub_ps(_mm256_mul_ps(m[1], m[6]), _mm256_mul_ps(m[2], m[5]));
+        r[9] = _mm256_sub_ps(_mm256_mul_ps(m[2], m[4]), _mm256_mul_ps(m[0], m[6]));
+        r[10] = _mm256_sub_ps(_mm256_mul_ps(m[0], m[5]), _mm256_mul_ps(m[1], m[4]));
+
+        __m256 det = _mm256_add_ps(_mm256_mul_ps(m[0], r[0]), _mm256_mul_ps(m[1], r[1]));
+        det = _mm256_add_ps(det, _mm256_mul_ps(m[2], r[2]));
+
+        // Singular matrices leave their result unchanged, which the scalar
+        // code handles
+        if (_mm256_movemask_ps(_mm256_cmp_ps(det, zero, _CMP_EQ_OQ))) {
+            for (j = 0; j < 8; j++) {
+                mat3_normalFromMat4Padded_scalar(q + j * 12, p + j * 16);
+            }
+            continue;
+        }
+
+        __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+        for (j = 0; j < 12; j++) {
+            r[j] = (j & 3) == 3 ? zero : _mm256_mul_ps(r[j], inv);
+        }
+        for (j = 12; j < 16; j++) {
+            r[j] = zero;
+        }
+
+        // Back to one matrix per register: its first 8 floats in r[j], the
+        // last 4 in the low half of r[j + 8]
+        simd_transpose8_ps(r);
+        simd_transpose8_ps(r + 8);
+        for (j = 0; j < 8; j++) {
+            _mm256_storeu_ps(q + j * 12, r[j]);
+            _mm_store_ps(q + j * 12 + 8, _mm256_castps256_ps128(r[j + 8]));
+        }
+    }
+    return i;
+}
+#endif
+
+static uint8_t mat3_use_sse41 = 0;
+static uint8_t mat3_use_avx2 = 0;
+
+__attribute__((constructor))
+static void mat3_dispatch(void) {
+    uint32_t features = cpu_features();
+    mat3_use_sse41 = (features & CPU_SSE41) != 0;
+    mat3_use_avx2 = (features & CPU_AVX2) != 0;
+}
+
+/**
+ * Multiplies two padded mat3s
+ *
+ * @param {mat3_aligned} out the receiving matrix
+ * @param {mat3_aligned} b the second operand
+ */
+GL_MATRIX_API void mat3_multiply_padded(float* dst, float* b) {
+    SIMD_ASSERT_ALIGNED(dst, MAT3_ALIGNMENT);
+    SIMD_ASSERT_ALIGNED(b, MAT3_ALIGNMENT);
+#if GL_MATRIX_SIMD
+    if (mat3_use_sse41) {
+        mat3_multiplyPadded_sse41(dst, b);
+        return;
+    }
+#endif
+    mat3_multiplyPadded_scalar(dst, b);
+}
+
+/**
+ * Transposes a padded mat3
+ *
+ * @param {mat3_aligned} out the receiving matrix
+ */
+GL_MATRIX_API void mat3_transpose_padded(float* dst) {
+    SIMD_ASSERT_ALIGNED(dst, MAT3_ALIGNMENT);
+#if GL_MATRIX_SIMD
+    if (mat3_use_sse41) {
+        mat3_transposePadded_sse41(dst);
+        return;
+    }
+#endif
+    mat3_transposePadded_scalar(dst);
+}
+
+/**
+ * Inverts a padded mat3
+ *
+ * @param {mat3_aligned} out the receiving matrix
+ */
+GL_MATRIX_API void mat3_invert_padded(float* dst) {
+    SIMD_ASSERT_ALIGNED(dst, MAT3_ALIGNMENT);
+#if GL_MATRIX_SIMD
+    if (mat3_use_sse41) {
+        mat3_invertPadded_sse41(dst);
+        return;
+    }
+#endif
+    mat3_invertPadded_scalar(dst);
+}
+
+/**
+ * Calculates the padded normal matrix of the upper-left 3x3 of a mat4
+ *
+ * @param {mat3_aligned} out the receiving matrix
+ * @param {mat4} a the source matrix
+ */
+GL_MATRIX_API void mat3_normalFromMat4_padded(float* dst, float* a) {
+    SIMD_ASSERT_ALIGNED(dst, MAT3_ALIGNMENT);
+#if GL_MATRIX_SIMD
+    if (mat3_use_sse41) {
+        mat3_normalFromMat4Padded_sse41(dst, a);
+        return;
+    }
+#endif
+    mat3_normalFromMat4Padded_scalar(dst, a);
+}
+
+/**
+ * Calculates the padded normal matrices of an array of mat4s
+ *
+ * @param {mat3_aligned[]} out array of n receiving matrices, 12 floats apart
+ * @param {mat4[]} a array of n source matrices, 16 floats apart
+ * @param {Number} n number of matrices
+ */
+GL_MATRIX_API void mat3_normalFromMat4_padded_n(float* dst, float* a, size_t n) {
+    size_t i = 0;
+
+    SIMD_ASSERT_ALIGNED(dst, MAT3_ALIGNMENT);
+#if GL_MATRIX_SIMD
+    if (mat3_use_avx2) {
+        i = mat3_normalFromMat4Padded_n_avx2(dst, a, n);
+    }
+#endif
+    for (; i < n; i++) {
+        mat3_normalFromMat4_padded(dst + i * 12, a + i * 16);
+    }
+}
+// End float only
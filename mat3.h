@@ -1,7 +1,24 @@
 #ifndef MAT3_H
 #define MAT3_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include "api.h"
+
+// Float only
+/**
+ * Alignment in bytes of a padded mat3, one SSE register per column.
+ */
+#define MAT3_ALIGNMENT (4 * sizeof(float))
+
+/**
+ * A mat3 padded to three columns of 4 floats, with MAT3_ALIGNMENT, so each
+ * column loads into one register. The fourth float of each column is
+ * padding, which the _padded functions write as 0. This is not the packed
+ * 9 float layout the other mat3 functions take; see mat3_toPadded.
+ */
+typedef float mat3_aligned[12] GL_MATRIX_ALIGNED(MAT3_ALIGNMENT);
+// End float only
 
 /**
  * Copies the upper-left 3x3 values into the given mat3.
@@ -9,7 +26,7 @@
  * @param {mat3} out the receiving 3x3 matrix
  * @param {mat4} a   the source 4x4 matrix
  */
-void mat3_fromMat4(float* dst, float* a);
+GL_MATRIX_API void mat3_fromMat4(float* dst, float* a);
 
 /**
  * Copy the values from one mat3 to another
@@ -17,7 +34,7 @@ void mat3_fromMat4(float* dst, float* a);
  * @param {mat3} out the receiving matrix
  * @param {mat3} a the source matrix
  */
-void mat3_copy(float* dst, float* a);
+GL_MATRIX_API void mat3_copy(float* dst, float* a);
 
 /**
  * Set the components of a mat3 to the given values
@@ -33,21 +50,21 @@ void mat3_copy(float* dst, float* a);
  * @param {Number} m21 Component in column 2, row 1 position (index 7)
  * @param {Number} m22 Component in column 2, row 2 position (index 8)
  */
-void mat3_set(float* dst, float m00, float m01, float m02, float m10, float m11, float m12, float m20, float m21, float m22);
+GL_MATRIX_API void mat3_set(float* dst, float m00, float m01, float m02, float m10, float m11, float m12, float m20, float m21, float m22);
 
 /**
  * Set a mat3 to the identity matrix
  *
  * @param {mat3} out the receiving matrix
  */
-void mat3_identity(float* dst);
+GL_MATRIX_API void mat3_identity(float* dst);
 
 /**
  * Transpose the values of a mat3
  *
  * @param {mat3} out the receiving matrix
  */
-void mat3_transpose(float* dst);
+GL_MATRIX_API void mat3_transpose(float* dst);
 
 /**
  * Inverts a mat3
@@ -55,14 +72,14 @@ void mat3_transpose(float* dst);
  * @param {mat3} out the receiving matrix
  * @returns {mat3} out
  */
-void mat3_invert(float* dst);
+GL_MATRIX_API void mat3_invert(float* dst);
 
 /**
  * Calculates the adjugate of a mat3
  *
  * @param {mat3} out the receiving matrix
  */
-void mat3_adjoint(float* dst);
+GL_MATRIX_API void mat3_adjoint(float* dst);
 
 /**
  * Calculates the determinant of a mat3
@@ -70,7 +87,7 @@ void mat3_adjoint(float* dst);
  * @param {mat3} a the source matrix
  * @returns {Number} determinant of a
  */
-float mat3_determinant(float* dst);
+GL_MATRIX_API float mat3_determinant(float* dst);
 
 /**
  * Multiplies two mat3's
@@ -78,7 +95,7 @@ float mat3_determinant(float* dst);
  * @param {mat3} out the receiving matrix
  * @param {mat3} b the second operand
  */
-void mat3_multiply(float* dst, float* b);
+GL_MATRIX_API void mat3_multiply(float* dst, float* b);
 
 /**
  * Translate a mat3 by the given vector
@@ -86,7 +103,7 @@ void mat3_multiply(float* dst, float* b);
  * @param {mat3} out the receiving matrix
  * @param {vec2} v vector to translate by
  */
-void mat3_translate(float* dst, float* v);
+GL_MATRIX_API void mat3_translate(float* dst, float* v);
 
 /**
  * Rotates a mat3 by the given angle
@@ -94,7 +111,7 @@ void mat3_translate(float* dst, float* v);
  * @param {mat3} out the receiving matrix
  * @param {Number} rad the angle to rotate the matrix by
  */
-void mat3_rotate(float* dst, float rad);
+GL_MATRIX_API void mat3_rotate(float* dst, float rad);
 
 /**
  * Scales the mat3 by the dimensions in the given vec2
@@ -102,7 +119,7 @@ void mat3_rotate(float* dst, float rad);
  * @param {mat3} out the receiving matrix
  * @param {vec2} v the vec2 to scale the matrix by
  **/
-void mat3_scale(float* dst, float* v);
+GL_MATRIX_API void mat3_scale(float* dst, float* v);
 
 /**
  * Creates a matrix from a vector translation
@@ -114,7 +131,7 @@ void mat3_scale(float* dst, float* v);
  * @param {mat3} out mat3 receiving operation result
  * @param {vec2} v Translation vector
  */
-void mat3_fromTranslation(float* dst, float* v);
+GL_MATRIX_API void mat3_fromTranslation(float* dst, float* v);
 
 /**
  * Creates a matrix from a given angle
@@ -127,7 +144,7 @@ void mat3_fromTranslation(float* dst, float* v);
  * @param {Number} rad the angle to rotate the matrix by
  * @returns {mat3} out
  */
-void mat3_fromRotation(float* dst, float rad);
+GL_MATRIX_API void mat3_fromRotation(float* dst, float rad);
 
 /**
  * Creates a matrix from a vector scaling
@@ -139,7 +156,7 @@ void mat3_fromRotation(float* dst, float rad);
  * @param {mat3} out mat3 receiving operation result
  * @param {vec2} v Scaling vector
  */
-void mat3_fromScaling(float* dst, float* v);
+GL_MATRIX_API void mat3_fromScaling(float* dst, float* v);
 
 /**
  * Copies the values from a mat2d into a mat3
@@ -147,7 +164,7 @@ void mat3_fromScaling(float* dst, float* v);
  * @param {mat3} out the receiving matrix
  * @param {mat2d} a the matrix to copy
  **/
-void mat3_fromMat2d(float* dst, float* a);
+GL_MATRIX_API void mat3_fromMat2d(float* dst, float* a);
 
 /**
 * Calculates a 3x3 matrix from the given quaternion
@@ -155,7 +172,7 @@ void mat3_fromMat2d(float* dst, float* a);
 * @param {mat3} out mat3 receiving operation result
 * @param {quat} q Quaternion to create matrix from
 */
-void mat3_fromQuat(float* dst, float* q);
+GL_MATRIX_API void mat3_fromQuat(float* dst, float* q);
 
 /**
 * Calculates a 3x3 normal matrix (transpose inverse) from the 4x4 matrix
@@ -163,7 +180,7 @@ void mat3_fromQuat(float* dst, float* q);
 * @param {mat3} out mat3 receiving operation result
 * @param {mat4} a Mat4 to derive the normal matrix from
 */
-void mat3_normalFromMat4(float* dst, float* a);
+GL_MATRIX_API void mat3_normalFromMat4(float* dst, float* a);
 
 /**
  * Generates a 2D projection matrix with the given bounds
@@ -172,7 +189,7 @@ void mat3_normalFromMat4(float* dst, float* a);
  * @param {number} width Width of your gl context
  * @param {number} height Height of gl context
  */
-void mat3_projection(float* dst, float width, float height);
+GL_MATRIX_API void mat3_projection(float* dst, float width, float height);
 
 /**
  * Returns Frobenius norm of a mat3
@@ -180,7 +197,7 @@ void mat3_projection(float* dst, float width, float height);
  * @param {mat3} a the matrix to calculate Frobenius norm of
  * @returns {Number} Frobenius norm
  */
-float mat3_frob(float* a);
+GL_MATRIX_API float mat3_frob(float* a);
 
 /**
  * Adds two mat3's
@@ -188,7 +205,7 @@ float mat3_frob(float* a);
  * @param {mat3} out the receiving matrix
  * @param {mat3} b the second operand
  */
-void mat3_add(float* dst, float* b);
+GL_MATRIX_API void mat3_add(float* dst, float* b);
 
 /**
  * Subtracts matrix b from matrix a
@@ -196,7 +213,7 @@ void mat3_add(float* dst, float* b);
  * @param {mat3} out the receiving matrix
  * @param {mat3} b the second operand
  */
-void mat3_subtract(float* dst, float* b);
+GL_MATRIX_API void mat3_subtract(float* dst, float* b);
 
 /**
  * Multiply each element of the matrix by a scalar.
@@ -204,7 +221,7 @@ void mat3_subtract(float* dst, float* b);
  * @param {mat3} out the receiving matrix
  * @param {Number} b amount to scale the matrix's elements by
  */
-void mat3_multiplyScalar(float* dst, float b);
+GL_MATRIX_API void mat3_multiplyScalar(float* dst, float b);
 
 /**
  * Adds two mat3's after multiplying each element of the second operand by a scalar value.
@@ -213,7 +230,7 @@ void mat3_multiplyScalar(float* dst, float b);
  * @param {mat3} b the second operand
  * @param {Number} scale the amount to scale b's elements by before adding
  */
-void mat3_multiplyScalarAndAdd(float* dst, float* b, float scale);
+GL_MATRIX_API void mat3_multiplyScalarAndAdd(float* dst, float* b, float scale);
 
 /**
  * Returns whether or not the matrices have exactly the same elements.
@@ -222,6 +239,79 @@ void mat3_multiplyScalarAndAdd(float* dst, float* b, float scale);
  * @param {mat3} b The second matrix.
  * @returns {uint8_t} 1 if the matrices are equal, 0 otherwise.
  */
-uint8_t mat3_equals(float* a, float* b);
+GL_MATRIX_API uint8_t mat3_equals(float* a, float* b);
+
+// Float only
+/**
+ * Copies a mat3 into the padded layout, with 0 padding.
+ *
+ * @param {mat3_aligned} out the receiving padded matrix, may be a itself if it has room for 12 floats
+ * @param {mat3} a the source matrix
+ */
+GL_MATRIX_API void mat3_toPadded(float* dst, float* a);
+
+/**
+ * Copies a padded mat3 into the packed layout.
+ *
+ * @param {mat3} out the receiving matrix, may be a itself
+ * @param {mat3_aligned} a the source padded matrix
+ */
+GL_MATRIX_API void mat3_fromPadded(float* dst, float* a);
+
+/**
+ * Multiplies two padded mat3's. Same result as mat3_multiply.
+ *
+ * @param {mat3_aligned} out the receiving matrix and first operand
+ * @param {mat3_aligned} b the second operand
+ */
+GL_MATRIX_API void mat3_multiply_padded(float* dst, float* b);
+
+/**
+ * Transposes a padded mat3.
+ *
+ * @param {mat3_aligned} out the matrix to transpose
+ */
+GL_MATRIX_API void mat3_transpose_padded(float* dst);
+
+/**
+ * Inverts a padded mat3, leaving it unchanged if it is singular. Same
+ * result as mat3_invert.
+ *
+ * @param {mat3_aligned} out the matrix to invert
+ */
+GL_MATRIX_API void mat3_invert_padded(float* dst);
+
+/**
+ * Calculates the inverse transpose of the upper-left 3x3 of a mat4 into a
+ * padded mat3, leaving it unchanged if that is singular. For affine
+ * matrices this is mat3_normalFromMat4 up to rounding; the bottom row of a
+ * is ignored.
+ *
+ * @param {mat3_aligned} out the receiving matrix
+ * @param {mat4} a the source matrix, need not be aligned
+ */
+GL_MATRIX_API void mat3_normalFromMat4_padded(float* dst, float* a);
+
+/**
+ * mat3_normalFromMat4_padded over arrays, eight matrices at a time with AVX2.
+ *
+ * @param {mat3_aligned[]} out n receiving matrices, 12 floats apart
+ * @param {mat4[]} a n source matrices, 16 floats apart
+ * @param {Number} n number of matrices
+ */
+GL_MATRIX_API void mat3_normalFromMat4_padded_n(float* dst, float* a, size_t n);
+// End float only
+
+/*
+ * Initializers for constant matrices, with the same elements as the
+ * functions of the same name. See MAT4_IDENTITY.
+ */
+#define MAT3_IDENTITY { 1, 0, 0, 0, 1, 0, 0, 0, 1 }
+
+#define MAT3_FROM_TRANSLATION(x, y) { 1, 0, 0, 0, 1, 0, (float)(x), (float)(y), 1 }
+
+#define MAT3_FROM_SCALING(x, y) { (float)(x), 0, 0, 0, (float)(y), 0, 0, 0, 1 }
+
+#define MAT3_PROJECTION(width, height) { 2 / (float)(width), 0, 0, 0, -2 / (float)(height), 0, -1, 1, 1 }
 
 #endif
@@ -1,10 +1,12 @@
-#include "mat2.h"
+#include "mat4.h"
+#include "cpu.h"
+#include "simd.h"
 #include "epsilon.h"
 #include <math.h>
 #include <float.h>
 #include <stdio.h>
 
-void mat4_dump(float dst[16]) {
+GL_MATRIX_API void mat4_dump(float dst[16]) {
     if (!dst) {
         fprintf(stderr, "mat4_dump(): undefined matrix\n");
         return;
@@ -19,7 +21,7 @@ void mat4_dump(float dst[16]) {
     fprintf(stderr, "\n");
 }
 
-void mat4_identity(float dst[16]) {
+GL_MATRIX_API void mat4_identity(float dst[16]) {
     dst[0] = 1;
     dst[1] = 0;
     dst[2] = 0;
@@ -38,7 +40,7 @@ void mat4_identity(float dst[16]) {
     dst[15] = 1;
 }
 
-void mat4_copy(float* dst, float* src) {
+GL_MATRIX_API void mat4_copy(float* dst, float* src) {
     dst[0] = src[0];
     dst[1] = src[1];
     dst[2] = src[2];
@@ -57,7 +59,7 @@ void mat4_copy(float* dst, float* src) {
     dst[15] = src[15];
 }
 
-void mat4_set(float* dst, float m00, float m01, float m02, float m03, float m10, float m11, float m12, float m13, float m20, float m21, float m22, float m23, float m30, float m31, float m32, float m33) {
+GL_MATRIX_API void mat4_set(float* dst, float m00, float m01, float m02, float m03, float m10, float m11, float m12, float m13, float m20, float m21, float m22, float m23, float m30, float m31, float m32, float m33) {
     dst[0] = m00;
     dst[1] = m01;
     dst[2] = m02;
@@ -76,7 +78,7 @@ void mat4_set(float* dst, float m00, float m01, float m02, float m03, float m10,
     dst[15] = m33;
 }
 
-void mat4_transpose(float* dst) {
+GL_MATRIX_API void mat4_transpose(float* dst) {
     float a01 = dst[1], a02 = dst[2], a03 = dst[3];
     float a12 = dst[6], a13 = dst[7];
     float a23 = dst[11];
@@ -95,7 +97,7 @@ void mat4_transpose(float* dst) {
     dst[14] = a23;
 }
 
-void mat4_invert(float* dst) {
+GL_MATRIX_API SIMD_CLONES uint8_t mat4_invert(float* dst) {
     float a00 = dst[0], a01 = dst[1], a02 = dst[2], a03 = dst[3];
     float a10 = dst[4], a11 = dst[5], a12 = dst[6], a13 = dst[7];
     float a20 = dst[8], a21 = dst[9], a22 = dst[10], a23 = dst[11];
@@ -117,7 +119,7 @@ void mat4_invert(float* dst) {
     float det = (b00 * b11) - (b01 * b10) + (b02 * b09) + (b03 * b08) - (b04 * b07) + (b05 * b06);
 
     if (!det) {
-        return;
+        return 0;
     }
     det = 1.0 / det;
 
@@ -137,9 +139,59 @@ void mat4_invert(float* dst) {
     dst[13] = (a00 * b09 - a01 * b07 + a02 * b06) * det;
     dst[14] = (a31 * b01 - a30 * b03 - a32 * b00) * det;
     dst[15] = (a20 * b03 - a21 * b01 + a22 * b00) * det;
+    return 1;
 }
 
-void mat4_adjoint(float* dst) {
+GL_MATRIX_API SIMD_CLONES uint8_t mat4_invertAffine(float* dst) {
+    float a00 = dst[0], a01 = dst[1], a02 = dst[2];
+    float a10 = dst[4], a11 = dst[5], a12 = dst[6];
+    float a20 = dst[8], a21 = dst[9], a22 = dst[10];
+    float tx = dst[12], ty = dst[13], tz = dst[14];
+
+    float b01 = a22 * a11 - a12 * a21;
+    float b11 = -a22 * a10 + a12 * a20;
+    float b21 = a21 * a10 - a11 * a20;
+
+    float det = a00 * b01 + a01 * b11 + a02 * b21;
+
+    if (!det) {
+        return 0;
+    }
+    det = 1.0 / det;
+
+    dst[0] = b01 * det;
+    dst[1] = (-a22 * a01 + a02 * a21) * det;
+    dst[2] = (a12 * a01 - a02 * a11) * det;
+    dst[4] = b11 * det;
+    dst[5] = (a22 * a00 - a02 * a20) * det;
+    dst[6] = (-a12 * a00 + a02 * a10) * det;
+    dst[8] = b21 * det;
+    dst[9] = (-a21 * a00 + a01 * a20) * det;
+    dst[10] = (a11 * a00 - a01 * a10) * det;
+
+    dst[12] = -(dst[0] * tx + dst[4] * ty + dst[8] * tz);
+    dst[13] = -(dst[1] * tx + dst[5] * ty + dst[9] * tz);
+    dst[14] = -(dst[2] * tx + dst[6] * ty + dst[10] * tz);
+    return 1;
+}
+
+GL_MATRIX_API void mat4_invertRigid(float* dst) {
+    float a01 = dst[1], a02 = dst[2], a12 = dst[6];
+    float tx = dst[12], ty = dst[13], tz = dst[14];
+
+    dst[1] = dst[4];
+    dst[2] = dst[8];
+    dst[4] = a01;
+    dst[6] = dst[9];
+    dst[8] = a02;
+    dst[9] = a12;
+
+    dst[12] = -(dst[0] * tx + dst[4] * ty + dst[8] * tz);
+    dst[13] = -(dst[1] * tx + dst[5] * ty + dst[9] * tz);
+    dst[14] = -(dst[2] * tx + dst[6] * ty + dst[10] * tz);
+}
+
+GL_MATRIX_API SIMD_CLONES void mat4_adjoint(float* dst) {
     float a00 = dst[0], a01 = dst[1], a02 = dst[2], a03 = dst[3];
     float a10 = dst[4], a11 = dst[5], a12 = dst[6], a13 = dst[7];
     float a20 = dst[8], a21 = dst[9], a22 = dst[10], a23 = dst[11];
@@ -163,7 +215,7 @@ void mat4_adjoint(float* dst) {
     dst[15] =  (a00 * (a11 * a22 - a12 * a21) - a10 * (a01 * a22 - a02 * a21) + a20 * (a01 * a12 - a02 * a11));
 }
 
-float mat4_determinant(float* dst) {
+GL_MATRIX_API SIMD_CLONES float mat4_determinant(float* dst) {
     float a00 = dst[0], a01 = dst[1], a02 = dst[2], a03 = dst[3];
     float a10 = dst[4], a11 = dst[5], a12 = dst[6], a13 = dst[7];
     float a20 = dst[8], a21 = dst[9], a22 = dst[10], a23 = dst[11];
@@ -185,7 +237,7 @@ float mat4_determinant(float* dst) {
     return b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
 }
 
-void mat4_multiply(float* dst, float* b) {
+static void mat4_multiply_scalar(float* dst, float* b) {
     float a00 = dst[0], a01 = dst[1], a02 = dst[2], a03 = dst[3];
     float a10 = dst[4], a11 = dst[5], a12 = dst[6], a13 = dst[7];
     float a20 = dst[8], a21 = dst[9], a22 = dst[10], a23 = dst[11];
@@ -217,7 +269,449 @@ void mat4_multiply(float* dst, float* b) {
     dst[15] = b0*a03 + b1*a13 + b2*a23 + b3*a33;
 }
 
-void mat4_translate(float dst[16], float v[3]) {
+static void mat4_multiply_n_scalar(float* dst, float* b, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        mat4_multiply_scalar(dst + i * 16, b);
+    }
+}
+
+static void mat4_multiplyPairwise_n_scalar(float* dst, float* b, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        mat4_multiply_scalar(dst + i * 16, b + i * 16);
+    }
+}
+
+static size_t mat4_invert_n_scalar(float* dst, uint8_t* ok, size_t n) {
+    size_t i, inverted = 0;
+    for (i = 0; i < n; i++) {
+        uint8_t r = mat4_invert(dst + i * 16);
+        if (ok) {
+            ok[i] = r;
+        }
+        inverted += r;
+    }
+    return inverted;
+}
+
+#if GL_MATRIX_SIMD
+SIMD_SSE41 static SIMD_INLINE void mat4_multiply_sse41(float* dst, float* b, uint8_t aligned) {
+    __m128 a0 = simd_load_ps(dst, aligned);
+    __m128 a1 = simd_load_ps(dst + 4, aligned);
+    __m128 a2 = simd_load_ps(dst + 8, aligned);
+    __m128 a3 = simd_load_ps(dst + 12, aligned);
+    __m128 b0 = simd_load_ps(b, aligned);
+    __m128 b1 = simd_load_ps(b + 4, aligned);
+    __m128 b2 = simd_load_ps(b + 8, aligned);
+    __m128 b3 = simd_load_ps(b + 12, aligned);
+    __m128 col[4] = { b0, b1, b2, b3 };
+    uint8_t i;
+
+    // Same evaluation order as the scalar path, so results are bit-identical
+    for (i = 0; i < 4; i++) {
+        __m128 r = _mm_mul_ps(_mm_shuffle_ps(col[i], col[i], 0x00), a0);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(col[i], col[i], 0x55), a1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(col[i], col[i], 0xaa), a2));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(col[i], col[i], 0xff), a3));
+        simd_store_ps(dst + i * 4, r, aligned);
+    }
+}
+
+SIMD_AVX2 static SIMD_INLINE void mat4_multiply_avx2(float* dst, float* b, uint8_t aligned) {
+    // Both 128-bit lanes hold the same column of dst
+    __m128 c0 = simd_load_ps(dst, aligned);
+    __m128 c1 = simd_load_ps(dst + 4, aligned);
+    __m128 c2 = simd_load_ps(dst + 8, aligned);
+    __m128 c3 = simd_load_ps(dst + 12, aligned);
+    __m256 a0 = _mm256_insertf128_ps(_mm256_castps128_ps256(c0), c0, 1);
+    __m256 a1 = _mm256_insertf128_ps(_mm256_castps128_ps256(c1), c1, 1);
+    __m256 a2 = _mm256_insertf128_ps(_mm256_castps128_ps256(c2), c2, 1);
+    __m256 a3 = _mm256_insertf128_ps(_mm256_castps128_ps256(c3), c3, 1);
+
+    // Two columns of b per register
+    __m256 b01 = simd_load8_ps(b, aligned);
+    __m256 b23 = simd_load8_ps(b + 8, aligned);
+
+    __m256 r01 = _mm256_mul_ps(_mm256_permute_ps(b01, 0x00), a0);
+    __m256 r23 = _mm256_mul_ps(_mm256_permute_ps(b23, 0x00), a0);
+    r01 = _mm256_fmadd_ps(_mm256_permute_ps(b01, 0x55), a1, r01);
+    r23 = _mm256_fmadd_ps(_mm256_permute_ps(b23, 0x55), a1, r23);
+    r01 = _mm256_fmadd_ps(_mm256_permute_ps(b01, 0xaa), a2, r01);
+    r23 = _mm256_fmadd_ps(_mm256_permute_ps(b23, 0xaa), a2, r23);
+    r01 = _mm256_fmadd_ps(_mm256_permute_ps(b01, 0xff), a3, r01);
+    r23 = _mm256_fmadd_ps(_mm256_permute_ps(b23, 0xff), a3, r23);
+
+    simd_store8_ps(dst, r01, aligned);
+    simd_store8_ps(dst + 8, r23, aligned);
+}
+
+SIMD_SSE41 static SIMD_INLINE void mat4_multiply_n_sse41(float* dst, float* b, size_t n, uint8_t aligned) {
+    __m128 s[16];
+    size_t i;
+    uint8_t j;
+
+    // Splat every element of the shared matrix once for the whole batch
+    for (j = 0; j < 16; j++) {
+        s[j] = _mm_set1_ps(b[j]);
+    }
+
+    // Two matrices per iteration to keep both multiply chains busy
+    for (i = 0; i + 2 <= n; i += 2) {
+        float* p = dst + i * 16;
+        float* q = p + 16;
+        __m128 p0 = simd_load_ps(p, aligned), p1 = simd_load_ps(p + 4, aligned), p2 = simd_load_ps(p + 8, aligned), p3 = simd_load_ps(p + 12, aligned);
+        __m128 q0 = simd_load_ps(q, aligned), q1 = simd_load_ps(q + 4, aligned), q2 = simd_load_ps(q + 8, aligned), q3 = simd_load_ps(q + 12, aligned);
+
+        for (j = 0; j < 16; j += 4) {
+            __m128 rp = _mm_mul_ps(s[j], p0);
+            __m128 rq = _mm_mul_ps(s[j], q0);
+            rp = _mm_add_ps(rp, _mm_mul_ps(s[j + 1], p1));
+            rq = _mm_add_ps(rq, _mm_mul_ps(s[j + 1], q1));
+            rp = _mm_add_ps(rp, _mm_mul_ps(s[j + 2], p2));
+            rq = _mm_add_ps(rq, _mm_mul_ps(s[j + 2], q2));
+            rp = _mm_add_ps(rp, _mm_mul_ps(s[j + 3], p3));
+            rq = _mm_add_ps(rq, _mm_mul_ps(s[j + 3], q3));
+            simd_store_ps(p + j, rp, aligned);
+            simd_store_ps(q + j, rq, aligned);
+        }
+    }
+    if (i < n) {
+        mat4_multiply_sse41(dst + i * 16, b, aligned);
+    }
+}
+
+SIMD_SSE41 static void mat4_multiplyPairwise_n_sse41(float* dst, float* b, size_t n) {
+    size_t i;
+    uint8_t j;
+
+    // Two pairs per iteration, as in mat4_multiply_n_sse41
+    for (i = 0; i + 2 <= n; i += 2) {
+        float* p = dst + i * 16;
+        float* q = p + 16;
+        float* bp = b + i * 16;
+        float* bq = bp + 16;
+        __m128 p0 = _mm_loadu_ps(p), p1 = _mm_loadu_ps(p + 4), p2 = _mm_loadu_ps(p + 8), p3 = _mm_loadu_ps(p + 12);
+        __m128 q0 = _mm_loadu_ps(q), q1 = _mm_loadu_ps(q + 4), q2 = _mm_loadu_ps(q + 8), q3 = _mm_loadu_ps(q + 12);
+
+        for (j = 0; j < 16; j += 4) {
+            __m128 cp = _mm_loadu_ps(bp + j);
+            __m128 cq = _mm_loadu_ps(bq + j);
+            __m128 rp = _mm_mul_ps(_mm_shuffle_ps(cp, cp, 0x00), p0);
+            __m128 rq = _mm_mul_ps(_mm_shuffle_ps(cq, cq, 0x00), q0);
+            rp = _mm_add_ps(rp, _mm_mul_ps(_mm_shuffle_ps(cp, cp, 0x55), p1));
+            rq = _mm_add_ps(rq, _mm_mul_ps(_mm_shuffle_ps(cq, cq, 0x55), q1));
+            rp = _mm_add_ps(rp, _mm_mul_ps(_mm_shuffle_ps(cp, cp, 0xaa), p2));
+            rq = _mm_add_ps(rq, _mm_mul_ps(_mm_shuffle_ps(cq, cq, 0xaa), q2));
+            rp = _mm_add_ps(rp, _mm_mul_ps(_mm_shuffle_ps(cp, cp, 0xff), p3));
+            rq = _mm_add_ps(rq, _mm_mul_ps(_mm_shuffle_ps(cq, cq, 0xff), q3));
+            _mm_storeu_ps(p + j, rp);
+            _mm_storeu_ps(q + j, rq);
+        }
+    }
+    if (i < n) {
+        mat4_multiply_sse41(dst + i * 16, b + i * 16, 0);
+    }
+}
+
+// Both 128-bit lanes of a[k] hold column k of the mat4 at p
+SIMD_AVX2 static SIMD_INLINE void mat4_broadcast_avx2(__m256* a, float* p, uint8_t aligned) {
+    uint8_t k;
+    for (k = 0; k < 4; k++) {
+        __m128 c = simd_load_ps(p + k * 4, aligned);
+        a[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(c), c, 1);
+    }
+}
+
+SIMD_AVX2 static SIMD_INLINE void mat4_multiply_n_avx2(float* dst, float* b, size_t n, uint8_t aligned) {
+    __m256 b01 = simd_load8_ps(b, aligned);
+    __m256 b23 = simd_load8_ps(b + 8, aligned);
+    __m256 s01[4], s23[4];
+    size_t i;
+
+    // Splat the shared matrix once, two columns per register
+    s01[0] = _mm256_permute_ps(b01, 0x00);
+    s01[1] = _mm256_permute_ps(b01, 0x55);
+    s01[2] = _mm256_permute_ps(b01, 0xaa);
+    s01[3] = _mm256_permute_ps(b01, 0xff);
+    s23[0] = _mm256_permute_ps(b23, 0x00);
+    s23[1] = _mm256_permute_ps(b23, 0x55);
+    s23[2] = _mm256_permute_ps(b23, 0xaa);
+    s23[3] = _mm256_permute_ps(b23, 0xff);
+
+    // Two matrices per iteration, four independent multiply-add chains
+    for (i = 0; i + 2 <= n; i += 2) {
+        float* p = dst + i * 16;
+        float* q = p + 16;
+        __m256 a[4], c[4];
+        mat4_broadcast_avx2(a, p, aligned);
+        mat4_broadcast_avx2(c, q, aligned);
+
+        __m256 p01 = _mm256_mul_ps(s01[0], a[0]);
+        __m256 p23 = _mm256_mul_ps(s23[0], a[0]);
+        __m256 q01 = _mm256_mul_ps(s01[0], c[0]);
+        __m256 q23 = _mm256_mul_ps(s23[0], c[0]);
+        p01 = _mm256_fmadd_ps(s01[1], a[1], p01);
+        p23 = _mm256_fmadd_ps(s23[1], a[1], p23);
+        q01 = _mm256_fmadd_ps(s01[1], c[1], q01);
+        q23 = _mm256_fmadd_ps(s23[1], c[1], q23);
+        p01 = _mm256_fmadd_ps(s01[2], a[2], p01);
+        p23 = _mm256_fmadd_ps(s23[2], a[2], p23);
+        q01 = _mm256_fmadd_ps(s01[2], c[2], q01);
+        q23 = _mm256_fmadd_ps(s23[2], c[2], q23);
+        p01 = _mm256_fmadd_ps(s01[3], a[3], p01);
+        p23 = _mm256_fmadd_ps(s23[3], a[3], p23);
+        q01 = _mm256_fmadd_ps(s01[3], c[3], q01);
+        q23 = _mm256_fmadd_ps(s23[3], c[3], q23);
+
+        simd_store8_ps(p, p01, aligned);
+        simd_store8_ps(p + 8, p23, aligned);
+        simd_store8_ps(q, q01, aligned);
+        simd_store8_ps(q + 8, q23, aligned);
+    }
+    if (i < n) {
+        mat4_multiply_avx2(dst + i * 16, b, aligned);
+    }
+}
+
+SIMD_AVX2 static void mat4_multiplyPairwise_n_avx2(float* dst, float* b, size_t n) {
+    size_t i;
+
+    // Two pairs per iteration, as in mat4_multiply_n_avx2
+    for (i = 0; i + 2 <= n; i += 2) {
+        float* p = dst + i * 16;
+        float* q = p + 16;
+        __m256 bp01 = _mm256_loadu_ps(b + i * 16), bp23 = _mm256_loadu_ps(b + i * 16 + 8);
+        __m256 bq01 = _mm256_loadu_ps(b + i * 16 + 16), bq23 = _mm256_loadu_ps(b + i * 16 + 24);
+        __m256 a[4], c[4];
+        mat4_broadcast_avx2(a, p, 0);
+        mat4_broadcast_avx2(c, q, 0);
+
+        __m256 p01 = _mm256_mul_ps(_mm256_permute_ps(bp01, 0x00), a[0]);
+        __m256 p23 = _mm256_mul_ps(_mm256_permute_ps(bp23, 0x00), a[0]);
+        __m256 q01 = _mm256_mul_ps(_mm256_permute_ps(bq01, 0x00), c[0]);
+        __m256 q23 = _mm256_mul_ps(_mm256_permute_ps(bq23, 0x00), c[0]);
+        p01 = _mm256_fmadd_ps(_mm256_permute_ps(bp01, 0x55), a[1], p01);
+        p23 = _mm256_fmadd_ps(_mm256_permute_ps(bp23, 0x55), a[1], p23);
+        q01 = _mm256_fmadd_ps(_mm256_permute_ps(bq01, 0x55), c[1], q01);
+        q23 = _mm256_fmadd_ps(_mm256_permute_ps(bq23, 0x55), c[1], q23);
+        p01 = _mm256_fmadd_ps(_mm256_permute_ps(bp01, 0xaa), a[2], p01);
+        p23 = _mm256_fmadd_ps(_mm256_permute_ps(bp23, 0xaa), a[2], p23);
+        q01 = _mm256_fmadd_ps(_mm256_permute_ps(bq01, 0xaa), c[2], q01);
+        q23 = _mm256_fmadd_ps(_mm256_permute_ps(bq23, 0xaa), c[2], q23);
+        p01 = _mm256_fmadd_ps(_mm256_permute_ps(bp01, 0xff), a[3], p01);
+        p23 = _mm256_fmadd_ps(_mm256_permute_ps(bp23, 0xff), a[3], p23);
+        q01 = _mm256_fmadd_ps(_mm256_permute_ps(bq01, 0xff), c[3], q01);
+        q23 = _mm256_fmadd_ps(_mm256_permute_ps(bq23, 0xff), c[3], q23);
+
+        _mm256_storeu_ps(p, p01);
+        _mm256_storeu_ps(p + 8, p23);
+        _mm256_storeu_ps(q, q01);
+        _mm256_storeu_ps(q + 8, q23);
+    }
+    if (i < n) {
+        mat4_multiply_avx2(dst + i * 16, b + i * 16, 0);
+    }
+}
+
+// One cofactor of mat4_invert: ((x * bx - y * by) op (z * bz)) * inv
+#define MAT4_COFACTOR_AVX2(op, x, bx, y, by, z, bz) \
+    _mm256_mul_ps(op(_mm256_sub_ps(_mm256_mul_ps(x, bx), _mm256_mul_ps(y, by)), _mm256_mul_ps(z, bz)), inv)
+
+SIMD_AVX2_NOFMA static SIMD_INLINE size_t mat4_invert_n_avx2(float* dst, uint8_t* ok, size_t n, uint8_t aligned) {
+    size_t i, inverted = 0;
+    uint8_t j;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        float* p = dst + i * 16;
+        __m256 a[16], r[16];
+
+        // Element k of all eight matrices ends up in a[k]
+        for (j = 0; j < 8; j++) {
+            a[j] = simd_load8_ps(p + j * 16, aligned);
+            a[j + 8] = simd_load8_ps(p + j * 16 + 8, aligned);
+        }
+        simd_transpose8_ps(a);
+        simd_transpose8_ps(a + 8);
+
+        // Same evaluation order as mat4_invert and no FMA, so results are bit-identical
+        __m256 b00 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[5]), _mm256_mul_ps(a[1], a[4]));
+        __m256 b01 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[6]), _mm256_mul_ps(a[2], a[4]));
+        __m256 b02 = _mm256_sub_ps(_mm256_mul_ps(a[0], a[7]), _mm256_mul_ps(a[3], a[4]));
+        __m256 b03 = _mm256_sub_ps(_mm256_mul_ps(a[1], a[6]), _mm256_mul_ps(a[2], a[5]));
+        __m256 b04 = _mm256_sub_ps(_mm256_mul_ps(a[1], a[7]), _mm256_mul_ps(a[3], a[5]));
+        __m256 b05 = _mm256_sub_ps(_mm256_mul_ps(a[2], a[7]), _mm256_mul_ps(a[3], a[6]));
+        __m256 b06 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[13]), _mm256_mul_ps(a[9], a[12]));
+        __m256 b07 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[14]), _mm256_mul_ps(a[10], a[12]));
+        __m256 b08 = _mm256_sub_ps(_mm256_mul_ps(a[8], a[15]), _mm256_mul_ps(a[11], a[12]));
+        __m256 b09 = _mm256_sub_ps(_mm256_mul_ps(a[9], a[14]), _mm256_mul_ps(a[10], a[13]));
+        __m256 b10 = _mm256_sub_ps(_mm256_mul_ps(a[9], a[15]), _mm256_mul_ps(a[11], a[13]));
+        __m256 b11 = _mm256_sub_ps(_mm256_mul_ps(a[10], a[15]), _mm256_mul_ps(a[11], a[14]));
+
+        __m256 det = _mm256_sub_ps(_mm256_mul_ps(b00, b11), _mm256_mul_ps(b01, b10));
+        det = _mm256_add_ps(det, _mm256_mul_ps(b02, b09));
+        det = _mm256_add_ps(det, _mm256_mul_ps(b03, b08));
+        det = _mm256_sub_ps(det, _mm256_mul_ps(b04, b07));
+        det = _mm256_add_ps(det, _mm256_mul_ps(b05, b06));
+
+        __m256 singular = _mm256_cmp_ps(det, _mm256_setzero_ps(), _CMP_EQ_OQ);
+        __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+
+        r[0] = MAT4_COFACTOR_AVX2(_mm256_add_ps, a[5], b11, a[6], b10, a[7], b09);
+        r[1] = MAT4_COFACTOR_AVX2(_mm256_sub_ps, a[2], b10, a[1], b11, a[3], b09);
+        r[2] = MAT4_COFACTOR_AVX2(_mm256_add_ps, a[13], b05, a[14], b04, a[15], b03);
+        r[3] = MAT4_COFACTOR_AVX2(_mm256_sub_ps, a[10], b04, a[9], b05, a[11], b03);
+        r[4] = MAT4_COFACTOR_AVX2(_mm256_sub_ps, a[6], b08, a[4], b11, a[7], b07);
+        r[5] = MAT4_COFACTOR_AVX2(_mm256_add_ps, a[0], b11, a[2], b08, a[3], b07);
+        r[6] = MAT4_COFACTOR_AVX2(_mm256_sub_ps, a[14], b02, a[12], b05, a[15], b01);
+        r[7] = MAT4_COFACTOR_AVX2(_mm256_add_ps, a[8], b05, a[10], b02, a[11], b01);
+        r[8] = MAT4_COFACTOR_AVX2(_mm256_add_ps, a[4], b10, a[5], b08, a[7], b06);
+        r[9] = MAT4_COFACTOR_AVX2(_mm256_sub_ps, a[1], b08, a[0], b10, a[3], b06);
+        r[10] = MAT4_COFACTOR_AVX2(_mm256_add_ps, a[12], b04, a[13], b02, a[15], b00);
+        r[11] = MAT4_COFACTOR_AVX2(_mm256_sub_ps, a[9], b02, a[8], b04, a[11], b00);
+        r[12] = MAT4_COFACTOR_AVX2(_mm256_sub_ps, a[5], b07, a[4], b09, a[6], b06);
+        r[13] = MAT4_COFACTOR_AVX2(_mm256_add_ps, a[0], b09, a[1], b07, a[2], b06);
+        r[14] = MAT4_COFACTOR_AVX2(_mm256_sub_ps, a[13], b01, a[12], b03, a[14], b00);
+        r[15] = MAT4_COFACTOR_AVX2(_mm256_add_ps, a[8], b03, a[9], b01, a[10], b00);
+
+        // Singular matrices keep their original elements
+        for (j = 0; j < 16; j++) {
+            r[j] = _mm256_blendv_ps(r[j], a[j], singular);
+        }
+
+        simd_transpose8_ps(r);
+        simd_transpose8_ps(r + 8);
+        for (j = 0; j < 8; j++) {
+            simd_store8_ps(p + j * 16, r[j], aligned);
+            simd_store8_ps(p + j * 16 + 8, r[j + 8], aligned);
+        }
+
+        int mask = _mm256_movemask_ps(singular);
+        for (j = 0; j < 8; j++) {
+            uint8_t res = !(mask & (1 << j));
+            if (ok) {
+                ok[i + j] = res;
+            }
+            inverted += res;
+        }
+    }
+    return inverted + mat4_invert_n_scalar(dst + i * 16, ok ? ok + i : NULL, n - i);
+}
+
+#undef MAT4_COFACTOR_AVX2
+
+// Entry points of the kernels above for unaligned and for aligned data
+SIMD_SSE41 static void mat4_multiply_unaligned_sse41(float* dst, float* b) {
+    mat4_multiply_sse41(dst, b, 0);
+}
+
+SIMD_SSE41 static void mat4_multiply_aligned_sse41(float* dst, float* b) {
+    mat4_multiply_sse41(dst, b, 1);
+}
+
+SIMD_AVX2 static void mat4_multiply_unaligned_avx2(float* dst, float* b) {
+    mat4_multiply_avx2(dst, b, 0);
+}
+
+SIMD_AVX2 static void mat4_multiply_aligned_avx2(float* dst, float* b) {
+    mat4_multiply_avx2(dst, b, 1);
+}
+
+SIMD_SSE41 static void mat4_multiply_n_unaligned_sse41(float* dst, float* b, size_t n) {
+    mat4_multiply_n_sse41(dst, b, n, 0);
+}
+
+SIMD_SSE41 static void mat4_multiply_n_aligned_sse41(float* dst, float* b, size_t n) {
+    mat4_multiply_n_sse41(dst, b, n, 1);
+}
+
+SIMD_AVX2 static void mat4_multiply_n_unaligned_avx2(float* dst, float* b, size_t n) {
+    mat4_multiply_n_avx2(dst, b, n, 0);
+}
+
+SIMD_AVX2 static void mat4_multiply_n_aligned_avx2(float* dst, float* b, size_t n) {
+    mat4_multiply_n_avx2(dst, b, n, 1);
+}
+
+SIMD_AVX2_NOFMA static size_t mat4_invert_n_unaligned_avx2(float* dst, uint8_t* ok, size_t n) {
+    return mat4_invert_n_avx2(dst, ok, n, 0);
+}
+
+SIMD_AVX2_NOFMA static size_t mat4_invert_n_aligned_avx2(float* dst, uint8_t* ok, size_t n) {
+    return mat4_invert_n_avx2(dst, ok, n, 1);
+}
+#endif
+
+static void (*mat4_multiply_impl)(float* dst, float* b) = mat4_multiply_scalar;
+static void (*mat4_multiply_n_impl)(float* dst, float* b, size_t n) = mat4_multiply_n_scalar;
+static void (*mat4_multiplyPairwise_n_impl)(float* dst, float* b, size_t n) = mat4_multiplyPairwise_n_scalar;
+static size_t (*mat4_invert_n_impl)(float* dst, uint8_t* ok, size_t n) = mat4_invert_n_scalar;
+// Float only
+static void (*mat4_multiply_aligned_impl)(float* dst, float* b) = mat4_multiply_scalar;
+static void (*mat4_multiply_n_aligned_impl)(float* dst, float* b, size_t n) = mat4_multiply_n_scalar;
+static size_t (*mat4_invert_n_aligned_impl)(float* dst, uint8_t* ok, size_t n) = mat4_invert_n_scalar;
+// End float only
+
+__attribute__((constructor))
+static void mat4_dispatch(void) {
+#if GL_MATRIX_SIMD
+    uint32_t features = cpu_features();
+
+    if ((features & CPU_AVX2) && (features & CPU_FMA)) {
+        mat4_multiply_impl = mat4_multiply_unaligned_avx2;
+        mat4_multiply_n_impl = mat4_multiply_n_unaligned_avx2;
+        mat4_multiplyPairwise_n_impl = mat4_multiplyPairwise_n_avx2;
+        mat4_invert_n_impl = mat4_invert_n_unaligned_avx2;
+        mat4_multiply_aligned_impl = mat4_multiply_aligned_avx2;
+        mat4_multiply_n_aligned_impl = mat4_multiply_n_aligned_avx2;
+        mat4_invert_n_aligned_impl = mat4_invert_n_aligned_avx2;
+    }
+    else if (features & CPU_SSE41) {
+        mat4_multiply_impl = mat4_multiply_unaligned_sse41;
+        mat4_multiply_n_impl = mat4_multiply_n_unaligned_sse41;
+        mat4_multiplyPairwise_n_impl = mat4_multiplyPairwise_n_sse41;
+        mat4_multiply_aligned_impl = mat4_multiply_aligned_sse41;
+        mat4_multiply_n_aligned_impl = mat4_multiply_n_aligned_sse41;
+    }
+#endif
+}
+
+GL_MATRIX_API void mat4_multiply(float* dst, float* b) {
+    mat4_multiply_impl(dst, b);
+}
+
+GL_MATRIX_API void mat4_multiply_n(float* dst, float* b, size_t n) {
+    mat4_multiply_n_impl(dst, b, n);
+}
+
+GL_MATRIX_API void mat4_multiplyPairwise_n(float* dst, float* b, size_t n) {
+    mat4_multiplyPairwise_n_impl(dst, b, n);
+}
+
+GL_MATRIX_API size_t mat4_invert_n(float* dst, uint8_t* ok, size_t n) {
+    return mat4_invert_n_impl(dst, ok, n);
+}
+
+// Float only
+GL_MATRIX_API void mat4_multiply_aligned(float* dst, float* b) {
+    SIMD_ASSERT_ALIGNED(dst, MAT4_ALIGNMENT);
+    SIMD_ASSERT_ALIGNED(b, MAT4_ALIGNMENT);
+    mat4_multiply_aligned_impl(dst, b);
+}
+
+GL_MATRIX_API void mat4_multiply_n_aligned(float* dst, float* b, size_t n) {
+    SIMD_ASSERT_ALIGNED(dst, MAT4_ALIGNMENT);
+    SIMD_ASSERT_ALIGNED(b, MAT4_ALIGNMENT);
+    mat4_multiply_n_aligned_impl(dst, b, n);
+}
+
+GL_MATRIX_API size_t mat4_invert_n_aligned(float* dst, uint8_t* ok, size_t n) {
+    SIMD_ASSERT_ALIGNED(dst, MAT4_ALIGNMENT);
+    return mat4_invert_n_aligned_impl(dst, ok, n);
+}
+// End float only
+
+GL_MATRIX_API void mat4_translate(float dst[16], float v[3]) {
     float x = v[0], y = v[1], z = v[2];
     dst[12] = dst[0] * x + dst[4] * y + dst[8] * z + dst[12];
     dst[13] = dst[1] * x + dst[5] * y + dst[9] * z + dst[13];
@@ -225,14 +719,14 @@ void mat4_translate(float dst[16], float v[3]) {
     dst[15] = dst[3] * x + dst[7] * y + dst[11] * z + dst[15];
 }
 
-void mat4_translatef(float dst[16], float x, float y, float z) {
+GL_MATRIX_API void mat4_translatef(float dst[16], float x, float y, float z) {
     dst[12] = dst[0] * x + dst[4] * y + dst[8] * z + dst[12];
     dst[13] = dst[1] * x + dst[5] * y + dst[9] * z + dst[13];
     dst[14] = dst[2] * x + dst[6] * y + dst[10] * z + dst[14];
     dst[15] = dst[3] * x + dst[7] * y + dst[11] * z + dst[15];
 }
 
-void mat4_scale(float* dst, float* v) {
+GL_MATRIX_API void mat4_scale(float* dst, float* v) {
     float x = v[0], y = v[1], z = v[2];
 
     dst[0] = dst[0] * x;
@@ -253,7 +747,7 @@ void mat4_scale(float* dst, float* v) {
     dst[15] = dst[15];
 }
 
-void mat4_rotate(float* dst, float rad, float* axis) {
+GL_MATRIX_API void mat4_rotate(float* dst, float rad, float* axis) {
     float x = axis[0], y = axis[1], z = axis[2];
     float len = sqrtf(x * x + y * y + z * z);
     float s, c, t;
@@ -299,7 +793,7 @@ void mat4_rotate(float* dst, float rad, float* axis) {
     dst[11] = a03 * b20 + a13 * b21 + a23 * b22;
 }
 
-void mat4_rotateX(float* dst, float rad) {
+GL_MATRIX_API void mat4_rotateX(float* dst, float rad) {
     float s = sinf(rad);
     float c = cosf(rad);
     float a10 = dst[4];
@@ -322,7 +816,7 @@ void mat4_rotateX(float* dst, float rad) {
     dst[11] = a23 * c - a13 * s;
 }
 
-void mat4_rotateY(float* dst, float rad) {
+GL_MATRIX_API void mat4_rotateY(float* dst, float rad) {
     float s = sinf(rad);
     float c = cosf(rad);
     float a00 = dst[0];
@@ -345,7 +839,7 @@ void mat4_rotateY(float* dst, float rad) {
     dst[11] = a03 * s + a23 * c;
 }
 
-void mat4_rotateZ(float* dst, float rad) {
+GL_MATRIX_API void mat4_rotateZ(float* dst, float rad) {
     float s = sinf(rad);
     float c = cosf(rad);
     float a00 = dst[0];
@@ -368,7 +862,7 @@ void mat4_rotateZ(float* dst, float rad) {
     dst[7] = a13 * c - a03 * s;
 }
 
-void mat4_fromTranslation(float* dst, float* v) {
+GL_MATRIX_API void mat4_fromTranslation(float* dst, float* v) {
     dst[0] = 1;
     dst[1] = 0;
     dst[2] = 0;
@@ -387,7 +881,7 @@ void mat4_fromTranslation(float* dst, float* v) {
     dst[15] = 1;
 }
 
-void mat4_fromScaling(float* dst, float* v) {
+GL_MATRIX_API void mat4_fromScaling(float* dst, float* v) {
     dst[0] = v[0];
     dst[1] = 0;
     dst[2] = 0;
@@ -406,7 +900,7 @@ void mat4_fromScaling(float* dst, float* v) {
     dst[15] = 1;
 }
 
-void mat4_fromRotation(float* dst, float rad, float* axis) {
+GL_MATRIX_API void mat4_fromRotation(float* dst, float rad, float* axis) {
     float x = axis[0], y = axis[1], z = axis[2];
     float len = sqrtf(x * x + y * y + z * z);
     float s, c, t;
@@ -441,7 +935,7 @@ void mat4_fromRotation(float* dst, float rad, float* axis) {
     dst[15] = 1;
 }
 
-void mat4_fromXRotation(float* dst, float rad) {
+GL_MATRIX_API void mat4_fromXRotation(float* dst, float rad) {
     float s = sinf(rad);
     float c = cosf(rad);
 
@@ -464,7 +958,7 @@ void mat4_fromXRotation(float* dst, float rad) {
     dst[15] = 1;
 }
 
-void mat4_fromYRotation(float* dst, float rad) {
+GL_MATRIX_API void mat4_fromYRotation(float* dst, float rad) {
     float s = sinf(rad);
     float c = cosf(rad);
 
@@ -487,7 +981,7 @@ void mat4_fromYRotation(float* dst, float rad) {
     dst[15] = 1;
 }
 
-void mat4_fromZRotation(float* dst, float rad) {
+GL_MATRIX_API void mat4_fromZRotation(float* dst, float rad) {
     float s = sinf(rad);
     float c = cosf(rad);
 
@@ -510,7 +1004,7 @@ void mat4_fromZRotation(float* dst, float rad) {
     dst[15] = 1;
 }
 
-void mat4_fromRotationTranslation(float* dst, float* q, float* v) {
+GL_MATRIX_API SIMD_CLONES void mat4_fromRotationTranslation(float* dst, float* q, float* v) {
     // Quaternion math
     float x = q[0], y = q[1], z = q[2], w = q[3];
     float x2 = x + x;
@@ -545,13 +1039,27 @@ void mat4_fromRotationTranslation(float* dst, float* q, float* v) {
     dst[15] = 1;
 }
 
-void mat4_getTranslation(float* dst, float* mat) {
+GL_MATRIX_API void mat4_fromQuat2(float* dst, float* a) {
+    float translation[3];
+    float bx = -a[0], by = -a[1], bz = -a[2], bw = a[3];
+    float ax = a[4], ay = a[5], az = a[6], aw = a[7];
+
+    // Scale by the magnitude so dual quats that are not normalized still work
+    float magnitude = bx * bx + by * by + bz * bz + bw * bw;
+    float scale = magnitude > 0 ? 2 / magnitude : 2;
+    translation[0] = (ax * bw + aw * bx + ay * bz - az * by) * scale;
+    translation[1] = (ay * bw + aw * by + az * bx - ax * bz) * scale;
+    translation[2] = (az * bw + aw * bz + ax * by - ay * bx) * scale;
+    mat4_fromRotationTranslation(dst, a, translation);
+}
+
+GL_MATRIX_API void mat4_getTranslation(float* dst, float* mat) {
     dst[0] = mat[12];
     dst[1] = mat[13];
     dst[2] = mat[14];
 }
 
-void mat4_getScaling(float* dst, float* mat) {
+GL_MATRIX_API void mat4_getScaling(float* dst, float* mat) {
     float m11 = mat[0];
     float m12 = mat[1];
     float m13 = mat[2];
@@ -567,7 +1075,7 @@ void mat4_getScaling(float* dst, float* mat) {
     dst[2] = sqrtf(m31 * m31 + m32 * m32 + m33 * m33);
 }
 
-void mat4_getRotation(float* dst, float* mat) {
+GL_MATRIX_API void mat4_getRotation(float* dst, float* mat) {
     // Algorithm taken from http://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToQuaternion/index.htm
     float trace = mat[0] + mat[5] + mat[10];
     float S = 0;
@@ -602,7 +1110,7 @@ void mat4_getRotation(float* dst, float* mat) {
     }
 }
 
-void mat4_fromRotationTranslationScale(float* dst, float* q, float* v, float* s) {
+GL_MATRIX_API SIMD_CLONES void mat4_fromRotationTranslationScale(float* dst, float* q, float* v, float* s) {
     // Quaternion math
     float x = q[0], y = q[1], z = q[2], w = q[3];
     float x2 = x + x;
@@ -640,7 +1148,7 @@ void mat4_fromRotationTranslationScale(float* dst, float* q, float* v, float* s)
     dst[15] = 1;
 }
 
-void mat4_fromRotationTranslationScaleOrigin(float* dst, float* q, float* v, float* s, float* o) {
+GL_MATRIX_API void mat4_fromRotationTranslationScaleOrigin(float* dst, float* q, float* v, float* s, float* o) {
     // Quaternion math
     float x = q[0], y = q[1], z = q[2], w = q[3];
     float x2 = x + x;
@@ -693,7 +1201,7 @@ void mat4_fromRotationTranslationScaleOrigin(float* dst, float* q, float* v, flo
     dst[15] = 1;
 }
 
-void mat4_fromQuat(float* dst, float* q) {
+GL_MATRIX_API void mat4_fromQuat(float* dst, float* q) {
     float x = q[0], y = q[1], z = q[2], w = q[3];
     float x2 = x + x;
     float y2 = y + y;
@@ -730,7 +1238,7 @@ void mat4_fromQuat(float* dst, float* q) {
     dst[15] = 1;
 }
 
-void mat4_frustum(float* dst, float left, float right, float bottom, float top, float near, float far) {
+GL_MATRIX_API void mat4_frustum(float* dst, float left, float right, float bottom, float top, float near, float far) {
     float rl = 1 / (right - left);
     float tb = 1 / (top - bottom);
     float nf = 1 / (near - far);
@@ -752,7 +1260,7 @@ void mat4_frustum(float* dst, float left, float right, float bottom, float top,
     dst[15] = 0;
 }
 
-void mat4_perspective(float* dst, float fovy, float aspect, float near, float far) {
+GL_MATRIX_API void mat4_perspective(float* dst, float fovy, float aspect, float near, float far) {
     float f = 1.0 / tanf(fovy / 2), nf;
     dst[0] = f / aspect;
     dst[1] = 0;
@@ -779,7 +1287,7 @@ void mat4_perspective(float* dst, float fovy, float aspect, float near, float fa
     }
 }
 
-void mat4_ortho(float* dst, float left, float right, float bottom, float top, float near, float far) {
+GL_MATRIX_API void mat4_ortho(float* dst, float left, float right, float bottom, float top, float near, float far) {
     float lr = 1 / (left - right);
     float bt = 1 / (bottom - top);
     float nf = 1 / (near - far);
@@ -801,7 +1309,7 @@ void mat4_ortho(float* dst, float left, float right, float bottom, float top, fl
     dst[15] = 1;
 }
 
-void mat4_lookAt(float* dst, float* eye, float* center, float* up) {
+GL_MATRIX_API void mat4_lookAt(float* dst, float* eye, float* center, float* up) {
     float x0, x1, x2, y0, y1, y2, z0, z1, z2, len;
     float eyex = eye[0];
     float eyey = eye[1];
@@ -878,7 +1386,7 @@ void mat4_lookAt(float* dst, float* eye, float* center, float* up) {
     dst[15] = 1;
 }
 
-void mat4_targetTo(float* dst, float* eye, float* target, float* up) {
+GL_MATRIX_API void mat4_targetTo(float* dst, float* eye, float* target, float* up) {
     float eyex = eye[0],
         eyey = eye[1],
         eyez = eye[2],
@@ -928,11 +1436,11 @@ void mat4_targetTo(float* dst, float* eye, float* target, float* up) {
     dst[15] = 1;
 };
 
-float mat4_frob(float* a) {
+GL_MATRIX_API float mat4_frob(float* a) {
     return (sqrtf(powf(a[0], 2) + powf(a[1], 2) + powf(a[2], 2) + powf(a[3], 2) + powf(a[4], 2) + powf(a[5], 2) + powf(a[6], 2) + powf(a[7], 2) + powf(a[8], 2) + powf(a[9], 2) + powf(a[10], 2) + powf(a[11], 2) + powf(a[12], 2) + powf(a[13], 2) + powf(a[14], 2) + powf(a[15], 2) ));
 }
 
-void mat4_add(float* dst, float* b) {
+GL_MATRIX_API void mat4_add(float* dst, float* b) {
     dst[0] = dst[0] + b[0];
     dst[1] = dst[1] + b[1];
     dst[2] = dst[2] + b[2];
@@ -951,7 +1459,7 @@ void mat4_add(float* dst, float* b) {
     dst[15] = dst[15] + b[15];
 }
 
-void mat4_subtract(float* dst, float* b) {
+GL_MATRIX_API void mat4_subtract(float* dst, float* b) {
     dst[0] = dst[0] - b[0];
     dst[1] = dst[1] - b[1];
     dst[2] = dst[2] - b[2];
@@ -970,7 +1478,7 @@ void mat4_subtract(float* dst, float* b) {
     dst[15] = dst[15] - b[15];
 }
 
-void mat4_multiplyScalar(float* dst, float b) {
+GL_MATRIX_API void mat4_multiplyScalar(float* dst, float b) {
     dst[0] = dst[0] * b;
     dst[1] = dst[1] * b;
     dst[2] = dst[2] * b;
@@ -989,7 +1497,7 @@ void mat4_multiplyScalar(float* dst, float b) {
     dst[15] = dst[15] * b;
 }
 
-void mat4_multiplyScalarAndAdd(float* dst, float* b, float scale) {
+GL_MATRIX_API void mat4_multiplyScalarAndAdd(float* dst, float* b, float scale) {
     dst[0] = dst[0] + (b[0] * scale);
     dst[1] = dst[1] + (b[1] * scale);
     dst[2] = dst[2] + (b[2] * scale);
@@ -1008,7 +1516,7 @@ void mat4_multiplyScalarAndAdd(float* dst, float* b, float scale) {
     dst[15] = dst[15] + (b[15] * scale);
 }
 
-uint8_t mat4_equals(float* a, float* b) {
+GL_MATRIX_API uint8_t mat4_equals(float* a, float* b) {
     return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3] &&
         a[4] == b[4] && a[5] == b[5] && a[6] == b[6] && a[7] == b[7] &&
         a[8] == b[8] && a[9] == b[9] && a[10] == b[10] && a[11] == b[11] &&
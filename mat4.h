@@ -1,21 +1,39 @@
 #ifndef MAT4_H
 #define MAT4_H
 
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
 #include <stdint.h>
+#include "api.h"
+
+// Float only
+/**
+ * Alignment in bytes of the matrices the _aligned functions take, two AVX
+ * registers' worth, so no load of one straddles a cache line.
+ */
+#define MAT4_ALIGNMENT (8 * sizeof(float))
+
+/**
+ * A mat4 with MAT4_ALIGNMENT, e.g. for a local or an array of matrices.
+ * Passes to every mat4 function.
+ */
+typedef float mat4_aligned[16] GL_MATRIX_ALIGNED(MAT4_ALIGNMENT);
+// End float only
 
 /**
  * Print a mat4 matrix to stderr
  *
  * @param {mat4} the matrix to dump
  */
-void mat4_dump(float dst[16]);
+GL_MATRIX_API void mat4_dump(float dst[16]);
 
 /**
  * Set a mat4 to the identity matrix
  *
  * @param {mat4} out the receiving matrix
  */
-void mat4_identity(float dst[16]);
+GL_MATRIX_API void mat4_identity(float dst[16]);
 
 /**
  * Copy the values from one mat4 to another
@@ -23,7 +41,7 @@ void mat4_identity(float dst[16]);
  * @param {mat4} out the receiving matrix
  * @param {mat4} a the source matrix
  */
-void mat4_copy(float* dst, float* src);
+GL_MATRIX_API void mat4_copy(float* dst, float* src);
 
 /**
  * Set the components of a mat4 to the given values
@@ -46,28 +64,80 @@ void mat4_copy(float* dst, float* src);
  * @param {Number} m32 Component in column 3, row 2 position (index 14)
  * @param {Number} m33 Component in column 3, row 3 position (index 15)
  */
-void mat4_set(float* dst, float m00, float m01, float m02, float m03, float m10, float m11, float m12, float m13, float m20, float m21, float m22, float m23, float m30, float m31, float m32, float m33);
+GL_MATRIX_API void mat4_set(float* dst, float m00, float m01, float m02, float m03, float m10, float m11, float m12, float m13, float m20, float m21, float m22, float m23, float m30, float m31, float m32, float m33);
 
 /**
  * Transpose the values of a mat4
  *
  * @param {mat4} out the receiving matrix
  */
-void mat4_transpose(float* dst);
+GL_MATRIX_API void mat4_transpose(float* dst);
 
 /**
  * Inverts a mat4
+ * A singular matrix is left unchanged.
+ *
+ * @param {mat4} out the receiving matrix
+ * @returns {uint8_t} 1 if the matrix was inverted, 0 if it is singular
+ */
+GL_MATRIX_API uint8_t mat4_invert(float* dst);
+
+/**
+ * Inverts an affine mat4, one whose last row is [0, 0, 0, 1]
+ * Only the upper 3x3 block is inverted and the translation is moved
+ * through it, which is about half the work of mat4_invert.
+ * A singular matrix is left unchanged.
  *
  * @param {mat4} out the receiving matrix
+ * @returns {uint8_t} 1 if the matrix was inverted, 0 if it is singular
+ */
+GL_MATRIX_API uint8_t mat4_invertAffine(float* dst);
+
+/**
+ * Inverts a rigid mat4, a rotation followed by a translation
+ * The rotation is transposed and the translation moved through it.
+ * The result is only correct if the upper 3x3 block is orthonormal,
+ * which is not checked, so this can not fail.
+ *
+ * @param {mat4} out the receiving matrix
+ */
+GL_MATRIX_API void mat4_invertRigid(float* dst);
+
+/**
+ * Inverts each mat4 in an array
+ * Equivalent to calling mat4_invert(dst + i * 16) for every i. Singular
+ * matrices are left unchanged.
+ *
+ * The AVX2 kernel inverts eight matrices at a time and gives the same
+ * results.
+ *
+ * @param {mat4[]} out array of n receiving matrices, packed 16 floats apart
+ * @param {uint8_t[]} ok receives the mat4_invert result for each matrix, may be NULL
+ * @param {Number} n number of matrices in out
+ * @returns {Number} number of matrices that were inverted
+ */
+GL_MATRIX_API size_t mat4_invert_n(float* dst, uint8_t* ok, size_t n);
+
+// Float only
+/**
+ * mat4_invert_n for an array aligned to MAT4_ALIGNMENT, e.g. an array of
+ * mat4_aligned or from align_alloc. The kernel uses aligned loads and
+ * stores. Debug builds assert the alignment.
+ *
+ * @param {mat4[]} out array of n receiving matrices, packed 16 floats apart
+ * @param {uint8_t[]} ok receives the mat4_invert result for each matrix, may be NULL
+ * @param {Number} n number of matrices in out
+ * @returns {Number} number of matrices that were inverted
  */
-void mat4_invert(float* dst);
+GL_MATRIX_API size_t mat4_invert_n_aligned(float* dst, uint8_t* ok, size_t n);
+// End float only
 
 /**
  * Calculates the adjugate of a mat4
  *
  * @param {mat4} out the receiving matrix
  */
-void mat4_adjoint(float* dst);
+GL_MATRIX_API void mat4_adjoint(float* dst);
 
 /**
  * Calculates the determinant of a mat4
@@ -75,15 +145,65 @@ void mat4_adjoint(float* dst);
  * @param {mat4} a the source matrix
  * @returns {Number} determinant of a
  */
-float mat4_determinant(float* dst);
+GL_MATRIX_API float mat4_determinant(float* dst);
 
 /**
  * Multiplies two mat4s
  *
+ * Uses an SSE4.1 or AVX2/FMA kernel when the CPU supports it, picked once
+ * at load time. The SSE4.1 kernel is bit-identical to the scalar code. The
+ * AVX2 kernel fuses each multiply-add, skipping an intermediate rounding,
+ * so elements may differ from the scalar result by a few ULP.
+ *
  * @param {mat4} out the receiving matrix
  * @param {mat4} b the first operand
  */
-void mat4_multiply(float* dst, float* b);
+GL_MATRIX_API void mat4_multiply(float* dst, float* b);
+
+// Float only
+/**
+ * mat4_multiply for matrices aligned to MAT4_ALIGNMENT, with the same
+ * results. Debug builds assert the alignment.
+ *
+ * @param {mat4} out the receiving matrix
+ * @param {mat4} b the first operand
+ */
+GL_MATRIX_API void mat4_multiply_aligned(float* dst, float* b);
+// End float only
+
+/**
+ * Multiplies each mat4 in an array by the same mat4
+ * Equivalent to calling mat4_multiply(dst + i * 16, b) for every i, with
+ * the same results, but b is only loaded once for the whole batch.
+ *
+ * @param {mat4[]} out array of n receiving matrices, packed 16 floats apart
+ * @param {mat4} b the shared operand, must not point into out
+ * @param {Number} n number of matrices in out
+ */
+GL_MATRIX_API void mat4_multiply_n(float* dst, float* b, size_t n);
+
+// Float only
+/**
+ * mat4_multiply_n for an array and a shared operand aligned to
+ * MAT4_ALIGNMENT, with the same results. Debug builds assert the
+ * alignment.
+ *
+ * @param {mat4[]} out array of n receiving matrices, packed 16 floats apart
+ * @param {mat4} b the shared operand, must not point into out
+ * @param {Number} n number of matrices in out
+ */
+GL_MATRIX_API void mat4_multiply_n_aligned(float* dst, float* b, size_t n);
+// End float only
+
+/**
+ * Multiplies two arrays of mat4s element by element
+ * Equivalent to calling mat4_multiply(dst + i * 16, b + i * 16) for every i.
+ *
+ * @param {mat4[]} out array of n receiving matrices, packed 16 floats apart
+ * @param {mat4[]} b array of n operands, must not overlap out
+ * @param {Number} n number of matrices in each array
+ */
+GL_MATRIX_API void mat4_multiplyPairwise_n(float* dst, float* b, size_t n);
 
 /**
  * Translate a mat4 by the given vector
@@ -91,7 +211,7 @@ void mat4_multiply(float* dst, float* b);
  * @param {mat4} out the receiving matrix
  * @param {vec3} v vector to translate by
  */
-void mat4_translate(float dst[16], float v[3]);
+GL_MATRIX_API void mat4_translate(float dst[16], float v[3]);
 
 /**
  * Translate a mat4 by the given flat 4 floats
@@ -101,7 +221,7 @@ void mat4_translate(float dst[16], float v[3]);
  * @param {y} Y translation
  * @param {z} Z translation
  */
-void mat4_translatef(float dst[16], float x, float y, float z);
+GL_MATRIX_API void mat4_translatef(float dst[16], float x, float y, float z);
 
 /**
  * Scales the mat4 by the dimensions in the given vec3 not using vectorization
@@ -109,7 +229,7 @@ void mat4_translatef(float dst[16], float x, float y, float z);
  * @param {mat4} out the receiving matrix
  * @param {vec3} v the vec3 to scale the matrix by
  **/
-void mat4_scale(float* dst, float* v);
+GL_MATRIX_API void mat4_scale(float* dst, float* v);
 
 /**
  * Rotates a mat4 by the given angle around the given axis
@@ -118,7 +238,7 @@ void mat4_scale(float* dst, float* v);
  * @param {Number} rad the angle to rotate the matrix by
  * @param {vec3} axis the axis to rotate around
  */
-void mat4_rotate(float* dst, float rad, float* axis);
+GL_MATRIX_API void mat4_rotate(float* dst, float rad, float* axis);
 
 /**
  * Rotates a matrix by the given angle around the X axis
@@ -126,7 +246,7 @@ void mat4_rotate(float* dst, float rad, float* axis);
  * @param {mat4} out the receiving matrix
  * @param {Number} rad the angle to rotate the matrix by
  */
-void mat4_rotateX(float* dst, float rad);
+GL_MATRIX_API void mat4_rotateX(float* dst, float rad);
 
 /**
  * Rotates a matrix by the given angle around the Y axis
@@ -134,7 +254,7 @@ void mat4_rotateX(float* dst, float rad);
  * @param {mat4} out the receiving matrix
  * @param {Number} rad the angle to rotate the matrix by
  */
-void mat4_rotateY(float* dst, float rad);
+GL_MATRIX_API void mat4_rotateY(float* dst, float rad);
 
 /**
  * Rotates a matrix by the given angle around the Z axis
@@ -142,7 +262,7 @@ void mat4_rotateY(float* dst, float rad);
  * @param {mat4} out the receiving matrix
  * @param {Number} rad the angle to rotate the matrix by
  */
-void mat4_rotateZ(float* dst, float rad);
+GL_MATRIX_API void mat4_rotateZ(float* dst, float rad);
 
 /**
  * Initializes a matrix from a vector translation
@@ -154,7 +274,7 @@ void mat4_rotateZ(float* dst, float rad);
  * @param {mat4} out mat4 receiving operation result
  * @param {vec3} v Translation vector
  */
-void mat4_fromTranslation(float* dst, float* v);
+GL_MATRIX_API void mat4_fromTranslation(float* dst, float* v);
 
 /**
  * Initializes a matrix from a vector scaling
@@ -166,7 +286,7 @@ void mat4_fromTranslation(float* dst, float* v);
  * @param {mat4} out mat4 receiving operation result
  * @param {vec3} v Scaling vector
  */
-void mat4_fromScaling(float* dst, float* v);
+GL_MATRIX_API void mat4_fromScaling(float* dst, float* v);
 
 /**
  * Initializes a matrix from a given angle around a given axis
@@ -179,7 +299,7 @@ void mat4_fromScaling(float* dst, float* v);
  * @param {Number} rad the angle to rotate the matrix by
  * @param {vec3} axis the axis to rotate around
  */
-void mat4_fromRotation(float* dst, float rad, float* axis);
+GL_MATRIX_API void mat4_fromRotation(float* dst, float rad, float* axis);
 
 /**
  * Initializes a matrix from the given angle around the X axis
@@ -191,7 +311,7 @@ void mat4_fromRotation(float* dst, float rad, float* axis);
  * @param {mat4} out mat4 receiving operation result
  * @param {Number} rad the angle to rotate the matrix by
  */
-void mat4_fromXRotation(float* dst, float rad);
+GL_MATRIX_API void mat4_fromXRotation(float* dst, float rad);
 
 /**
  * Initializes a matrix from the given angle around the Y axis
@@ -203,7 +323,7 @@ void mat4_fromXRotation(float* dst, float rad);
  * @param {mat4} out mat4 receiving operation result
  * @param {Number} rad the angle to rotate the matrix by
  */
-void mat4_fromYRotation(float* dst, float rad);
+GL_MATRIX_API void mat4_fromYRotation(float* dst, float rad);
 
 /**
  * Initializes a matrix from the given angle around the Z axis
@@ -215,7 +335,7 @@ void mat4_fromYRotation(float* dst, float rad);
  * @param {mat4} out mat4 receiving operation result
  * @param {Number} rad the angle to rotate the matrix by
  */
-void mat4_fromZRotation(float* dst, float rad);
+GL_MATRIX_API void mat4_fromZRotation(float* dst, float rad);
 
 /**
  * Initializes a matrix from a quaternion rotation and vector translation
@@ -231,7 +351,7 @@ void mat4_fromZRotation(float* dst, float rad);
  * @param {quat4} q Rotation quaternion
  * @param {vec3} v Translation vector
  */
-void mat4_fromRotationTranslation(float* dst, float* q, float* v);
+GL_MATRIX_API void mat4_fromRotationTranslation(float* dst, float* q, float* v);
 
 /**
  * Creates a new mat4 from a dual quat.
@@ -239,7 +359,7 @@ void mat4_fromRotationTranslation(float* dst, float* q, float* v);
  * @param {mat4} out Matrix
  * @param {quat2} a Dual Quaternion
  */
-void mat4_fromQuat2(float* dst, float* a);
+GL_MATRIX_API void mat4_fromQuat2(float* dst, float* a);
 
 /**
  * Returns the translation vector component of a transformation
@@ -249,7 +369,7 @@ void mat4_fromQuat2(float* dst, float* a);
  * @param  {vec3} out Vector to receive translation component
  * @param  {mat4} mat Matrix to be decomposed (input)
  */
-void mat4_getTranslation(float* dst, float* mat);
+GL_MATRIX_API void mat4_getTranslation(float* dst, float* mat);
 
 /**
  * Returns the scaling factor component of a transformation
@@ -260,7 +380,7 @@ void mat4_getTranslation(float* dst, float* mat);
  * @param  {vec3} out Vector to receive scaling factor component
  * @param  {mat4} mat Matrix to be decomposed (input)
  */
-void mat4_getScaling(float* dst, float* mat);
+GL_MATRIX_API void mat4_getScaling(float* dst, float* mat);
 
 /**
  * Returns a quaternion representing the rotational component
@@ -270,7 +390,7 @@ void mat4_getScaling(float* dst, float* mat);
  * @param {quat} out Quaternion to receive the rotation component
  * @param {mat4} mat Matrix to be decomposed (input)
  */
-void mat4_getRotation(float* dst, float* mat);
+GL_MATRIX_API void mat4_getRotation(float* dst, float* mat);
 
 /**
  * Initializes a matrix from a quaternion rotation, vector translation and vector scale
@@ -288,7 +408,7 @@ void mat4_getRotation(float* dst, float* mat);
  * @param {vec3} v Translation vector
  * @param {vec3} s Scaling vector
  */
-void mat4_fromRotationTranslationScale(float* dst, float* q, float* v, float* s);
+GL_MATRIX_API void mat4_fromRotationTranslationScale(float* dst, float* q, float* v, float* s);
 
 /**
  * Initializes a matrix from a quaternion rotation, vector translation and vector scale, rotating and scaling around the given origin
@@ -309,7 +429,7 @@ void mat4_fromRotationTranslationScale(float* dst, float* q, float* v, float* s)
  * @param {vec3} s Scaling vector
  * @param {vec3} o The origin vector around which to scale and rotate
  */
-void mat4_fromRotationTranslationScaleOrigin(float* dst, float* q, float* v, float* s, float* o);
+GL_MATRIX_API void mat4_fromRotationTranslationScaleOrigin(float* dst, float* q, float* v, float* s, float* o);
 
 /**
  * Calculates a 4x4 matrix from the given quaternion
@@ -319,7 +439,7 @@ void mat4_fromRotationTranslationScaleOrigin(float* dst, float* q, float* v, flo
  *
  * @returns {mat4} out
  */
-void mat4_fromQuat(float* dst, float* q);
+GL_MATRIX_API void mat4_fromQuat(float* dst, float* q);
 
 /**
  * Generates a frustum matrix with the given bounds
@@ -332,7 +452,7 @@ void mat4_fromQuat(float* dst, float* q);
  * @param {Number} near Near bound of the frustum
  * @param {Number} far Far bound of the frustum
  */
-void mat4_frustum(float* dst, float left, float right, float bottom, float top, float near, float far);
+GL_MATRIX_API void mat4_frustum(float* dst, float left, float right, float bottom, float top, float near, float far);
 
 /**
  * Generates a perspective projection matrix with the given bounds.
@@ -344,7 +464,7 @@ void mat4_frustum(float* dst, float left, float right, float bottom, float top,
  * @param {number} near Near bound of the frustum
  * @param {number} far Far bound of the frustum, can be 0 or FLT_MAX
  */
-void mat4_perspective(float* dst, float fovy, float aspect, float near, float far);
+GL_MATRIX_API void mat4_perspective(float* dst, float fovy, float aspect, float near, float far);
 
 /**
  * Generates a orthogonal projection matrix with the given bounds
@@ -357,7 +477,7 @@ void mat4_perspective(float* dst, float fovy, float aspect, float near, float fa
  * @param {number} near Near bound of the frustum
  * @param {number} far Far bound of the frustum
  */
-void mat4_ortho(float* dst, float left, float right, float bottom, float top, float near, float far);
+GL_MATRIX_API void mat4_ortho(float* dst, float left, float right, float bottom, float top, float near, float far);
 
 /**
  * Generates a look-at matrix with the given eye position, focal point, and up axis.
@@ -369,7 +489,7 @@ void mat4_ortho(float* dst, float left, float right, float bottom, float top, fl
  * @param {vec3} up vec3 pointing up
  * @returns {mat4} out
  */
-void mat4_lookAt(float* dst, float* eye, float* center, float* up);
+GL_MATRIX_API void mat4_lookAt(float* dst, float* eye, float* center, float* up);
 
 /**
  * Generates a matrix that makes something look at something else.
@@ -380,7 +500,7 @@ void mat4_lookAt(float* dst, float* eye, float* center, float* up);
  * @param {vec3} up vec3 pointing up
  * @returns {mat4} out
  */
-void mat4_targetTo(float* dst, float* eye, float* target, float* up);
+GL_MATRIX_API void mat4_targetTo(float* dst, float* eye, float* target, float* up);
 
 /**
  * Returns Frobenius norm of a mat4
@@ -388,7 +508,7 @@ void mat4_targetTo(float* dst, float* eye, float* target, float* up);
  * @param {mat4} a the matrix to calculate Frobenius norm of
  * @returns {Number} Frobenius norm
  */
-float mat4_frob(float* a);
+GL_MATRIX_API float mat4_frob(float* a);
 
 /**
  * Adds two mat4's
@@ -396,7 +516,7 @@ float mat4_frob(float* a);
  * @param {mat4} out the receiving matrix
  * @param {mat4} b the second operand
  */
-void mat4_add(float* dst, float* b);
+GL_MATRIX_API void mat4_add(float* dst, float* b);
 
 /**
  * Subtracts matrix b from matrix a
@@ -404,7 +524,7 @@ void mat4_add(float* dst, float* b);
  * @param {mat4} out the receiving matrix
  * @param {mat4} b the second operand
  */
-void mat4_subtract(float* dst, float* b);
+GL_MATRIX_API void mat4_subtract(float* dst, float* b);
 
 /**
  * Multiply each element of the matrix by a scalar.
@@ -412,7 +532,7 @@ void mat4_subtract(float* dst, float* b);
  * @param {mat4} out the receiving matrix
  * @param {Number} b amount to scale the matrix's elements by
  */
-void mat4_multiplyScalar(float* dst, float b);
+GL_MATRIX_API void mat4_multiplyScalar(float* dst, float b);
 
 /**
  * Adds two mat4's after multiplying each element of the second operand by a scalar value.
@@ -421,7 +541,7 @@ void mat4_multiplyScalar(float* dst, float b);
  * @param {mat4} b the second operand
  * @param {Number} scale the amount to scale b's elements by before adding
  */
-void mat4_multiplyScalarAndAdd(float* dst, float* b, float scale);
+GL_MATRIX_API void mat4_multiplyScalarAndAdd(float* dst, float* b, float scale);
 
 /**
  * Returns whether or not the matrices have exactly the same elements.
@@ -430,6 +550,56 @@ void mat4_multiplyScalarAndAdd(float* dst, float* b, float scale);
  * @param {mat4} b The second matrix.
  * @returns {uint8_t} True if the matrices are equal, false otherwise.
  */
-uint8_t mat4_equals(float* a, float* b);
+GL_MATRIX_API uint8_t mat4_equals(float* a, float* b);
+
+/*
+ * Initializers for constant matrices. Each expands to a braced list with
+ * the same elements, rounded the same way, as the function of the same
+ * name, so with constant arguments it folds at compile time and the matrix
+ * lands in .rodata:
+ *
+ *     static const float proj[16] = MAT4_PERSPECTIVE(1.0f, 16.0f / 9, 0.1f, 100);
+ *
+ * The arguments are evaluated more than once. MAT4_PERSPECTIVE takes a tangent,
+ * which GCC folds for constant arguments but ISO C does not allow in a
+ * static initializer.
+ */
+#define MAT4_IDENTITY { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 }
+
+#define MAT4_FROM_TRANSLATION(x, y, z) { \
+    1, 0, 0, 0, \
+    0, 1, 0, 0, \
+    0, 0, 1, 0, \
+    (float)(x), (float)(y), (float)(z), 1 }
+
+#define MAT4_FROM_SCALING(x, y, z) { \
+    (float)(x), 0, 0, 0, \
+    0, (float)(y), 0, 0, \
+    0, 0, (float)(z), 0, \
+    0, 0, 0, 1 }
+
+#define MAT4_FRUSTUM(left, right, bottom, top, near, far) { \
+    ((float)(near) * 2) * (1 / ((float)(right) - (float)(left))), 0, 0, 0, \
+    0, ((float)(near) * 2) * (1 / ((float)(top) - (float)(bottom))), 0, 0, \
+    ((float)(right) + (float)(left)) * (1 / ((float)(right) - (float)(left))), \
+    ((float)(top) + (float)(bottom)) * (1 / ((float)(top) - (float)(bottom))), \
+    ((float)(far) + (float)(near)) * (1 / ((float)(near) - (float)(far))), -1, \
+    0, 0, ((float)(far) * (float)(near) * 2) * (1 / ((float)(near) - (float)(far))), 0 }
+
+#define MAT4_PERSPECTIVE(fovy, aspect, near, far) { \
+    (float)(1.0 / tanf((float)(fovy) / 2)) / (float)(aspect), 0, 0, 0, \
+    0, (float)(1.0 / tanf((float)(fovy) / 2)), 0, 0, \
+    0, 0, (float)(far) != 0 && (float)(far) != FLT_MAX ? \
+        ((float)(far) + (float)(near)) * (1 / ((float)(near) - (float)(far))) : -1, -1, \
+    0, 0, (float)(far) != 0 && (float)(far) != FLT_MAX ? \
+        (2 * (float)(far) * (float)(near)) * (1 / ((float)(near) - (float)(far))) : -2 * (float)(near), 0 }
+
+#define MAT4_ORTHO(left, right, bottom, top, near, far) { \
+    -2 * (1 / ((float)(left) - (float)(right))), 0, 0, 0, \
+    0, -2 * (1 / ((float)(bottom) - (float)(top))), 0, 0, \
+    0, 0, 2 * (1 / ((float)(near) - (float)(far))), 0, \
+    ((float)(left) + (float)(right)) * (1 / ((float)(left) - (float)(right))), \
+    ((float)(top) + (float)(bottom)) * (1 / ((float)(bottom) - (float)(top))), \
+    ((float)(far) + (float)(near)) * (1 / ((float)(near) - (float)(far))), 1 }
 
 #endif
@@ -0,0 +1,510 @@
+#include "mat4x3.h"
+#include "vec3.h"
+#include "cpu.h"
+#include "simd.h"
+#include <string.h>
+
+// The SSE4.1 multiply kernel does the same operations in the same order as
+// the scalar code, so both paths give the same results. The AVX2 kernel
+// computes two columns per instruction and fuses the multiply-adds, like
+// mat4_multiply_n. The other batch functions are left to the compiler and
+// SIMD_CLONES.
+static uint8_t mat4x3_use_sse41 = 0;
+static uint8_t mat4x3_use_avx2 = 0;
+
+__attribute__((constructor))
+static void mat4x3_dispatch(void) {
+    uint32_t features = cpu_features();
+    mat4x3_use_sse41 = (features & CPU_SSE41) != 0;
+    mat4x3_use_avx2 = (features & CPU_AVX2) && (features & CPU_FMA);
+}
+
+/**
+ * Copies the upper three rows of mat4s into mat4x3s. The bottom rows are
+ * dropped without being checked.
+ *
+ * @param {mat4x3[]} out array of n receiving matrices, may be a itself
+ * @param {mat4[]} a array of n source matrices, packed 16 floats apart
+ * @param {Number} n number of matrices
+ */
+GL_MATRIX_API void mat4x3_fromMat4_n(float* dst, float* a, size_t n) {
+    size_t i;
+
+    // Forwards, so that a may be dst: no element moves up
+    for (i = 0; i < n; i++, dst += 12, a += 16) {
+        dst[0] = a[0];
+        dst[1] = a[1];
+        dst[2] = a[2];
+        dst[3] = a[4];
+        dst[4] = a[5];
+        dst[5] = a[6];
+        dst[6] = a[8];
+        dst[7] = a[9];
+        dst[8] = a[10];
+        dst[9] = a[12];
+        dst[10] = a[13];
+        dst[11] = a[14];
+    }
+}
+
+/**
+ * Expands mat4x3s into mat4s with a [0, 0, 0, 1] bottom row.
+ *
+ * @param {mat4[]} out array of n receiving matrices, packed 16 floats apart, may be a itself
+ * @param {mat4x3[]} a array of n source matrices
+ * @param {Number} n number of matrices
+ */
+GL_MATRIX_API void mat4x3_toMat4_n(float* dst, float* a, size_t n) {
+    size_t i = n;
+
+    // Backwards, so that a may be dst: no element moves down
+    while (i--) {
+        float* m = dst + i * 16;
+        float* c = a + i * 12;
+        m[15] = 1;
+        m[14] = c[11];
+        m[13] = c[10];
+        m[12] = c[9];
+        m[11] = 0;
+        m[10] = c[8];
+        m[9] = c[7];
+        m[8] = c[6];
+        m[7] = 0;
+        m[6] = c[5];
+        m[5] = c[4];
+        m[4] = c[3];
+        m[3] = 0;
+        m[2] = c[2];
+        m[1] = c[1];
+        m[0] = c[0];
+    }
+}
+
+/**
+ * Creates mat4x3s from quaternion rotations, vector translations and
+ * vector scales, like mat4_fromRotationTranslationScale.
+ *
+ * @param {mat4x3[]} out array of n receiving matrices
+ * @param {quat[]} q array of n rotations, packed 4 floats apart
+ * @param {vec3[]} v array of n translations, packed 3 floats apart
+ * @param {vec3[]} s array of n scales, packed 3 floats apart
+ * @param {Number} n number of matrices
+ */
+GL_MATRIX_API SIMD_CLONES void mat4x3_fromRotationTranslationScale_n(float* dst, float* q, float* v, float* s, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++, dst += 12, q += 4, v += 3, s += 3) {
+        // Quaternion math
+        float x = q[0], y = q[1], z = q[2], w = q[3];
+        float x2 = x + x;
+        float y2 = y + y;
+        float z2 = z + z;
+
+        float xx = x * x2;
+        float xy = x * y2;
+        float xz = x * z2;
+        float yy = y * y2;
+        float yz = y * z2;
+        float zz = z * z2;
+        float wx = w * x2;
+        float wy = w * y2;
+        float wz = w * z2;
+        float sx = s[0];
+        float sy = s[1];
+        float sz = s[2];
+
+        dst[0] = (1 - (yy + zz)) * sx;
+        dst[1] = (xy + wz) * sx;
+        dst[2] = (xz - wy) * sx;
+        dst[3] = (xy - wz) * sy;
+        dst[4] = (1 - (xx + zz)) * sy;
+        dst[5] = (yz + wx) * sy;
+        dst[6] = (xz + wy) * sz;
+        dst[7] = (yz - wx) * sz;
+        dst[8] = (1 - (xx + yy)) * sz;
+        dst[9] = v[0];
+        dst[10] = v[1];
+        dst[11] = v[2];
+    }
+}
+
+// mat4_multiply without the terms of the implicit bottom rows: the 0s drop
+// out of the first three columns, and the 1 leaves the translation of dst
+// to be added as is
+static void mat4x3_multiply_scalar(float* dst, float* b) {
+    float a00 = dst[0], a01 = dst[1], a02 = dst[2];
+    float a10 = dst[3], a11 = dst[4], a12 = dst[5];
+    float a20 = dst[6], a21 = dst[7], a22 = dst[8];
+    float a30 = dst[9], a31 = dst[10], a32 = dst[11];
+
+    // Cache only the current line of the second matrix
+    float b0 = b[0], b1 = b[1], b2 = b[2];
+    dst[0] = b0*a00 + b1*a10 + b2*a20;
+    dst[1] = b0*a01 + b1*a11 + b2*a21;
+    dst[2] = b0*a02 + b1*a12 + b2*a22;
+
+    b0 = b[3]; b1 = b[4]; b2 = b[5];
+    dst[3] = b0*a00 + b1*a10 + b2*a20;
+    dst[4] = b0*a01 + b1*a11 + b2*a21;
+    dst[5] = b0*a02 + b1*a12 + b2*a22;
+
+    b0 = b[6]; b1 = b[7]; b2 = b[8];
+    dst[6] = b0*a00 + b1*a10 + b2*a20;
+    dst[7] = b0*a01 + b1*a11 + b2*a21;
+    dst[8] = b0*a02 + b1*a12 + b2*a22;
+
+    b0 = b[9]; b1 = b[10]; b2 = b[11];
+    dst[9] = b0*a00 + b1*a10 + b2*a20 + a30;
+    dst[10] = b0*a01 + b1*a11 + b2*a21 + a31;
+    dst[11] = b0*a02 + b1*a12 + b2*a22 + a32;
+}
+
+#if GL_MATRIX_SIMD
+// Columns of a mat4x3 in the low three lanes, from three loads that do not
+// overlap. The fourth lanes hold the first element of the next column.
+SIMD_SSE41 static SIMD_INLINE void mat4x3_load_sse41(__m128* c, float* a) {
+    __m128i l0 = _mm_castps_si128(_mm_loadu_ps(a));
+    __m128i l1 = _mm_castps_si128(_mm_loadu_ps(a + 4));
+    __m128i l2 = _mm_castps_si128(_mm_loadu_ps(a + 8));
+    c[0] = _mm_castsi128_ps(l0);
+    c[1] = _mm_castsi128_ps(_mm_alignr_epi8(l1, l0, 12));
+    c[2] = _mm_castsi128_ps(_mm_alignr_epi8(l2, l1, 8));
+    c[3] = _mm_castsi128_ps(_mm_alignr_epi8(l2, l2, 4));
+}
+
+// Packs the low three lanes of the columns back into three stores
+SIMD_SSE41 static SIMD_INLINE void mat4x3_store_sse41(float* dst, __m128* c) {
+    __m128 tail = _mm_shuffle_ps(c[3], c[3], _MM_SHUFFLE(2, 1, 0, 0));
+    _mm_storeu_ps(dst, _mm_blend_ps(c[0], _mm_shuffle_ps(c[1], c[1], 0x00), 0x8));
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(c[1], c[2], _MM_SHUFFLE(1, 0, 2, 1)));
+    _mm_storeu_ps(dst + 8, _mm_blend_ps(tail, _mm_shuffle_ps(c[2], c[2], 0xaa), 0x1));
+}
+
+// Same evaluation order as the scalar path, so results are bit-identical.
+// bs holds the elements of b, each splat across a register.
+SIMD_SSE41 static SIMD_INLINE void mat4x3_multiply_sse41(float* dst, __m128* bs) {
+    __m128 a[4], r[4];
+
+    // Unrolled by hand, so that everything stays in registers
+    mat4x3_load_sse41(a, dst);
+    r[0] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bs[0], a[0]), _mm_mul_ps(bs[1], a[1])), _mm_mul_ps(bs[2], a[2]));
+    r[1] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bs[3], a[0]), _mm_mul_ps(bs[4], a[1])), _mm_mul_ps(bs[5], a[2]));
+    r[2] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bs[6], a[0]), _mm_mul_ps(bs[7], a[1])), _mm_mul_ps(bs[8], a[2]));
+    r[3] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bs[9], a[0]), _mm_mul_ps(bs[10], a[1])), _mm_mul_ps(bs[11], a[2]));
+    r[3] = _mm_add_ps(r[3], a[3]);
+    mat4x3_store_sse41(dst, r);
+}
+
+SIMD_SSE41 static SIMD_INLINE void mat4x3_splat_sse41(__m128* bs, float* b) {
+    uint8_t k;
+    for (k = 0; k < 12; k++) {
+        bs[k] = _mm_set1_ps(b[k]);
+    }
+}
+
+SIMD_SSE41 static void mat4x3_multiply_n_sse41(float* dst, float* b, size_t n) {
+    __m128 bs[12];
+    size_t i;
+
+    mat4x3_splat_sse41(bs, b);
+    for (i = 0; i < n; i++) {
+        mat4x3_multiply_sse41(dst + i * 12, bs);
+    }
+}
+
+SIMD_SSE41 static void mat4x3_multiplyPairwise_n_sse41(float* dst, float* b, size_t n) {
+    __m128 bs[12];
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        mat4x3_splat_sse41(bs, b + i * 12);
+        mat4x3_multiply_sse41(dst + i * 12, bs);
+    }
+}
+
+// Columns 0 and 1 of the result in one register, 2 and 3 in the other. bs
+// holds the elements of b splat across both halves the same way.
+SIMD_AVX2 static SIMD_INLINE void mat4x3_multiply_avx2(float* dst, __m256* bs) {
+    __m256 a0 = _mm256_broadcast_ps((__m128*)dst);
+    __m256 a1 = _mm256_broadcast_ps((__m128*)(dst + 3));
+    __m256 a2 = _mm256_broadcast_ps((__m128*)(dst + 6));
+    __m128 tail = _mm_loadu_ps(dst + 8);
+    __m256 t = _mm256_insertf128_ps(_mm256_setzero_ps(), _mm_shuffle_ps(tail, tail, _MM_SHUFFLE(3, 3, 2, 1)), 1);
+
+    __m256 r01 = _mm256_fmadd_ps(bs[2], a2, _mm256_fmadd_ps(bs[1], a1, _mm256_mul_ps(bs[0], a0)));
+    __m256 r23 = _mm256_fmadd_ps(bs[5], a2, _mm256_fmadd_ps(bs[4], a1, _mm256_fmadd_ps(bs[3], a0, t)));
+
+    // Drop the fourth lanes: [r0 r1 r2.xy] and [r2.z r3] are the 12 floats
+    __m256 head = _mm256_permutevar8x32_ps(r01, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 0, 0));
+    __m256 rest = _mm256_permutevar8x32_ps(r23, _mm256_setr_epi32(2, 4, 5, 6, 0, 0, 0, 1));
+    _mm256_storeu_ps(dst, _mm256_blend_ps(head, rest, 0xc0));
+    _mm_storeu_ps(dst + 8, _mm256_castps256_ps128(rest));
+}
+
+// Broadcasts from memory and blends, which keeps the shuffle port free for
+// mat4x3_multiply_avx2 when b changes with every matrix
+SIMD_AVX2 static SIMD_INLINE void mat4x3_splat_avx2(__m256* bs, float* b) {
+    uint8_t k;
+    for (k = 0; k < 3; k++) {
+        bs[k] = _mm256_blend_ps(_mm256_broadcast_ss(b + k), _mm256_broadcast_ss(b + k + 3), 0xf0);
+        bs[3 + k] = _mm256_blend_ps(_mm256_broadcast_ss(b + k + 6), _mm256_broadcast_ss(b + k + 9), 0xf0);
+    }
+}
+
+SIMD_AVX2 static void mat4x3_multiply_n_avx2(float* dst, float* b, size_t n) {
+    __m256 bs[6];
+    size_t i;
+
+    mat4x3_splat_avx2(bs, b);
+    for (i = 0; i < n; i++) {
+        mat4x3_multiply_avx2(dst + i * 12, bs);
+    }
+}
+
+SIMD_AVX2 static void mat4x3_multiplyPairwise_n_avx2(float* dst, float* b, size_t n) {
+    __m256 bs[6];
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        mat4x3_splat_avx2(bs, b + i * 12);
+        mat4x3_multiply_avx2(dst + i * 12, bs);
+    }
+}
+#endif
+
+/**
+ * Multiplies each mat4x3 in an array by the same mat4x3
+ * Equivalent to mat4_multiply_n on the expanded matrices, without the terms
+ * of their bottom rows. As there, the SSE4.1 kernel is bit-identical to the
+ * scalar code, and the AVX2/FMA kernel may differ from it by a few ULP.
+ *
+ * @param {mat4x3[]} out array of n receiving matrices
+ * @param {mat4x3} b the shared operand, must not point into out
+ * @param {Number} n number of matrices in out
+ */
+GL_MATRIX_API void mat4x3_multiply_n(float* dst, float* b, size_t n) {
+    size_t i;
+#if GL_MATRIX_SIMD
+    if (mat4x3_use_avx2) {
+        mat4x3_multiply_n_avx2(dst, b, n);
+        return;
+    }
+    if (mat4x3_use_sse41) {
+        mat4x3_multiply_n_sse41(dst, b, n);
+        return;
+    }
+#endif
+    for (i = 0; i < n; i++) {
+        mat4x3_multiply_scalar(dst + i * 12, b);
+    }
+}
+
+/**
+ * Multiplies two arrays of mat4x3s element by element
+ * Equivalent to mat4x3_multiply_n(dst + i * 12, b + i * 12, 1) for every i.
+ *
+ * @param {mat4x3[]} out array of n receiving matrices
+ * @param {mat4x3[]} b array of n operands, must not overlap out
+ * @param {Number} n number of matrices in each array
+ */
+GL_MATRIX_API void mat4x3_multiplyPairwise_n(float* dst, float* b, size_t n) {
+    size_t i;
+#if GL_MATRIX_SIMD
+    if (mat4x3_use_avx2) {
+        mat4x3_multiplyPairwise_n_avx2(dst, b, n);
+        return;
+    }
+    if (mat4x3_use_sse41) {
+        mat4x3_multiplyPairwise_n_sse41(dst, b, n);
+        return;
+    }
+#endif
+    for (i = 0; i < n; i++) {
+        mat4x3_multiply_scalar(dst + i * 12, b + i * 12);
+    }
+}
+
+// mat3_invert on the 3x3 block, then the translation moved through it.
+// Returns 0, leaving dst unchanged, if it is singular.
+static uint8_t mat4x3_invert_scalar(float* dst) {
+    float a00 = dst[0], a01 = dst[1], a02 = dst[2];
+    float a10 = dst[3], a11 = dst[4], a12 = dst[5];
+    float a20 = dst[6], a21 = dst[7], a22 = dst[8];
+    float tx = dst[9], ty = dst[10], tz = dst[11];
+
+    float b01 = a22 * a11 - a12 * a21;
+    float b11 = -a22 * a10 + a12 * a20;
+    float b21 = a21 * a10 - a11 * a20;
+
+    // Calculate the determinant
+    float det = a00 * b01 + a01 * b11 + a02 * b21;
+
+    if (!det) {
+        return 0;
+    }
+    det = 1.0 / det;
+
+    dst[0] = b01 * det;
+    dst[1] = (-a22 * a01 + a02 * a21) * det;
+    dst[2] = (a12 * a01 - a02 * a11) * det;
+    dst[3] = b11 * det;
+    dst[4] = (a22 * a00 - a02 * a20) * det;
+    dst[5] = (-a12 * a00 + a02 * a10) * det;
+    dst[6] = b21 * det;
+    dst[7] = (-a21 * a00 + a01 * a20) * det;
+    dst[8] = (a11 * a00 - a01 * a10) * det;
+
+    dst[9] = -(dst[0] * tx + dst[3] * ty + dst[6] * tz);
+    dst[10] = -(dst[1] * tx + dst[4] * ty + dst[7] * tz);
+    dst[11] = -(dst[2] * tx + dst[5] * ty + dst[8] * tz);
+    return 1;
+}
+
+#if GL_MATRIX_SIMD
+// Eight matrices at a time, element k of all of them in one register, with
+// the same operations as the scalar code and no FMA, so the results are
+// the same. Returns how many matrices it processed.
+SIMD_AVX2_NOFMA static size_t mat4x3_invert_n_avx2(float* dst, uint8_t* ok, size_t n, size_t* inverted) {
+    __m256 zero = _mm256_setzero_ps();
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    size_t i;
+    uint8_t j;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        float* p = dst + i * 12;
+        // m holds elements 0 to 7 and h elements 4 to 11
+        __m256 m[8], h[8];
+
+        for (j = 0; j < 8; j++) {
+            m[j] = _mm256_loadu_ps(p + j * 12);
+            h[j] = _mm256_loadu_ps(p + j * 12 + 4);
+        }
+        simd_transpose8_ps(m);
+        simd_transpose8_ps(h);
+
+        __m256 a00 = m[0], a01 = m[1], a02 = m[2];
+        __m256 a10 = m[3], a11 = m[4], a12 = m[5];
+        __m256 a20 = m[6], a21 = m[7], a22 = h[4];
+        __m256 tx = h[5], ty = h[6], tz = h[7];
+
+        __m256 b01 = _mm256_sub_ps(_mm256_mul_ps(a22, a11), _mm256_mul_ps(a12, a21));
+        __m256 b11 = _mm256_sub_ps(_mm256_mul_ps(a12, a20), _mm256_mul_ps(a22, a10));
+        __m256 b21 = _mm256_sub_ps(_mm256_mul_ps(a21, a10), _mm256_mul_ps(a11, a20));
+        __m256 det = _mm256_add_ps(_mm256_mul_ps(a00, b01), _mm256_mul_ps(a01, b11));
+        det = _mm256_add_ps(det, _mm256_mul_ps(a02, b21));
+
+        // Singular matrices are left unchanged, which the scalar code handles
+        if (_mm256_movemask_ps(_mm256_cmp_ps(det, zero, _CMP_EQ_OQ))) {
+            for (j = 0; j < 8; j++) {
+                uint8_t r = mat4x3_invert_scalar(p + j * 12);
+                if (ok) {
+                    ok[i + j] = r;
+                }
+                *inverted += r;
+            }
+            continue;
+        }
+
+        __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+        m[0] = _mm256_mul_ps(b01, inv);
+        m[1] = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(a02, a21), _mm256_mul_ps(a22, a01)), inv);
+        m[2] = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(a12, a01), _mm256_mul_ps(a02, a11)), inv);
+        m[3] = _mm256_mul_ps(b11, inv);
+        m[4] = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(a22, a00), _mm256_mul_ps(a02, a20)), inv);
+        m[5] = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(a02, a10), _mm256_mul_ps(a12, a00)), inv);
+        m[6] = _mm256_mul_ps(b21, inv);
+        m[7] = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(a01, a20), _mm256_mul_ps(a21, a00)), inv);
+        h[0] = m[4];
+        h[1] = m[5];
+        h[2] = m[6];
+        h[3] = m[7];
+        h[4] = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(a11, a00), _mm256_mul_ps(a01, a10)), inv);
+        for (j = 0; j < 3; j++) {
+            __m256 t = _mm256_add_ps(_mm256_mul_ps(m[j], tx), _mm256_mul_ps(m[j + 3], ty));
+            t = _mm256_add_ps(t, _mm256_mul_ps(j < 2 ? m[j + 6] : h[4], tz));
+            h[5 + j] = _mm256_xor_ps(t, sign);
+        }
+
+        simd_transpose8_ps(m);
+        simd_transpose8_ps(h);
+        for (j = 0; j < 8; j++) {
+            _mm256_storeu_ps(p + j * 12, m[j]);
+            _mm_storeu_ps(p + j * 12 + 8, _mm256_extractf128_ps(h[j], 1));
+        }
+        if (ok) {
+            memset(ok + i, 1, 8);
+        }
+        *inverted += 8;
+    }
+    return i;
+}
+#endif
+
+/**
+ * Inverts each mat4x3 in an array
+ * The 3x3 block is inverted like mat3_invert and the translation moved
+ * through it. The AVX2 kernel inverts eight matrices at a time and gives
+ * the same results. Singular matrices are left unchanged.
+ *
+ * @param {mat4x3[]} out array of n receiving matrices
+ * @param {uint8_t[]} ok receives 1 for each inverted matrix and 0 for each singular one, may be NULL
+ * @param {Number} n number of matrices in out
+ * @returns {Number} number of matrices that were inverted
+ */
+GL_MATRIX_API size_t mat4x3_invert_n(float* dst, uint8_t* ok, size_t n) {
+    size_t i = 0, inverted = 0;
+
+#if GL_MATRIX_SIMD
+    if (mat4x3_use_avx2) {
+        i = mat4x3_invert_n_avx2(dst, ok, n, &inverted);
+    }
+#endif
+    for (; i < n; i++) {
+        uint8_t r = mat4x3_invert_scalar(dst + i * 12);
+        if (ok) {
+            ok[i] = r;
+        }
+        inverted += r;
+    }
+    return inverted;
+}
+
+/**
+ * Transforms an array of points with a mat4x3, the same way as
+ * vec3_transformMat4Affine_n.
+ *
+ * @param {vec3[]} out the receiving points
+ * @param {Number} dst_stride floats between the start of each receiving point, 0 if tightly packed
+ * @param {vec3[]} a the source points, may be out itself when the strides match
+ * @param {Number} src_stride floats between the start of each source point, 0 if tightly packed
+ * @param {mat4x3} m matrix to transform with
+ * @param {Number} n number of points to transform
+ */
+GL_MATRIX_API void mat4x3_transformPoint_n(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n) {
+    float expanded[16];
+
+    // The vec3 kernels only read the affine part of the expanded matrix
+    mat4x3_toMat4_n(expanded, m, 1);
+    vec3_transformMat4Affine_n(dst, dst_stride, src, src_stride, expanded, n);
+}
+
+/**
+ * Transforms an array of directions with a mat4x3, ignoring its
+ * translation.
+ *
+ * @param {vec3[]} out the receiving vectors
+ * @param {Number} dst_stride floats between the start of each receiving vector, 0 if tightly packed
+ * @param {vec3[]} a the source vectors, may be out itself when the strides match
+ * @param {Number} src_stride floats between the start of each source vector, 0 if tightly packed
+ * @param {mat4x3} m matrix to transform with
+ * @param {Number} n number of vectors to transform
+ */
+GL_MATRIX_API void mat4x3_transformVector_n(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n) {
+    float expanded[16];
+
+    mat4x3_toMat4_n(expanded, m, 1);
+    expanded[12] = 0;
+    expanded[13] = 0;
+    expanded[14] = 0;
+    vec3_transformMat4Affine_n(dst, dst_stride, src, src_stride, expanded, n);
+}
@@ -0,0 +1,109 @@
+#ifndef MAT4X3_H
+#define MAT4X3_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+
+/**
+ * Affine transforms in 12 floats: the four columns of a mat4 without its
+ * bottom row, which is implicitly [0, 0, 0, 1]. The columns are packed 3
+ * floats apart, so the translation is in elements 9 to 11. An instance
+ * buffer of mat4x3s is a quarter smaller than one of mat4s, and composing
+ * them skips the projective row. Every function works on an array of
+ * matrices packed 12 floats apart; pass n = 1 for a single one.
+ */
+
+/**
+ * Copies the upper three rows of mat4s into mat4x3s. The bottom rows are
+ * dropped without being checked.
+ *
+ * @param {mat4x3[]} out array of n receiving matrices, may be a itself
+ * @param {mat4[]} a array of n source matrices, packed 16 floats apart
+ * @param {Number} n number of matrices
+ */
+GL_MATRIX_API void mat4x3_fromMat4_n(float* dst, float* a, size_t n);
+
+/**
+ * Expands mat4x3s into mat4s with a [0, 0, 0, 1] bottom row.
+ *
+ * @param {mat4[]} out array of n receiving matrices, packed 16 floats apart, may be a itself
+ * @param {mat4x3[]} a array of n source matrices
+ * @param {Number} n number of matrices
+ */
+GL_MATRIX_API void mat4x3_toMat4_n(float* dst, float* a, size_t n);
+
+/**
+ * Creates mat4x3s from quaternion rotations, vector translations and
+ * vector scales, like mat4_fromRotationTranslationScale.
+ *
+ * @param {mat4x3[]} out array of n receiving matrices
+ * @param {quat[]} q array of n rotations, packed 4 floats apart
+ * @param {vec3[]} v array of n translations, packed 3 floats apart
+ * @param {vec3[]} s array of n scales, packed 3 floats apart
+ * @param {Number} n number of matrices
+ */
+GL_MATRIX_API void mat4x3_fromRotationTranslationScale_n(float* dst, float* q, float* v, float* s, size_t n);
+
+/**
+ * Multiplies each mat4x3 in an array by the same mat4x3
+ * Equivalent to mat4_multiply_n on the expanded matrices, without the terms
+ * of their bottom rows. As there, the SSE4.1 kernel is bit-identical to the
+ * scalar code, and the AVX2/FMA kernel may differ from it by a few ULP.
+ *
+ * @param {mat4x3[]} out array of n receiving matrices
+ * @param {mat4x3} b the shared operand, must not point into out
+ * @param {Number} n number of matrices in out
+ */
+GL_MATRIX_API void mat4x3_multiply_n(float* dst, float* b, size_t n);
+
+/**
+ * Multiplies two arrays of mat4x3s element by element
+ * Equivalent to mat4x3_multiply_n(dst + i * 12, b + i * 12, 1) for every i.
+ *
+ * @param {mat4x3[]} out array of n receiving matrices
+ * @param {mat4x3[]} b array of n operands, must not overlap out
+ * @param {Number} n number of matrices in each array
+ */
+GL_MATRIX_API void mat4x3_multiplyPairwise_n(float* dst, float* b, size_t n);
+
+/**
+ * Inverts each mat4x3 in an array
+ * The 3x3 block is inverted like mat3_invert and the translation moved
+ * through it. The AVX2 kernel inverts eight matrices at a time and gives
+ * the same results. Singular matrices are left unchanged.
+ *
+ * @param {mat4x3[]} out array of n receiving matrices
+ * @param {uint8_t[]} ok receives 1 for each inverted matrix and 0 for each singular one, may be NULL
+ * @param {Number} n number of matrices in out
+ * @returns {Number} number of matrices that were inverted
+ */
+GL_MATRIX_API size_t mat4x3_invert_n(float* dst, uint8_t* ok, size_t n);
+
+/**
+ * Transforms an array of points with a mat4x3, the same way as
+ * vec3_transformMat4Affine_n.
+ *
+ * @param {vec3[]} out the receiving points
+ * @param {Number} dst_stride floats between the start of each receiving point, 0 if tightly packed
+ * @param {vec3[]} a the source points, may be out itself when the strides match
+ * @param {Number} src_stride floats between the start of each source point, 0 if tightly packed
+ * @param {mat4x3} m matrix to transform with
+ * @param {Number} n number of points to transform
+ */
+GL_MATRIX_API void mat4x3_transformPoint_n(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n);
+
+/**
+ * Transforms an array of directions with a mat4x3, ignoring its
+ * translation.
+ *
+ * @param {vec3[]} out the receiving vectors
+ * @param {Number} dst_stride floats between the start of each receiving vector, 0 if tightly packed
+ * @param {vec3[]} a the source vectors, may be out itself when the strides match
+ * @param {Number} src_stride floats between the start of each source vector, 0 if tightly packed
+ * @param {mat4x3} m matrix to transform with
+ * @param {Number} n number of vectors to transform
+ */
+GL_MATRIX_API void mat4x3_transformVector_n(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n);
+
+#endif
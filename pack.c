@@ -0,0 +1,444 @@
+#include "pack.h"
+#include "cpu.h"
+#include "simd.h"
+#include <math.h>
+
+// The kernels handle whole blocks and return how many components or
+// vectors they processed; the scalar loops in the public functions finish
+// the tail. They use no FMA, so both paths give the same results.
+static uint8_t pack_use_f16c = 0;
+static uint8_t pack_use_avx2 = 0;
+
+__attribute__((constructor))
+static void pack_dispatch(void) {
+    uint32_t features = cpu_features();
+    pack_use_f16c = (features & CPU_F16C) != 0;
+    pack_use_avx2 = (features & CPU_AVX2) != 0;
+}
+
+typedef union {
+    float f;
+    uint32_t u;
+} pack_bits;
+
+/**
+ * Converts a float to a half float
+ *
+ * @param {Number} a the float to convert
+ * @returns {uint16_t} the half float bits
+ */
+GL_MATRIX_API uint16_t pack_toHalf(float a) {
+    // From Fabian Giesen's float_to_half_fast3_rtne, with NaN payloads
+    // kept like the F16C instruction does
+    pack_bits v = { a };
+    pack_bits denorm_magic = { .u = ((127 - 15) + (23 - 10) + 1) << 23 };
+    uint32_t sign = v.u & 0x80000000u;
+    uint16_t o;
+
+    v.u ^= sign;
+    if (v.u >= (127 + 16) << 23) {
+        // Overflow to infinity, or NaN
+        o = v.u > 0x7f800000u ? 0x7e00 | (v.u >> 13 & 0x3ff) : 0x7c00;
+    }
+    else if (v.u < 113 << 23) {
+        // Half denormal or zero, rounded by the float addition
+        v.f += denorm_magic.f;
+        o = v.u - denorm_magic.u;
+    }
+    else {
+        uint32_t odd = (v.u >> 13) & 1;
+        v.u += ((uint32_t)(15 - 127) << 23) + 0xfff + odd;
+        o = v.u >> 13;
+    }
+    return o | sign >> 16;
+}
+
+/**
+ * Converts a half float to a float
+ *
+ * @param {uint16_t} a the half float bits
+ * @returns {Number} the float value
+ */
+GL_MATRIX_API float pack_fromHalf(uint16_t a) {
+    pack_bits magic = { .u = 113 << 23 };
+    pack_bits o = { .u = (uint32_t)(a & 0x7fff) << 13 };
+    uint32_t exp = o.u & (0x7c00 << 13);
+
+    o.u += (127 - 15) << 23;
+    if (exp == 0x7c00 << 13) {
+        // Infinity or NaN, NaNs come out quiet
+        o.u += (128 - 16) << 23;
+        if (o.u & 0x7fffff) {
+            o.u |= 0x400000;
+        }
+    }
+    else if (exp == 0) {
+        // Denormal
+        o.u += 1 << 23;
+        o.f -= magic.f;
+    }
+    o.u |= (uint32_t)(a & 0x8000) << 16;
+    return o.f;
+}
+
+// Rounds to nearest even like the SIMD conversions, for |a| < 2^22 and
+// without a libm call
+static float pack_round(float a) {
+    return (a + 12582912.0f) - 12582912.0f;
+}
+
+static int16_t pack_toSnorm16(float a) {
+    float c = a > -1 ? a : -1;
+    c = c < 1 ? c : 1;
+    return (int16_t)pack_round(c * 32767);
+}
+
+static float pack_fromSnorm16(int16_t a) {
+    float c = a / 32767.0f;
+    return c > -1 ? c : -1;
+}
+
+static uint8_t pack_toUnorm8(float a) {
+    float c = a > 0 ? a : 0;
+    c = c < 1 ? c : 1;
+    return (uint8_t)pack_round(c * 255);
+}
+
+/**
+ * Encodes a unit vector as two snorm16 octahedral coordinates. Decoded
+ * normals are within 0.004 degrees of the original.
+ *
+ * @param {int16_t[2]} out the receiving encoded normal
+ * @param {vec3} a unit vector to encode
+ */
+GL_MATRIX_API void pack_toOctahedral(int16_t* dst, float* a) {
+    float l = fabsf(a[0]) + fabsf(a[1]) + fabsf(a[2]);
+    float x = a[0] / l, y = a[1] / l;
+
+    // Fold the lower hemisphere over the diagonals
+    if (a[2] < 0) {
+        float ox = x;
+        x = (1 - fabsf(y)) * (ox >= 0 ? 1.0f : -1.0f);
+        y = (1 - fabsf(ox)) * (y >= 0 ? 1.0f : -1.0f);
+    }
+    dst[0] = pack_toSnorm16(x);
+    dst[1] = pack_toSnorm16(y);
+}
+
+/**
+ * Decodes a normal encoded by pack_toOctahedral
+ *
+ * @param {vec3} out the receiving unit vector
+ * @param {int16_t[2]} a the encoded normal
+ */
+GL_MATRIX_API void pack_fromOctahedral(float* dst, int16_t* a) {
+    float x = pack_fromSnorm16(a[0]), y = pack_fromSnorm16(a[1]);
+    float z = 1 - fabsf(x) - fabsf(y);
+    float t = z < 0 ? -z : 0;
+    float len;
+
+    x += x >= 0 ? -t : t;
+    y += y >= 0 ? -t : t;
+    len = 1 / sqrtf(x * x + y * y + z * z);
+    dst[0] = x * len;
+    dst[1] = y * len;
+    dst[2] = z * len;
+}
+
+#if GL_MATRIX_SIMD
+SIMD_F16C static size_t pack_toHalf_n_f16c(uint16_t* dst, float* src, size_t n) {
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i*)(dst + i), h);
+    }
+    return i;
+}
+
+SIMD_F16C static size_t pack_fromHalf_n_f16c(float* dst, uint16_t* src, size_t n) {
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((__m128i*)(src + i))));
+    }
+    return i;
+}
+
+SIMD_AVX2_NOFMA static SIMD_INLINE __m256i pack_toSnorm16_avx2(__m256 a) {
+    a = _mm256_min_ps(_mm256_max_ps(a, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    return _mm256_cvtps_epi32(_mm256_mul_ps(a, _mm256_set1_ps(32767.0f)));
+}
+
+SIMD_AVX2_NOFMA static SIMD_INLINE __m256 pack_fromSnorm16_avx2(__m256i a) {
+    __m256 c = _mm256_div_ps(_mm256_cvtepi32_ps(a), _mm256_set1_ps(32767.0f));
+    return _mm256_max_ps(c, _mm256_set1_ps(-1.0f));
+}
+
+SIMD_AVX2_NOFMA static size_t pack_toSnorm16_n_avx2(int16_t* dst, float* src, size_t n) {
+    size_t i;
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m256i a = pack_toSnorm16_avx2(_mm256_loadu_ps(src + i));
+        __m256i b = pack_toSnorm16_avx2(_mm256_loadu_ps(src + i + 8));
+        // packs works within 128-bit lanes, so put the quarters back in order
+        __m256i p = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xd8);
+        _mm256_storeu_si256((__m256i*)(dst + i), p);
+    }
+    return i;
+}
+
+SIMD_AVX2_NOFMA static size_t pack_fromSnorm16_n_avx2(float* dst, int16_t* src, size_t n) {
+    size_t i;
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_loadu_si256((__m256i*)(src + i));
+        __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(v));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1));
+        _mm256_storeu_ps(dst + i, pack_fromSnorm16_avx2(lo));
+        _mm256_storeu_ps(dst + i + 8, pack_fromSnorm16_avx2(hi));
+    }
+    return i;
+}
+
+SIMD_AVX2_NOFMA static size_t pack_toUnorm8_n_avx2(uint8_t* dst, float* src, size_t n) {
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 scale = _mm256_set1_ps(255.0f);
+    __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    __m256i r[4];
+    size_t i;
+    uint8_t k;
+
+    for (i = 0; i + 32 <= n; i += 32) {
+        for (k = 0; k < 4; k++) {
+            __m256 a = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i + k * 8), zero), one);
+            r[k] = _mm256_cvtps_epi32(_mm256_mul_ps(a, scale));
+        }
+        __m256i p = _mm256_packus_epi16(_mm256_packus_epi32(r[0], r[1]), _mm256_packus_epi32(r[2], r[3]));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_permutevar8x32_epi32(p, order));
+    }
+    return i;
+}
+
+SIMD_AVX2_NOFMA static size_t pack_fromUnorm8_n_avx2(float* dst, uint8_t* src, size_t n) {
+    __m256 scale = _mm256_set1_ps(255.0f);
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_div_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+    return i;
+}
+
+SIMD_AVX2_NOFMA static size_t pack_toOctahedral_n_avx2(int16_t* dst, float* src, size_t n) {
+    __m256i idx3 = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_i32gather_ps(src + i * 3, idx3, 4);
+        __m256 y = _mm256_i32gather_ps(src + i * 3 + 1, idx3, 4);
+        __m256 z = _mm256_i32gather_ps(src + i * 3 + 2, idx3, 4);
+        __m256 l = _mm256_add_ps(_mm256_add_ps(_mm256_andnot_ps(sign, x), _mm256_andnot_ps(sign, y)), _mm256_andnot_ps(sign, z));
+        x = _mm256_div_ps(x, l);
+        y = _mm256_div_ps(y, l);
+
+        __m256 lower = _mm256_cmp_ps(z, zero, _CMP_LT_OQ);
+        __m256 sx = _mm256_blendv_ps(_mm256_set1_ps(-1.0f), one, _mm256_cmp_ps(x, zero, _CMP_GE_OQ));
+        __m256 sy = _mm256_blendv_ps(_mm256_set1_ps(-1.0f), one, _mm256_cmp_ps(y, zero, _CMP_GE_OQ));
+        __m256 fx = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(sign, y)), sx);
+        __m256 fy = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(sign, x)), sy);
+        x = _mm256_blendv_ps(x, fx, lower);
+        y = _mm256_blendv_ps(y, fy, lower);
+
+        __m256i ix = pack_toSnorm16_avx2(x);
+        __m256i iy = pack_toSnorm16_avx2(y);
+        __m256i xy = _mm256_or_si256(_mm256_and_si256(ix, _mm256_set1_epi32(0xffff)), _mm256_slli_epi32(iy, 16));
+        _mm256_storeu_si256((__m256i*)(dst + i * 2), xy);
+    }
+    return i;
+}
+
+SIMD_AVX2_NOFMA static size_t pack_fromOctahedral_n_avx2(float* dst, int16_t* src, size_t n) {
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    float out[3][8];
+    size_t i;
+    uint8_t k;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((__m256i*)(src + i * 2));
+        __m256 x = pack_fromSnorm16_avx2(_mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16));
+        __m256 y = pack_fromSnorm16_avx2(_mm256_srai_epi32(v, 16));
+        __m256 z = _mm256_sub_ps(_mm256_sub_ps(one, _mm256_andnot_ps(sign, x)), _mm256_andnot_ps(sign, y));
+        __m256 t = _mm256_max_ps(_mm256_sub_ps(zero, z), zero);
+
+        x = _mm256_blendv_ps(_mm256_add_ps(x, t), _mm256_sub_ps(x, t), _mm256_cmp_ps(x, zero, _CMP_GE_OQ));
+        y = _mm256_blendv_ps(_mm256_add_ps(y, t), _mm256_sub_ps(y, t), _mm256_cmp_ps(y, zero, _CMP_GE_OQ));
+        __m256 len = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+        len = _mm256_div_ps(one, _mm256_sqrt_ps(len));
+
+        _mm256_storeu_ps(out[0], _mm256_mul_ps(x, len));
+        _mm256_storeu_ps(out[1], _mm256_mul_ps(y, len));
+        _mm256_storeu_ps(out[2], _mm256_mul_ps(z, len));
+        for (k = 0; k < 8; k++) {
+            dst[(i + k) * 3] = out[0][k];
+            dst[(i + k) * 3 + 1] = out[1][k];
+            dst[(i + k) * 3 + 2] = out[2][k];
+        }
+    }
+    return i;
+}
+#endif
+
+/**
+ * Converts an array of floats to half floats
+ *
+ * @param {uint16_t[]} out array of n receiving half floats
+ * @param {Number[]} src array of n floats
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_toHalf_n(uint16_t* dst, float* src, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (pack_use_f16c) {
+        i = pack_toHalf_n_f16c(dst, src, n);
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = pack_toHalf(src[i]);
+    }
+}
+
+/**
+ * Converts an array of half floats to floats
+ *
+ * @param {Number[]} out array of n receiving floats
+ * @param {uint16_t[]} src array of n half floats
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_fromHalf_n(float* dst, uint16_t* src, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (pack_use_f16c) {
+        i = pack_fromHalf_n_f16c(dst, src, n);
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = pack_fromHalf(src[i]);
+    }
+}
+
+/**
+ * Converts an array of floats to snorm16
+ *
+ * @param {int16_t[]} out array of n receiving snorm16 values
+ * @param {Number[]} src array of n floats, clamped to [-1, 1]
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_toSnorm16_n(int16_t* dst, float* src, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (pack_use_avx2) {
+        i = pack_toSnorm16_n_avx2(dst, src, n);
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = pack_toSnorm16(src[i]);
+    }
+}
+
+/**
+ * Converts an array of snorm16 values to floats in [-1, 1]
+ *
+ * @param {Number[]} out array of n receiving floats
+ * @param {int16_t[]} src array of n snorm16 values
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_fromSnorm16_n(float* dst, int16_t* src, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (pack_use_avx2) {
+        i = pack_fromSnorm16_n_avx2(dst, src, n);
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = pack_fromSnorm16(src[i]);
+    }
+}
+
+/**
+ * Converts an array of floats to unorm8
+ *
+ * @param {uint8_t[]} out array of n receiving unorm8 values
+ * @param {Number[]} src array of n floats, clamped to [0, 1]
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_toUnorm8_n(uint8_t* dst, float* src, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (pack_use_avx2) {
+        i = pack_toUnorm8_n_avx2(dst, src, n);
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = pack_toUnorm8(src[i]);
+    }
+}
+
+/**
+ * Converts an array of unorm8 values to floats in [0, 1]
+ *
+ * @param {Number[]} out array of n receiving floats
+ * @param {uint8_t[]} src array of n unorm8 values
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_fromUnorm8_n(float* dst, uint8_t* src, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (pack_use_avx2) {
+        i = pack_fromUnorm8_n_avx2(dst, src, n);
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = src[i] / 255.0f;
+    }
+}
+
+/**
+ * Encodes an array of unit vectors as octahedral snorm16 pairs
+ *
+ * @param {int16_t[]} out array of n receiving encoded normals, 2 int16_t each
+ * @param {vec3[]} src array of n unit vectors, packed 3 floats apart
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void pack_toOctahedral_n(int16_t* dst, float* src, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (pack_use_avx2) {
+        i = pack_toOctahedral_n_avx2(dst, src, n);
+    }
+#endif
+    for (; i < n; i++) {
+        pack_toOctahedral(dst + i * 2, src + i * 3);
+    }
+}
+
+/**
+ * Decodes an array of octahedral snorm16 pairs
+ *
+ * @param {vec3[]} out array of n receiving unit vectors, packed 3 floats apart
+ * @param {int16_t[]} src array of n encoded normals, 2 int16_t each
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void pack_fromOctahedral_n(float* dst, int16_t* src, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (pack_use_avx2) {
+        i = pack_fromOctahedral_n_avx2(dst, src, n);
+    }
+#endif
+    for (; i < n; i++) {
+        pack_fromOctahedral(dst + i * 3, src + i * 2);
+    }
+}
@@ -0,0 +1,124 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+
+/**
+ * Conversions between float vertex data and the compact formats GPUs read
+ * directly. The array functions work on n components, so the same call
+ * packs vec2, vec3 or vec4 arrays: pass 3 * count for count vec3s.
+ *
+ * Half floats round to nearest even and keep denormals, infinities and
+ * NaNs. snorm16 and unorm8 clamp to [-1, 1] and [0, 1] and round to
+ * nearest even. The arrays are converted with F16C or AVX2 when the CPU
+ * supports them, with the same results as the scalar fallback.
+ */
+
+/**
+ * Converts a float to a half float
+ *
+ * @param {Number} a the float to convert
+ * @returns {uint16_t} the half float bits
+ */
+GL_MATRIX_API uint16_t pack_toHalf(float a);
+
+/**
+ * Converts a half float to a float
+ *
+ * @param {uint16_t} a the half float bits
+ * @returns {Number} the float value
+ */
+GL_MATRIX_API float pack_fromHalf(uint16_t a);
+
+/**
+ * Converts an array of floats to half floats
+ *
+ * @param {uint16_t[]} out array of n receiving half floats
+ * @param {Number[]} src array of n floats
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_toHalf_n(uint16_t* dst, float* src, size_t n);
+
+/**
+ * Converts an array of half floats to floats
+ *
+ * @param {Number[]} out array of n receiving floats
+ * @param {uint16_t[]} src array of n half floats
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_fromHalf_n(float* dst, uint16_t* src, size_t n);
+
+/**
+ * Converts an array of floats to snorm16
+ *
+ * @param {int16_t[]} out array of n receiving snorm16 values
+ * @param {Number[]} src array of n floats, clamped to [-1, 1]
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_toSnorm16_n(int16_t* dst, float* src, size_t n);
+
+/**
+ * Converts an array of snorm16 values to floats in [-1, 1]
+ *
+ * @param {Number[]} out array of n receiving floats
+ * @param {int16_t[]} src array of n snorm16 values
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_fromSnorm16_n(float* dst, int16_t* src, size_t n);
+
+/**
+ * Converts an array of floats to unorm8
+ *
+ * @param {uint8_t[]} out array of n receiving unorm8 values
+ * @param {Number[]} src array of n floats, clamped to [0, 1]
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_toUnorm8_n(uint8_t* dst, float* src, size_t n);
+
+/**
+ * Converts an array of unorm8 values to floats in [0, 1]
+ *
+ * @param {Number[]} out array of n receiving floats
+ * @param {uint8_t[]} src array of n unorm8 values
+ * @param {Number} n number of components
+ */
+GL_MATRIX_API void pack_fromUnorm8_n(float* dst, uint8_t* src, size_t n);
+
+/**
+ * Encodes a unit vector as two snorm16 octahedral coordinates. Decoded
+ * normals are within 0.004 degrees of the original.
+ *
+ * @param {int16_t[2]} out the receiving encoded normal
+ * @param {vec3} a unit vector to encode
+ */
+GL_MATRIX_API void pack_toOctahedral(int16_t* dst, float* a);
+
+/**
+ * Decodes a normal encoded by pack_toOctahedral
+ *
+ * @param {vec3} out the receiving unit vector
+ * @param {int16_t[2]} a the encoded normal
+ */
+GL_MATRIX_API void pack_fromOctahedral(float* dst, int16_t* a);
+
+/**
+ * Encodes an array of unit vectors as octahedral snorm16 pairs
+ *
+ * @param {int16_t[]} out array of n receiving encoded normals, 2 int16_t each
+ * @param {vec3[]} src array of n unit vectors, packed 3 floats apart
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void pack_toOctahedral_n(int16_t* dst, float* src, size_t n);
+
+/**
+ * Decodes an array of octahedral snorm16 pairs
+ *
+ * @param {vec3[]} out array of n receiving unit vectors, packed 3 floats apart
+ * @param {int16_t[]} src array of n encoded normals, 2 int16_t each
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void pack_fromOctahedral_n(float* dst, int16_t* src, size_t n);
+
+#endif
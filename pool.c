@@ -0,0 +1,222 @@
+#include "pool.h"
+#include "vec3.h"
+#include "vec4.h"
+#include "mat4.h"
+#include <string.h>
+#include <unistd.h>
+
+static size_t pool_stride(pool_op* op, size_t stride) {
+    switch (op->type) {
+        case POOL_VEC3_TRANSFORM_MAT4:
+        case POOL_VEC3_TRANSFORM_MAT4_AFFINE:
+            return stride ? stride : 3;
+        case POOL_VEC4_TRANSFORM_MAT4:
+            return stride ? stride : 4;
+        case POOL_MAT4_MULTIPLY:
+        case POOL_MAT4_MULTIPLY_PAIRWISE:
+        case POOL_MAT4_INVERT:
+            // The mat4 batch functions only take packed arrays
+            return 16;
+    }
+    return stride;
+}
+
+static void pool_execute(pool* p, size_t chunk) {
+    pool_op* op = p->op;
+    size_t begin = chunk * p->chunk;
+    size_t count = p->n - begin < p->chunk ? p->n - begin : p->chunk;
+    size_t ds = pool_stride(op, op->dst_stride);
+    size_t ss = pool_stride(op, op->src_stride);
+    float* dst = p->dst + begin * ds;
+    float* src = op->src ? op->src + begin * ss : NULL;
+
+    switch (op->type) {
+        case POOL_VEC3_TRANSFORM_MAT4:
+            vec3_transformMat4_n(dst, ds, src, ss, op->b, count);
+            break;
+        case POOL_VEC3_TRANSFORM_MAT4_AFFINE:
+            vec3_transformMat4Affine_n(dst, ds, src, ss, op->b, count);
+            break;
+        case POOL_VEC4_TRANSFORM_MAT4:
+            vec4_transformMat4_n(dst, ds, src, ss, op->b, count);
+            break;
+        case POOL_MAT4_MULTIPLY:
+            mat4_multiply_n(dst, op->b, count);
+            break;
+        case POOL_MAT4_MULTIPLY_PAIRWISE:
+            mat4_multiplyPairwise_n(dst, src, count);
+            break;
+        case POOL_MAT4_INVERT:
+            mat4_invert_n(dst, NULL, count);
+            break;
+        case POOL_CUSTOM:
+            op->fn(dst, begin, count, op->user);
+            break;
+    }
+}
+
+// Takes the first chunk of a range, used by its owner
+static uint8_t pool_pop(uint64_t* range, size_t* chunk) {
+    uint64_t r = __atomic_load_n(range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t begin = (uint32_t)r, end = (uint32_t)(r >> 32);
+        if (begin >= end) {
+            return 0;
+        }
+        if (__atomic_compare_exchange_n(range, &r, (uint64_t)end << 32 | (begin + 1), 1, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *chunk = begin;
+            return 1;
+        }
+    }
+}
+
+// Takes the last chunk of a range, used by other threads
+static uint8_t pool_steal(uint64_t* range, size_t* chunk) {
+    uint64_t r = __atomic_load_n(range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t begin = (uint32_t)r, end = (uint32_t)(r >> 32);
+        if (begin >= end) {
+            return 0;
+        }
+        if (__atomic_compare_exchange_n(range, &r, (uint64_t)(end - 1) << 32 | begin, 1, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *chunk = end - 1;
+            return 1;
+        }
+    }
+}
+
+static void pool_work(pool* p, size_t index) {
+    size_t chunk, i;
+
+    while (pool_pop(&p->slots[index].range, &chunk)) {
+        pool_execute(p, chunk);
+    }
+    // No chunks are added during a run, so one sweep over the others is enough
+    for (i = 1; i < p->count; i++) {
+        pool_slot* victim = &p->slots[(index + i) % p->count];
+        while (pool_steal(&victim->range, &chunk)) {
+            pool_execute(p, chunk);
+        }
+    }
+
+    pthread_mutex_lock(&p->lock);
+    if (--p->busy == 0) {
+        pthread_cond_signal(&p->done);
+    }
+    pthread_mutex_unlock(&p->lock);
+}
+
+static void* pool_worker(void* arg) {
+    pool_slot* slot = (pool_slot*)arg;
+    pool* p = (pool*)slot->owner;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&p->lock);
+    for (;;) {
+        while (!p->stop && p->generation == seen) {
+            pthread_cond_wait(&p->wake, &p->lock);
+        }
+        if (p->stop) {
+            break;
+        }
+        seen = p->generation;
+        pthread_mutex_unlock(&p->lock);
+        pool_work(p, slot->index);
+        pthread_mutex_lock(&p->lock);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+GL_MATRIX_API uint8_t pool_init(pool* dst, size_t threads) {
+    size_t i;
+
+    if (!threads) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+    if (threads > POOL_MAX_THREADS) {
+        threads = POOL_MAX_THREADS;
+    }
+
+    memset(dst, 0, sizeof(*dst));
+    pthread_mutex_init(&dst->lock, NULL);
+    pthread_cond_init(&dst->wake, NULL);
+    pthread_cond_init(&dst->done, NULL);
+    dst->count = 1;
+    dst->slots[0].owner = dst;
+
+    for (i = 1; i < threads; i++) {
+        dst->slots[i].owner = dst;
+        dst->slots[i].index = i;
+        if (pthread_create(&dst->threads[i], NULL, pool_worker, &dst->slots[i])) {
+            pool_destroy(dst);
+            return 0;
+        }
+        dst->count++;
+    }
+    return 1;
+}
+
+GL_MATRIX_API void pool_destroy(pool* dst) {
+    size_t i;
+
+    pthread_mutex_lock(&dst->lock);
+    dst->stop = 1;
+    pthread_cond_broadcast(&dst->wake);
+    pthread_mutex_unlock(&dst->lock);
+
+    for (i = 1; i < dst->count; i++) {
+        pthread_join(dst->threads[i], NULL);
+    }
+    dst->count = 1;
+
+    pthread_cond_destroy(&dst->done);
+    pthread_cond_destroy(&dst->wake);
+    pthread_mutex_destroy(&dst->lock);
+}
+
+GL_MATRIX_API void pool_run(pool* p, float* dst, size_t n, pool_op* op) {
+    size_t item, chunk, chunks, i;
+
+    if (!n) {
+        return;
+    }
+
+    // Bytes read and written per element
+    item = (pool_stride(op, op->dst_stride) + (op->src ? pool_stride(op, op->src_stride) : 0)) * sizeof(float);
+    chunk = item ? POOL_CHUNK_BYTES / item : POOL_CHUNK_BYTES;
+    if (!(op->flags & POOL_DETERMINISTIC)) {
+        // Fewer, larger chunks when there is plenty of work per thread
+        size_t share = n / (p->count * 4);
+        if (share > chunk) {
+            chunk = share;
+        }
+    }
+    // Multiples of 8 keep the SIMD blocks where a single call puts them
+    chunk = chunk < 8 ? 8 : chunk & ~(size_t)7;
+    chunks = (n + chunk - 1) / chunk;
+
+    pthread_mutex_lock(&p->lock);
+    p->op = op;
+    p->dst = dst;
+    p->n = n;
+    p->chunk = chunk;
+    for (i = 0; i < p->count; i++) {
+        uint64_t begin = chunks * i / p->count;
+        uint64_t end = chunks * (i + 1) / p->count;
+        __atomic_store_n(&p->slots[i].range, end << 32 | begin, __ATOMIC_RELAXED);
+    }
+    p->busy = p->count;
+    p->generation++;
+    pthread_cond_broadcast(&p->wake);
+    pthread_mutex_unlock(&p->lock);
+
+    pool_work(p, 0);
+
+    pthread_mutex_lock(&p->lock);
+    while (p->busy) {
+        pthread_cond_wait(&p->done, &p->lock);
+    }
+    pthread_mutex_unlock(&p->lock);
+}
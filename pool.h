@@ -0,0 +1,116 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+
+#define POOL_MAX_THREADS 64
+
+// Bytes of input and output per chunk, sized to stay in L1/L2
+#define POOL_CHUNK_BYTES 32768
+
+// Operation types for pool_op
+#define POOL_VEC3_TRANSFORM_MAT4 0
+#define POOL_VEC3_TRANSFORM_MAT4_AFFINE 1
+#define POOL_VEC4_TRANSFORM_MAT4 2
+#define POOL_MAT4_MULTIPLY 3
+#define POOL_MAT4_MULTIPLY_PAIRWISE 4
+#define POOL_MAT4_INVERT 5
+#define POOL_CUSTOM 6
+
+// Flags for pool_op
+#define POOL_DETERMINISTIC 0x01
+
+/**
+ * Describes the batch operation pool_run applies to an array.
+ *
+ * POOL_VEC3_TRANSFORM_MAT4          vec3_transformMat4_n(dst, dst_stride, src, src_stride, b)
+ * POOL_VEC3_TRANSFORM_MAT4_AFFINE   vec3_transformMat4Affine_n(dst, dst_stride, src, src_stride, b)
+ * POOL_VEC4_TRANSFORM_MAT4          vec4_transformMat4_n(dst, dst_stride, src, src_stride, b)
+ * POOL_MAT4_MULTIPLY                mat4_multiply_n(dst, b)
+ * POOL_MAT4_MULTIPLY_PAIRWISE       mat4_multiplyPairwise_n(dst, src)
+ * POOL_MAT4_INVERT                  mat4_invert_n(dst)
+ * POOL_CUSTOM                       fn(dst + begin * dst_stride, begin, count, user) per chunk
+ *
+ * Strides are in floats, 0 means tightly packed. The mat4 operations
+ * only work on packed arrays and ignore both strides. The custom operation
+ * uses dst_stride only to offset dst and needs it set.
+ *
+ * Chunk boundaries are always multiples of 8 elements, so the built-in
+ * operations give exactly the same output as one single-threaded call.
+ * With POOL_DETERMINISTIC the chunk boundaries also no longer depend on
+ * the thread count, for custom operations whose results depend on them.
+ */
+typedef struct {
+    uint8_t type;
+    uint8_t flags;
+    size_t dst_stride;
+    float* src;
+    size_t src_stride;
+    float* b;
+    void (*fn)(float* dst, size_t begin, size_t count, void* user);
+    void* user;
+} pool_op;
+
+// A worker's queue of chunk indices, packed as begin | end << 32
+typedef struct {
+    uint64_t range;
+    void* owner;
+    size_t index;
+} __attribute__((aligned(64))) pool_slot;
+
+/**
+ * A fixed set of worker threads that splits batch operations into chunks.
+ * Every thread starts on its own contiguous run of chunks and steals
+ * single chunks from the back of other threads' runs once its own is
+ * empty. The calling thread of pool_run takes part as worker 0.
+ *
+ * All state lives in this struct, nothing is allocated. Link with -pthread.
+ */
+typedef struct {
+    pool_slot slots[POOL_MAX_THREADS];
+    pthread_t threads[POOL_MAX_THREADS];
+    size_t count;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    uint64_t generation;
+    size_t busy;
+    uint8_t stop;
+    pool_op* op;
+    float* dst;
+    size_t n;
+    size_t chunk;
+} pool;
+
+/**
+ * Starts the worker threads of a pool
+ *
+ * @param {pool} out the pool to start
+ * @param {Number} threads total thread count including the caller, 0 for one per online CPU
+ * @returns {uint8_t} 1 if all threads were started, 0 otherwise
+ */
+GL_MATRIX_API uint8_t pool_init(pool* dst, size_t threads);
+
+/**
+ * Stops and joins the worker threads of a pool
+ *
+ * @param {pool} out the pool to stop
+ */
+GL_MATRIX_API void pool_destroy(pool* dst);
+
+/**
+ * Applies an operation to n elements across the pool's threads and
+ * returns once every element is done. Not reentrant: only one thread may
+ * call pool_run on the same pool at a time.
+ *
+ * @param {pool} p the pool
+ * @param {float[]} out the receiving array
+ * @param {Number} n number of elements
+ * @param {pool_op} op the operation to apply
+ */
+GL_MATRIX_API void pool_run(pool* p, float* dst, size_t n, pool_op* op);
+
+#endif
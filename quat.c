@@ -1,4 +1,6 @@
 #include "quat.h"
+#include "cpu.h"
+#include "simd.h"
 #include "epsilon.h"
 #include <math.h>
 
@@ -7,7 +9,7 @@
  *
  * @param {quat} out the receiving quaternion
  */
-void quat_identity(float* dst) {
+GL_MATRIX_API void quat_identity(float* dst) {
     dst[0] = 0;
     dst[1] = 0;
     dst[2] = 0;
@@ -22,7 +24,7 @@ void quat_identity(float* dst) {
  * @param {vec3} axis the axis around which to rotate
  * @param {Number} rad the angle in radians
  **/
-void quat_setAxisAngle(float* dst, float* axis, float rad) {
+GL_MATRIX_API void quat_setAxisAngle(float* dst, float* axis, float rad) {
     rad = rad * 0.5;
     float s = sinf(rad);
     dst[0] = s * axis[0];
@@ -44,7 +46,7 @@ void quat_setAxisAngle(float* dst, float* axis, float rad) {
  * @param  {quat} q     Quaternion to be decomposed
  * @return {Number}     Angle, in radians, of the rotation
  */
-float quat_getAxisAngle(float* out_axis, float* q) {
+GL_MATRIX_API float quat_getAxisAngle(float* out_axis, float* q) {
     float rad = acosf(q[3]) * 2.0;
     float s = sinf(rad / 2.0);
     if (s > EPSILON) {
@@ -67,7 +69,7 @@ float quat_getAxisAngle(float* out_axis, float* q) {
  * @param {quat} out the receiving quaternion
  * @param {quat} b the second operand
  */
-void quat_multiply(float* dst, float* b) {
+GL_MATRIX_API SIMD_CLONES void quat_multiply(float* dst, float* b) {
     float ax = dst[0], ay = dst[1], az = dst[2], aw = dst[3];
     float bx = b[0], by = b[1], bz = b[2], bw = b[3];
 
@@ -83,7 +85,7 @@ void quat_multiply(float* dst, float* b) {
  * @param {quat} out quat receiving operation result
  * @param {number} rad angle (in radians) to rotate
  */
-void quat_rotateX(float* dst, float rad) {
+GL_MATRIX_API void quat_rotateX(float* dst, float rad) {
     rad *= 0.5;
 
     float ax = dst[0], ay = dst[1], az = dst[2], aw = dst[3];
@@ -101,7 +103,7 @@ void quat_rotateX(float* dst, float rad) {
  * @param {quat} out quat receiving operation result
  * @param {number} rad angle (in radians) to rotate
  */
-void quat_rotateY(float* dst, float rad) {
+GL_MATRIX_API void quat_rotateY(float* dst, float rad) {
     rad *= 0.5;
 
     float ax = dst[0], ay = dst[1], az = dst[2], aw = dst[3];
@@ -119,7 +121,7 @@ void quat_rotateY(float* dst, float rad) {
  * @param {quat} out quat receiving operation result
  * @param {number} rad angle (in radians) to rotate
  */
-void quat_rotateZ(float* dst, float rad) {
+GL_MATRIX_API void quat_rotateZ(float* dst, float rad) {
     rad *= 0.5;
 
     float ax = dst[0], ay = dst[1], az = dst[2], aw = dst[3];
@@ -138,7 +140,7 @@ void quat_rotateZ(float* dst, float rad) {
  *
  * @param {quat} out the receiving quaternion
  */
-void quat_calculateW(float* dst) {
+GL_MATRIX_API void quat_calculateW(float* dst) {
     float x = dst[0], y = dst[1], z = dst[2];
 
     dst[0] = x;
@@ -154,7 +156,7 @@ void quat_calculateW(float* dst) {
  * @param {quat} b the second operand
  * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
  */
-void quat_slerp(float* dst, float* b, float t) {
+GL_MATRIX_API void quat_slerp(float* dst, float* b, float t) {
     // benchmarks:
     //    http://jsperf.com/quaternion-slerp-implementations
     float ax = dst[0], ay = dst[1], az = dst[2], aw = dst[3];
@@ -193,12 +195,262 @@ void quat_slerp(float* dst, float* b, float t) {
     dst[3] = scale0 * aw + scale1 * bw;
 }
 
+// Float only
+// Series coefficients for sin(t * omega) / sin(omega) in powers of
+// (cos(omega) - 1), truncated at 8 terms with the last term scaled by
+// 1 + mu to absorb the truncation error. From David Eberly, "A Fast and
+// Accurate Algorithm for Computing SLERP".
+#define QUAT_SLERP_MU 1.85298109240830f
+
+static const float quat_slerp_u[8] = {
+    1.0f / 3, 1.0f / 10, 1.0f / 21, 1.0f / 36,
+    1.0f / 55, 1.0f / 78, 1.0f / 105, QUAT_SLERP_MU / 136
+};
+
+static const float quat_slerp_v[8] = {
+    1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9,
+    5.0f / 11, 6.0f / 13, 7.0f / 15, QUAT_SLERP_MU * 8 / 17
+};
+
+static void quat_slerpPolynomial(float* dst, float* b, float t) {
+    float ax = dst[0], ay = dst[1], az = dst[2], aw = dst[3];
+    float cosom = ax * b[0] + ay * b[1] + az * b[2] + aw * b[3];
+    float sign = cosom < 0 ? -1.0 : 1.0;
+    float xm1 = fabsf(cosom) - 1;
+    float d = 1 - t;
+    float sqrT = t * t;
+    float sqrD = d * d;
+    float scale0 = 1, scale1 = 1;
+    int8_t i;
+
+    for (i = 7; i >= 0; i--) {
+        scale1 = 1 + (quat_slerp_u[i] * sqrT - quat_slerp_v[i]) * xm1 * scale1;
+        scale0 = 1 + (quat_slerp_u[i] * sqrD - quat_slerp_v[i]) * xm1 * scale0;
+    }
+    scale0 *= d;
+    scale1 *= t * sign;
+
+    dst[0] = scale0 * ax + scale1 * b[0];
+    dst[1] = scale0 * ay + scale1 * b[1];
+    dst[2] = scale0 * az + scale1 * b[2];
+    dst[3] = scale0 * aw + scale1 * b[3];
+}
+
+static void quat_nlerpCorrected(float* dst, float* b, float t) {
+    // Cubic correction of t from Arseny Kapoulkine, "Approximating slerp"
+    float ax = dst[0], ay = dst[1], az = dst[2], aw = dst[3];
+    float cosom = ax * b[0] + ay * b[1] + az * b[2] + aw * b[3];
+    float sign = cosom < 0 ? -1.0 : 1.0;
+    float d = fabsf(cosom);
+    float A = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    float B = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    float h = t - 0.5f;
+    float k = A * h * h + B;
+    float ot = t + t * h * (t - 1) * k;
+    float scale0 = 1 - ot;
+    float scale1 = ot * sign;
+    float x = scale0 * ax + scale1 * b[0];
+    float y = scale0 * ay + scale1 * b[1];
+    float z = scale0 * az + scale1 * b[2];
+    float w = scale0 * aw + scale1 * b[3];
+    float len = 1 / sqrtf(x * x + y * y + z * z + w * w);
+
+    dst[0] = x * len;
+    dst[1] = y * len;
+    dst[2] = z * len;
+    dst[3] = w * len;
+}
+
+#if GL_MATRIX_SIMD
+// In-lane 4x4 transpose: rows hold quats (2k | 2k+1), columns hold
+// components of quats [0 2 4 6 | 1 3 5 7]. Its own inverse.
+#define QUAT_TRANSPOSE8(r0, r1, r2, r3) do { \
+        __m256 t0 = _mm256_unpacklo_ps(r0, r1); \
+        __m256 t1 = _mm256_unpackhi_ps(r0, r1); \
+        __m256 t2 = _mm256_unpacklo_ps(r2, r3); \
+        __m256 t3 = _mm256_unpackhi_ps(r2, r3); \
+        r0 = _mm256_shuffle_ps(t0, t2, 0x44); \
+        r1 = _mm256_shuffle_ps(t0, t2, 0xee); \
+        r2 = _mm256_shuffle_ps(t1, t3, 0x44); \
+        r3 = _mm256_shuffle_ps(t1, t3, 0xee); \
+    } while (0)
+
+SIMD_AVX2 static size_t quat_slerp_n_avx2(float* dst, float* b, float* t, size_t n, uint8_t mode) {
+    __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    __m256 signbit = _mm256_set1_ps(-0.0f);
+    __m256 one = _mm256_set1_ps(1.0f);
+    size_t i;
+    int8_t j;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        float* p = dst + i * 4;
+        float* q = b + i * 4;
+        __m256 ax = _mm256_loadu_ps(p), ay = _mm256_loadu_ps(p + 8), az = _mm256_loadu_ps(p + 16), aw = _mm256_loadu_ps(p + 24);
+        __m256 bx = _mm256_loadu_ps(q), by = _mm256_loadu_ps(q + 8), bz = _mm256_loadu_ps(q + 16), bw = _mm256_loadu_ps(q + 24);
+        __m256 vt = _mm256_permutevar8x32_ps(_mm256_loadu_ps(t + i), order);
+        __m256 cosom, sign, scale0, scale1;
+
+        QUAT_TRANSPOSE8(ax, ay, az, aw);
+        QUAT_TRANSPOSE8(bx, by, bz, bw);
+
+        // The dot is rounded like the scalar one and its sign tested with
+        // cosom < 0, so orthogonal pairs pick the same hemisphere on both paths
+        cosom = _mm256_mul_ps(ax, bx);
+        cosom = _mm256_add_ps(cosom, _mm256_mul_ps(ay, by));
+        cosom = _mm256_add_ps(cosom, _mm256_mul_ps(az, bz));
+        cosom = _mm256_add_ps(cosom, _mm256_mul_ps(aw, bw));
+        sign = _mm256_and_ps(_mm256_cmp_ps(cosom, _mm256_setzero_ps(), _CMP_LT_OQ), signbit);
+        cosom = _mm256_andnot_ps(signbit, cosom);
+
+        if (mode == QUAT_SLERP_NLERP) {
+            __m256 A = _mm256_fmadd_ps(cosom, _mm256_set1_ps(-1.43519f), _mm256_set1_ps(3.55645f));
+            __m256 B = _mm256_fmadd_ps(cosom, _mm256_set1_ps(0.215638f), _mm256_set1_ps(-1.06021f));
+            __m256 h = _mm256_sub_ps(vt, _mm256_set1_ps(0.5f));
+            __m256 k, ot;
+            A = _mm256_fmadd_ps(cosom, A, _mm256_set1_ps(-3.2452f));
+            A = _mm256_fmadd_ps(cosom, A, _mm256_set1_ps(1.0904f));
+            B = _mm256_fmadd_ps(cosom, B, _mm256_set1_ps(0.848013f));
+            k = _mm256_fmadd_ps(_mm256_mul_ps(A, h), h, B);
+            ot = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(vt, h), _mm256_sub_ps(vt, one)), k);
+            ot = _mm256_add_ps(vt, ot);
+            scale0 = _mm256_sub_ps(one, ot);
+            scale1 = ot;
+        }
+        else {
+            __m256 xm1 = _mm256_sub_ps(cosom, one);
+            __m256 d = _mm256_sub_ps(one, vt);
+            __m256 sqrT = _mm256_mul_ps(vt, vt);
+            __m256 sqrD = _mm256_mul_ps(d, d);
+            scale0 = one;
+            scale1 = one;
+            for (j = 7; j >= 0; j--) {
+                __m256 u = _mm256_set1_ps(quat_slerp_u[j]);
+                __m256 v = _mm256_set1_ps(quat_slerp_v[j]);
+                scale1 = _mm256_fmadd_ps(_mm256_mul_ps(_mm256_fmsub_ps(u, sqrT, v), xm1), scale1, one);
+                scale0 = _mm256_fmadd_ps(_mm256_mul_ps(_mm256_fmsub_ps(u, sqrD, v), xm1), scale0, one);
+            }
+            scale0 = _mm256_mul_ps(scale0, d);
+            scale1 = _mm256_mul_ps(scale1, vt);
+        }
+        scale1 = _mm256_xor_ps(scale1, sign);
+
+        ax = _mm256_fmadd_ps(scale1, bx, _mm256_mul_ps(scale0, ax));
+        ay = _mm256_fmadd_ps(scale1, by, _mm256_mul_ps(scale0, ay));
+        az = _mm256_fmadd_ps(scale1, bz, _mm256_mul_ps(scale0, az));
+        aw = _mm256_fmadd_ps(scale1, bw, _mm256_mul_ps(scale0, aw));
+
+        if (mode == QUAT_SLERP_NLERP) {
+            __m256 len = _mm256_mul_ps(ax, ax);
+            len = _mm256_fmadd_ps(ay, ay, len);
+            len = _mm256_fmadd_ps(az, az, len);
+            len = _mm256_fmadd_ps(aw, aw, len);
+            len = _mm256_div_ps(one, _mm256_sqrt_ps(len));
+            ax = _mm256_mul_ps(ax, len);
+            ay = _mm256_mul_ps(ay, len);
+            az = _mm256_mul_ps(az, len);
+            aw = _mm256_mul_ps(aw, len);
+        }
+
+        QUAT_TRANSPOSE8(ax, ay, az, aw);
+        _mm256_storeu_ps(p, ax);
+        _mm256_storeu_ps(p + 8, ay);
+        _mm256_storeu_ps(p + 16, az);
+        _mm256_storeu_ps(p + 24, aw);
+    }
+    return i;
+}
+#endif
+
+#if GL_MATRIX_SIMD
+// Same evaluation order as quat_multiply. The w lane subtracts the products
+// that the others add, so those are added negated, which rounds the same.
+SIMD_SSE41 static void quat_multiply_sse41(float* dst, float* b) {
+    __m128 a = _mm_load_ps(dst), q = _mm_load_ps(b);
+    __m128 w = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, 0x80000000));
+
+    // ax*bw, ay*bw, az*bw, aw*bw
+    __m128 r = _mm_mul_ps(a, _mm_shuffle_ps(q, q, 0xff));
+    // aw*bx, aw*by, aw*bz, -ax*bx
+    r = _mm_add_ps(r, _mm_xor_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 3, 3, 3)),
+        _mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 2, 1, 0))), w));
+    // ay*bz, az*bx, ax*by, -ay*by
+    r = _mm_add_ps(r, _mm_xor_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 2, 1)),
+        _mm_shuffle_ps(q, q, _MM_SHUFFLE(1, 1, 0, 2))), w));
+    // az*by, ax*bz, ay*bx, az*bz
+    r = _mm_sub_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 1, 0, 2)),
+        _mm_shuffle_ps(q, q, _MM_SHUFFLE(2, 0, 2, 1))));
+    _mm_store_ps(dst, r);
+}
+#endif
+
+static uint8_t quat_use_avx2 = 0;
+static uint8_t quat_use_sse41 = 0;
+
+__attribute__((constructor))
+static void quat_dispatch(void) {
+    uint32_t features = cpu_features();
+    quat_use_avx2 = (features & CPU_AVX2) && (features & CPU_FMA);
+    quat_use_sse41 = (features & CPU_SSE41) != 0;
+}
+
+/**
+ * quat_multiply for quaternions aligned to QUAT_ALIGNMENT
+ *
+ * @param {quat} out the receiving quaternion
+ * @param {quat} b the second operand
+ */
+GL_MATRIX_API void quat_multiply_aligned(float* dst, float* b) {
+    SIMD_ASSERT_ALIGNED(dst, QUAT_ALIGNMENT);
+    SIMD_ASSERT_ALIGNED(b, QUAT_ALIGNMENT);
+#if GL_MATRIX_SIMD
+    if (quat_use_sse41) {
+        quat_multiply_sse41(dst, b);
+        return;
+    }
+#endif
+    quat_multiply(dst, b);
+}
+
+/**
+ * Interpolates an array of quats towards a second array, each pair with
+ * its own t. Avoids the acosf/sinf calls of quat_slerp.
+ *
+ * QUAT_SLERP_POLYNOMIAL evaluates an 8 term polynomial for the slerp
+ * weights; components are within 4e-5 of an exact slerp for unit inputs.
+ * QUAT_SLERP_NLERP lerps with a corrected t and renormalizes; cheaper,
+ * components are within 4e-4 of an exact slerp. Both run 8 quats at a
+ * time with AVX2/FMA when available.
+ *
+ * @param {quat[]} out array of n receiving quaternions
+ * @param {quat[]} b array of n second operands
+ * @param {Number[]} t array of n interpolation amounts, in the range [0-1]
+ * @param {Number} n number of quaternions
+ * @param {Number} mode QUAT_SLERP_POLYNOMIAL or QUAT_SLERP_NLERP
+ */
+GL_MATRIX_API void quat_slerp_n(float* dst, float* b, float* t, size_t n, uint8_t mode) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (quat_use_avx2) {
+        i = quat_slerp_n_avx2(dst, b, t, n, mode);
+    }
+#endif
+    for (; i < n; i++) {
+        if (mode == QUAT_SLERP_NLERP) {
+            quat_nlerpCorrected(dst + i * 4, b + i * 4, t[i]);
+        }
+        else {
+            quat_slerpPolynomial(dst + i * 4, b + i * 4, t[i]);
+        }
+    }
+}
+// End float only
+
 /**
  * Calculates the inverse of a quat
  *
  * @param {quat} out the receiving quaternion
  */
-void quat_invert(float* dst) {
+GL_MATRIX_API void quat_invert(float* dst) {
     float a0 = dst[0], a1 = dst[1], a2 = dst[2], a3 = dst[3];
     float dot = a0*a0 + a1*a1 + a2*a2 + a3*a3;
     float invDot = dot ? 1.0/dot : 0;
@@ -218,7 +470,7 @@ void quat_invert(float* dst) {
  * @param {quat} out the receiving quaternion
  * @param {quat} a quat to calculate conjugate of
  */
-void quat_conjugate(float* dst) {
+GL_MATRIX_API void quat_conjugate(float* dst) {
     dst[0] = -dst[0];
     dst[1] = -dst[1];
     dst[2] = -dst[2];
@@ -234,7 +486,7 @@ void quat_conjugate(float* dst) {
  * @param {quat} out the receiving quaternion
  * @param {mat3} m rotation matrix
  */
-void quat_fromMat3(float* dst, float* m) {
+GL_MATRIX_API SIMD_CLONES void quat_fromMat3(float* dst, float* m) {
     // Algorithm in Ken Shoemake's article in 1987 SIGGRAPH course notes
     // article "Quaternion Calculus and Fast Animation".
     float fTrace = m[0] + m[4] + m[8];
@@ -276,7 +528,7 @@ void quat_fromMat3(float* dst, float* m) {
  * @param {y} Angle to rotate around Y axis in degrees.
  * @param {z} Angle to rotate around Z axis in degrees.
  */
-void quat_fromEuler(float* dst, float x, float y, float z) {
+GL_MATRIX_API void quat_fromEuler(float* dst, float x, float y, float z) {
     float halfToRad = 0.5 * M_PI / 180.0;
     x *= halfToRad;
     y *= halfToRad;
@@ -294,3 +546,228 @@ void quat_fromEuler(float* dst, float x, float y, float z) {
     dst[2] = cx * cy * sz - sx * sy * cz;
     dst[3] = cx * cy * cz + sx * sy * sz;
 }
+
+// Float only
+// Smallest three encoding: the largest component is dropped and rebuilt
+// from the unit length, the other three lie in [-1/sqrt(2), 1/sqrt(2)].
+// They are stored as half + round(c * half / range) with an even number of
+// steps, so 0 is exact and identity rotations survive a round trip. q and
+// -q are the same rotation, so the quat is flipped to make the dropped
+// component positive.
+#define QUAT_PACK_RANGE 0.70710678f
+
+static uint8_t quat_packLargest(float* a, float* sign) {
+    uint8_t i, largest = 0;
+    for (i = 1; i < 4; i++) {
+        if (fabsf(a[i]) > fabsf(a[largest])) {
+            largest = i;
+        }
+    }
+    *sign = a[largest] < 0 ? -1.0f : 1.0f;
+    return largest;
+}
+
+static uint32_t quat_packComponent(float c, float sign, uint32_t half) {
+    float v = c * sign * (half / QUAT_PACK_RANGE) + half + 0.5f;
+    if (v <= 0) {
+        return 0;
+    }
+    return v >= half * 2 ? half * 2 : (uint32_t)v;
+}
+
+// Writes the three small components s and rebuilds the largest one
+static void quat_unpackLargest(float* dst, uint8_t largest, float s0, float s1, float s2) {
+    float w = 1 - s0 * s0 - s1 * s1 - s2 * s2;
+    float s[3] = { s0, s1, s2 };
+    uint8_t i, k = 0;
+    for (i = 0; i < 4; i++) {
+        dst[i] = i == largest ? sqrtf(w > 0 ? w : 0) : s[k++];
+    }
+}
+
+/**
+ * Packs a unit quat into 48 bits, 15 bits per component. Unpacked quats
+ * are within 0.0081 degrees of the original rotation.
+ *
+ * @param {uint16_t[3]} out the receiving packed quat
+ * @param {quat} a unit quaternion to pack
+ */
+GL_MATRIX_API void quat_pack48(uint16_t* dst, float* a) {
+    float sign, s[3];
+    uint8_t largest = quat_packLargest(a, &sign);
+    uint8_t i, k = 0;
+    for (i = 0; i < 4; i++) {
+        if (i != largest) {
+            s[k++] = a[i];
+        }
+    }
+    dst[0] = quat_packComponent(s[0], sign, 0x3fff) | (largest & 1) << 15;
+    dst[1] = quat_packComponent(s[1], sign, 0x3fff) | (largest >> 1) << 15;
+    dst[2] = quat_packComponent(s[2], sign, 0x3fff);
+}
+
+/**
+ * Unpacks a quat packed by quat_pack48
+ *
+ * @param {quat} out the receiving quaternion
+ * @param {uint16_t[3]} a the packed quat
+ */
+GL_MATRIX_API void quat_unpack48(float* dst, uint16_t* a) {
+    float scale = QUAT_PACK_RANGE / 0x3fff;
+    uint8_t largest = (a[0] >> 15) | (a[1] >> 15) << 1;
+    quat_unpackLargest(dst, largest,
+        (float)((int32_t)(a[0] & 0x7fff) - 0x3fff) * scale,
+        (float)((int32_t)(a[1] & 0x7fff) - 0x3fff) * scale,
+        (float)((int32_t)a[2] - 0x3fff) * scale);
+}
+
+/**
+ * Packs a unit quat into 32 bits, 10 bits per component. Unpacked quats
+ * are within 0.26 degrees of the original rotation.
+ *
+ * @param {uint32_t} out the receiving packed quat
+ * @param {quat} a unit quaternion to pack
+ */
+GL_MATRIX_API void quat_pack32(uint32_t* dst, float* a) {
+    float sign, s[3];
+    uint8_t largest = quat_packLargest(a, &sign);
+    uint8_t i, k = 0;
+    for (i = 0; i < 4; i++) {
+        if (i != largest) {
+            s[k++] = a[i];
+        }
+    }
+    *dst = (uint32_t)largest << 30 |
+        quat_packComponent(s[0], sign, 0x1ff) << 20 |
+        quat_packComponent(s[1], sign, 0x1ff) << 10 |
+        quat_packComponent(s[2], sign, 0x1ff);
+}
+
+/**
+ * Unpacks a quat packed by quat_pack32
+ *
+ * @param {quat} out the receiving quaternion
+ * @param {uint32_t} a the packed quat
+ */
+GL_MATRIX_API void quat_unpack32(float* dst, uint32_t* a) {
+    float scale = QUAT_PACK_RANGE / 0x1ff;
+    uint32_t v = *a;
+    quat_unpackLargest(dst, v >> 30,
+        (float)((int32_t)(v >> 20 & 0x3ff) - 0x1ff) * scale,
+        (float)((int32_t)(v >> 10 & 0x3ff) - 0x1ff) * scale,
+        (float)((int32_t)(v & 0x3ff) - 0x1ff) * scale);
+}
+
+#if GL_MATRIX_SIMD
+// Rebuilds 8 quats from their three small components s0, s1, s2 and the
+// index of the largest, with lanes in the [0 2 4 6 | 1 3 5 7] order of
+// QUAT_TRANSPOSE8, and stores them interleaved
+SIMD_AVX2_NOFMA static SIMD_INLINE void quat_unpack8_avx2(float* dst, __m256i largest, __m256 s0, __m256 s1, __m256 s2) {
+    __m256 w = _mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(s0, s0));
+    w = _mm256_sub_ps(w, _mm256_mul_ps(s1, s1));
+    w = _mm256_sub_ps(w, _mm256_mul_ps(s2, s2));
+    w = _mm256_sqrt_ps(_mm256_max_ps(w, _mm256_setzero_ps()));
+
+    __m256 is0 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest, _mm256_setzero_si256()));
+    __m256 is1 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest, _mm256_set1_epi32(1)));
+    __m256 is2 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest, _mm256_set1_epi32(2)));
+    __m256 is3 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest, _mm256_set1_epi32(3)));
+    __m256 x = _mm256_blendv_ps(s0, w, is0);
+    __m256 y = _mm256_blendv_ps(_mm256_blendv_ps(s1, w, is1), s0, is0);
+    __m256 z = _mm256_blendv_ps(_mm256_blendv_ps(s1, w, is2), s2, is3);
+    __m256 q = _mm256_blendv_ps(s2, w, is3);
+
+    QUAT_TRANSPOSE8(x, y, z, q);
+    _mm256_storeu_ps(dst, x);
+    _mm256_storeu_ps(dst + 8, y);
+    _mm256_storeu_ps(dst + 16, z);
+    _mm256_storeu_ps(dst + 24, q);
+}
+
+// Each quat is gathered as two overlapping 32-bit words, a[0..1] and
+// a[1..2], so nothing past the end of the array is read
+SIMD_AVX2_NOFMA static size_t quat_unpack48_n_avx2(float* dst, uint16_t* src, size_t n) {
+    __m256i offsets = _mm256_setr_epi32(0, 12, 24, 36, 6, 18, 30, 42);
+    __m256i mask = _mm256_set1_epi32(0x7fff);
+    __m256i half = _mm256_set1_epi32(0x3fff);
+    __m256 scale = _mm256_set1_ps(QUAT_PACK_RANGE / 0x3fff);
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        char* p = (char*)(src + i * 3);
+        __m256i lo = _mm256_i32gather_epi32((int*)p, offsets, 1);
+        __m256i hi = _mm256_i32gather_epi32((int*)(p + 2), offsets, 1);
+        __m256i largest = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(lo, 15), _mm256_set1_epi32(1)),
+            _mm256_and_si256(_mm256_srli_epi32(lo, 30), _mm256_set1_epi32(2)));
+        __m256i s0 = _mm256_sub_epi32(_mm256_and_si256(lo, mask), half);
+        __m256i s1 = _mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(lo, 16), mask), half);
+        __m256i s2 = _mm256_sub_epi32(_mm256_srli_epi32(hi, 16), half);
+        quat_unpack8_avx2(dst + i * 4, largest,
+            _mm256_mul_ps(_mm256_cvtepi32_ps(s0), scale),
+            _mm256_mul_ps(_mm256_cvtepi32_ps(s1), scale),
+            _mm256_mul_ps(_mm256_cvtepi32_ps(s2), scale));
+    }
+    return i;
+}
+
+SIMD_AVX2_NOFMA static size_t quat_unpack32_n_avx2(float* dst, uint32_t* src, size_t n) {
+    __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    __m256i mask = _mm256_set1_epi32(0x3ff);
+    __m256i half = _mm256_set1_epi32(0x1ff);
+    __m256 scale = _mm256_set1_ps(QUAT_PACK_RANGE / 0x1ff);
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((__m256i*)(src + i)), order);
+        __m256i s0 = _mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(v, 20), mask), half);
+        __m256i s1 = _mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(v, 10), mask), half);
+        __m256i s2 = _mm256_sub_epi32(_mm256_and_si256(v, mask), half);
+        quat_unpack8_avx2(dst + i * 4, _mm256_srli_epi32(v, 30),
+            _mm256_mul_ps(_mm256_cvtepi32_ps(s0), scale),
+            _mm256_mul_ps(_mm256_cvtepi32_ps(s1), scale),
+            _mm256_mul_ps(_mm256_cvtepi32_ps(s2), scale));
+    }
+    return i;
+}
+#endif
+
+/**
+ * Unpacks an array of quats packed by quat_pack48. Runs 8 quats at a time
+ * with AVX2 when available, with the same results as quat_unpack48.
+ *
+ * @param {quat[]} out array of n receiving quaternions
+ * @param {uint16_t[]} src array of n packed quats, 3 uint16_t each
+ * @param {Number} n number of quaternions
+ */
+GL_MATRIX_API void quat_unpack48_n(float* dst, uint16_t* src, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (quat_use_avx2) {
+        i = quat_unpack48_n_avx2(dst, src, n);
+    }
+#endif
+    for (; i < n; i++) {
+        quat_unpack48(dst + i * 4, src + i * 3);
+    }
+}
+
+/**
+ * Unpacks an array of quats packed by quat_pack32. Runs 8 quats at a time
+ * with AVX2 when available, with the same results as quat_unpack32.
+ *
+ * @param {quat[]} out array of n receiving quaternions
+ * @param {uint32_t[]} src array of n packed quats
+ * @param {Number} n number of quaternions
+ */
+GL_MATRIX_API void quat_unpack32_n(float* dst, uint32_t* src, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (quat_use_avx2) {
+        i = quat_unpack32_n_avx2(dst, src, n);
+    }
+#endif
+    for (; i < n; i++) {
+        quat_unpack32(dst + i * 4, src + i);
+    }
+}
+// End float only
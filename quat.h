@@ -1,14 +1,32 @@
 #ifndef QUAT_H
 #define QUAT_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include "api.h"
+
+// Float only
+#define QUAT_SLERP_POLYNOMIAL 0
+#define QUAT_SLERP_NLERP 1
+
+/**
+ * Alignment in bytes of the quaternions the _aligned functions take, one
+ * SSE register.
+ */
+#define QUAT_ALIGNMENT (4 * sizeof(float))
+
+/**
+ * A quat with QUAT_ALIGNMENT. Passes to every quat function.
+ */
+typedef float quat_aligned[4] GL_MATRIX_ALIGNED(QUAT_ALIGNMENT);
+// End float only
 
 /**
  * Set a quat to the identity quaternion
  *
  * @param {quat} out the receiving quaternion
  */
-void quat_identity(float* dst);
+GL_MATRIX_API void quat_identity(float* dst);
 
 /**
  * Sets a quat from the given angle and rotation axis,
@@ -18,7 +36,7 @@ void quat_identity(float* dst);
  * @param {vec3} axis the axis around which to rotate
  * @param {Number} rad the angle in radians
  **/
-void quat_setAxisAngle(float* dst, float* axis, float rad);
+GL_MATRIX_API void quat_setAxisAngle(float* dst, float* axis, float rad);
 
 /**
  * Gets the rotation axis and angle for a given
@@ -33,7 +51,7 @@ void quat_setAxisAngle(float* dst, float* axis, float rad);
  * @param  {quat} q     Quaternion to be decomposed
  * @return {Number}     Angle, in radians, of the rotation
  */
-float quat_getAxisAngle(float* out_axis, float* q);
+GL_MATRIX_API float quat_getAxisAngle(float* out_axis, float* q);
 
 /**
  * Multiplies two quat's
@@ -41,7 +59,19 @@ float quat_getAxisAngle(float* out_axis, float* q);
  * @param {quat} out the receiving quaternion
  * @param {quat} b the second operand
  */
-void quat_multiply(float* dst, float* b);
+GL_MATRIX_API void quat_multiply(float* dst, float* b);
+
+// Float only
+/**
+ * quat_multiply for quaternions aligned to QUAT_ALIGNMENT. Uses an SSE4.1
+ * kernel when the CPU supports it, with the evaluation order of the scalar
+ * code and the same results. Debug builds assert the alignment.
+ *
+ * @param {quat} out the receiving quaternion
+ * @param {quat} b the second operand
+ */
+GL_MATRIX_API void quat_multiply_aligned(float* dst, float* b);
+// End float only
 
 /**
  * Rotates a quaternion by the given angle about the X axis
@@ -49,7 +79,7 @@ void quat_multiply(float* dst, float* b);
  * @param {quat} out quat receiving operation result
  * @param {number} rad angle (in radians) to rotate
  */
-void quat_rotateX(float* dst, float rad);
+GL_MATRIX_API void quat_rotateX(float* dst, float rad);
 
 /**
  * Rotates a quaternion by the given angle about the Y axis
@@ -57,7 +87,7 @@ void quat_rotateX(float* dst, float rad);
  * @param {quat} out quat receiving operation result
  * @param {number} rad angle (in radians) to rotate
  */
-void quat_rotateY(float* dst, float rad);
+GL_MATRIX_API void quat_rotateY(float* dst, float rad);
 
 /**
  * Rotates a quaternion by the given angle about the Z axis
@@ -65,7 +95,7 @@ void quat_rotateY(float* dst, float rad);
  * @param {quat} out quat receiving operation result
  * @param {number} rad angle (in radians) to rotate
  */
-void quat_rotateZ(float* dst, float rad);
+GL_MATRIX_API void quat_rotateZ(float* dst, float rad);
 
 /**
  * Calculates the W component of a quat from the X, Y, and Z components.
@@ -74,7 +104,7 @@ void quat_rotateZ(float* dst, float rad);
  *
  * @param {quat} out the receiving quaternion
  */
-void quat_calculateW(float* dst);
+GL_MATRIX_API void quat_calculateW(float* dst);
 
 /**
  * Performs a spherical linear interpolation between two quat
@@ -83,14 +113,34 @@ void quat_calculateW(float* dst);
  * @param {quat} b the second operand
  * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
  */
-void quat_slerp(float* dst, float* b, float t);
+GL_MATRIX_API void quat_slerp(float* dst, float* b, float t);
+
+// Float only
+/**
+ * Interpolates an array of quats towards a second array, each pair with
+ * its own t. Avoids the acosf/sinf calls of quat_slerp.
+ *
+ * QUAT_SLERP_POLYNOMIAL evaluates an 8 term polynomial for the slerp
+ * weights; components are within 4e-5 of an exact slerp for unit inputs.
+ * QUAT_SLERP_NLERP lerps with a corrected t and renormalizes; cheaper,
+ * components are within 4e-4 of an exact slerp. Both run 8 quats at a
+ * time with AVX2/FMA when available.
+ *
+ * @param {quat[]} out array of n receiving quaternions
+ * @param {quat[]} b array of n second operands
+ * @param {Number[]} t array of n interpolation amounts, in the range [0-1]
+ * @param {Number} n number of quaternions
+ * @param {Number} mode QUAT_SLERP_POLYNOMIAL or QUAT_SLERP_NLERP
+ */
+GL_MATRIX_API void quat_slerp_n(float* dst, float* b, float* t, size_t n, uint8_t mode);
+// End float only
 
 /**
  * Calculates the inverse of a quat
  *
  * @param {quat} out the receiving quaternion
  */
-void quat_invert(float* dst);
+GL_MATRIX_API void quat_invert(float* dst);
 
 /**
  * Calculates the conjugate of a quat
@@ -99,7 +149,7 @@ void quat_invert(float* dst);
  * @param {quat} out the receiving quaternion
  * @param {quat} a quat to calculate conjugate of
  */
-void quat_conjugate(float* dst);
+GL_MATRIX_API void quat_conjugate(float* dst);
 
 /**
  * Creates a quaternion from the given 3x3 rotation matrix.
@@ -110,7 +160,7 @@ void quat_conjugate(float* dst);
  * @param {quat} out the receiving quaternion
  * @param {mat3} m rotation matrix
  */
-void quat_fromMat3(float* dst, float* m);
+GL_MATRIX_API void quat_fromMat3(float* dst, float* m);
 
 /**
  * Creates a quaternion from the given euler angle x, y, z.
@@ -120,6 +170,66 @@ void quat_fromMat3(float* dst, float* m);
  * @param {y} Angle to rotate around Y axis in degrees.
  * @param {z} Angle to rotate around Z axis in degrees.
  */
-void quat_fromEuler(float* dst, float x, float y, float z);
+GL_MATRIX_API void quat_fromEuler(float* dst, float x, float y, float z);
+
+// Float only
+/**
+ * Packs a unit quat into 48 bits, 15 bits per component. Unpacked quats
+ * are within 0.0081 degrees of the original rotation.
+ *
+ * Both packed formats use the smallest three encoding: the component with
+ * the largest magnitude is dropped and rebuilt from the unit length when
+ * unpacking, and its index takes the two spare bits.
+ *
+ * @param {uint16_t[3]} out the receiving packed quat
+ * @param {quat} a unit quaternion to pack
+ */
+GL_MATRIX_API void quat_pack48(uint16_t* dst, float* a);
+
+/**
+ * Unpacks a quat packed by quat_pack48
+ *
+ * @param {quat} out the receiving quaternion
+ * @param {uint16_t[3]} a the packed quat
+ */
+GL_MATRIX_API void quat_unpack48(float* dst, uint16_t* a);
+
+/**
+ * Packs a unit quat into 32 bits, 10 bits per component. Unpacked quats
+ * are within 0.26 degrees of the original rotation.
+ *
+ * @param {uint32_t} out the receiving packed quat
+ * @param {quat} a unit quaternion to pack
+ */
+GL_MATRIX_API void quat_pack32(uint32_t* dst, float* a);
+
+/**
+ * Unpacks a quat packed by quat_pack32
+ *
+ * @param {quat} out the receiving quaternion
+ * @param {uint32_t} a the packed quat
+ */
+GL_MATRIX_API void quat_unpack32(float* dst, uint32_t* a);
+
+/**
+ * Unpacks an array of quats packed by quat_pack48. Runs 8 quats at a time
+ * with AVX2 when available, with the same results as quat_unpack48.
+ *
+ * @param {quat[]} out array of n receiving quaternions
+ * @param {uint16_t[]} src array of n packed quats, 3 uint16_t each
+ * @param {Number} n number of quaternions
+ */
+GL_MATRIX_API void quat_unpack48_n(float* dst, uint16_t* src, size_t n);
+
+/**
+ * Unpacks an array of quats packed by quat_pack32. Runs 8 quats at a time
+ * with AVX2 when available, with the same results as quat_unpack32.
+ *
+ * @param {quat[]} out array of n receiving quaternions
+ * @param {uint32_t[]} src array of n packed quats
+ * @param {Number} n number of quaternions
+ */
+GL_MATRIX_API void quat_unpack32_n(float* dst, uint32_t* src, size_t n);
+// End float only
 
 #endif
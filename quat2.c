@@ -0,0 +1,303 @@
+#include "quat2.h"
+#include "epsilon.h"
+#include <math.h>
+
+/**
+ * Set a dual quat to the identity dual quaternion
+ *
+ * @param {quat2} out the receiving dual quaternion
+ */
+GL_MATRIX_API void quat2_identity(float* dst) {
+    dst[0] = 0;
+    dst[1] = 0;
+    dst[2] = 0;
+    dst[3] = 1;
+    dst[4] = 0;
+    dst[5] = 0;
+    dst[6] = 0;
+    dst[7] = 0;
+}
+
+/**
+ * Copy the values from one dual quat to another
+ *
+ * @param {quat2} out the receiving dual quaternion
+ * @param {quat2} a the source dual quaternion
+ */
+GL_MATRIX_API void quat2_copy(float* dst, float* a) {
+    dst[0] = a[0];
+    dst[1] = a[1];
+    dst[2] = a[2];
+    dst[3] = a[3];
+    dst[4] = a[4];
+    dst[5] = a[5];
+    dst[6] = a[6];
+    dst[7] = a[7];
+}
+
+/**
+ * Creates a dual quat from a quaternion and a translation
+ *
+ * @param {quat2} out the receiving dual quaternion
+ * @param {quat} q rotation, should be normalized
+ * @param {vec3} t translation
+ */
+GL_MATRIX_API void quat2_fromRotationTranslation(float* dst, float* q, float* t) {
+    float ax = t[0] * 0.5f, ay = t[1] * 0.5f, az = t[2] * 0.5f;
+    float bx = q[0], by = q[1], bz = q[2], bw = q[3];
+    dst[0] = bx;
+    dst[1] = by;
+    dst[2] = bz;
+    dst[3] = bw;
+    dst[4] = ax * bw + ay * bz - az * by;
+    dst[5] = ay * bw + az * bx - ax * bz;
+    dst[6] = az * bw + ax * by - ay * bx;
+    dst[7] = -ax * bx - ay * by - az * bz;
+}
+
+/**
+ * Creates a dual quat from a translation
+ *
+ * @param {quat2} out the receiving dual quaternion
+ * @param {vec3} t translation
+ */
+GL_MATRIX_API void quat2_fromTranslation(float* dst, float* t) {
+    dst[0] = 0;
+    dst[1] = 0;
+    dst[2] = 0;
+    dst[3] = 1;
+    dst[4] = t[0] * 0.5f;
+    dst[5] = t[1] * 0.5f;
+    dst[6] = t[2] * 0.5f;
+    dst[7] = 0;
+}
+
+/**
+ * Gets the translation of a normalized dual quat
+ *
+ * @param {vec3} out the receiving translation
+ * @param {quat2} a dual quaternion to be decomposed
+ */
+GL_MATRIX_API void quat2_getTranslation(float* dst, float* a) {
+    float ax = a[4], ay = a[5], az = a[6], aw = a[7];
+    float bx = -a[0], by = -a[1], bz = -a[2], bw = a[3];
+    dst[0] = (ax * bw + aw * bx + ay * bz - az * by) * 2;
+    dst[1] = (ay * bw + aw * by + az * bx - ax * bz) * 2;
+    dst[2] = (az * bw + aw * bz + ax * by - ay * bx) * 2;
+}
+
+/**
+ * Multiplies two dual quats
+ *
+ * @param {quat2} out the receiving dual quaternion, and the first operand
+ * @param {quat2} b the second operand
+ */
+GL_MATRIX_API void quat2_multiply(float* dst, float* b) {
+    float ax0 = dst[0], ay0 = dst[1], az0 = dst[2], aw0 = dst[3];
+    float ax1 = dst[4], ay1 = dst[5], az1 = dst[6], aw1 = dst[7];
+    float bx0 = b[0], by0 = b[1], bz0 = b[2], bw0 = b[3];
+    float bx1 = b[4], by1 = b[5], bz1 = b[6], bw1 = b[7];
+    dst[0] = ax0 * bw0 + aw0 * bx0 + ay0 * bz0 - az0 * by0;
+    dst[1] = ay0 * bw0 + aw0 * by0 + az0 * bx0 - ax0 * bz0;
+    dst[2] = az0 * bw0 + aw0 * bz0 + ax0 * by0 - ay0 * bx0;
+    dst[3] = aw0 * bw0 - ax0 * bx0 - ay0 * by0 - az0 * bz0;
+    dst[4] = ax0 * bw1 + aw0 * bx1 + ay0 * bz1 - az0 * by1 + ax1 * bw0 + aw1 * bx0 + ay1 * bz0 - az1 * by0;
+    dst[5] = ay0 * bw1 + aw0 * by1 + az0 * bx1 - ax0 * bz1 + ay1 * bw0 + aw1 * by0 + az1 * bx0 - ax1 * bz0;
+    dst[6] = az0 * bw1 + aw0 * bz1 + ax0 * by1 - ay0 * bx1 + az1 * bw0 + aw1 * bz0 + ax1 * by0 - ay1 * bx0;
+    dst[7] = aw0 * bw1 - ax0 * bx1 - ay0 * by1 - az0 * bz1 + aw1 * bw0 - ax1 * bx0 - ay1 * by0 - az1 * bz0;
+}
+
+/**
+ * Calculates the conjugate of a dual quat
+ *
+ * @param {quat2} out the receiving dual quaternion
+ */
+GL_MATRIX_API void quat2_conjugate(float* dst) {
+    dst[0] = -dst[0];
+    dst[1] = -dst[1];
+    dst[2] = -dst[2];
+    dst[4] = -dst[4];
+    dst[5] = -dst[5];
+    dst[6] = -dst[6];
+}
+
+/**
+ * Calculates the inverse of a dual quat
+ *
+ * @param {quat2} out the receiving dual quaternion
+ */
+GL_MATRIX_API void quat2_invert(float* dst) {
+    float sqlen = dst[0] * dst[0] + dst[1] * dst[1] + dst[2] * dst[2] + dst[3] * dst[3];
+    float inv = sqlen ? 1 / sqlen : 0;
+    dst[0] = -dst[0] * inv;
+    dst[1] = -dst[1] * inv;
+    dst[2] = -dst[2] * inv;
+    dst[3] = dst[3] * inv;
+    dst[4] = -dst[4] * inv;
+    dst[5] = -dst[5] * inv;
+    dst[6] = -dst[6] * inv;
+    dst[7] = dst[7] * inv;
+}
+
+/**
+ * Normalize a dual quat
+ * The real part gets unit length and the dual part is made orthogonal to it.
+ *
+ * @param {quat2} out the receiving dual quaternion
+ */
+GL_MATRIX_API void quat2_normalize(float* dst) {
+    float magnitude = dst[0] * dst[0] + dst[1] * dst[1] + dst[2] * dst[2] + dst[3] * dst[3];
+    if (magnitude > 0) {
+        magnitude = sqrtf(magnitude);
+        float a0 = dst[0] / magnitude;
+        float a1 = dst[1] / magnitude;
+        float a2 = dst[2] / magnitude;
+        float a3 = dst[3] / magnitude;
+        float b0 = dst[4];
+        float b1 = dst[5];
+        float b2 = dst[6];
+        float b3 = dst[7];
+        float a_dot_b = a0 * b0 + a1 * b1 + a2 * b2 + a3 * b3;
+        dst[0] = a0;
+        dst[1] = a1;
+        dst[2] = a2;
+        dst[3] = a3;
+        dst[4] = (b0 - a0 * a_dot_b) / magnitude;
+        dst[5] = (b1 - a1 * a_dot_b) / magnitude;
+        dst[6] = (b2 - a2 * a_dot_b) / magnitude;
+        dst[7] = (b3 - a3 * a_dot_b) / magnitude;
+    }
+}
+
+/**
+ * Calculates the dot product of two dual quats (the dot product of the real parts)
+ *
+ * @param {quat2} a the first operand
+ * @param {quat2} b the second operand
+ * @returns {Number} dot product of a and b
+ */
+GL_MATRIX_API float quat2_dot(float* a, float* b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+}
+
+/**
+ * Performs a linear interpolation between two dual quats
+ *
+ * @param {quat2} out the receiving dual quaternion, and the first operand
+ * @param {quat2} b the second operand
+ * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
+ */
+GL_MATRIX_API void quat2_lerp(float* dst, float* b, float t) {
+    float mt = 1 - t;
+    uint8_t i;
+    // Take the shorter of the two paths
+    if (quat2_dot(dst, b) < 0) {
+        t = -t;
+    }
+    for (i = 0; i < 8; i++) {
+        dst[i] = dst[i] * mt + b[i] * t;
+    }
+}
+
+/**
+ * Performs a screw linear interpolation between two normalized dual quats
+ *
+ * @param {quat2} out the receiving dual quaternion, and the first operand
+ * @param {quat2} b the second operand
+ * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
+ */
+GL_MATRIX_API void quat2_sclerp(float* dst, float* b, float t) {
+    float d[8], r[8];
+    float s, c, angle, pitch, sin_half, cos_half;
+
+    // Relative transform d = conjugate(dst) * b, on the short path
+    quat2_copy(d, dst);
+    quat2_conjugate(d);
+    quat2_multiply(d, b);
+    if (d[3] < 0) {
+        uint8_t i;
+        for (i = 0; i < 8; i++) {
+            d[i] = -d[i];
+        }
+    }
+
+    s = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    if (s < EPSILON) {
+        // Pure translation, the screw degenerates to a straight line
+        r[0] = 0;
+        r[1] = 0;
+        r[2] = 0;
+        r[3] = 1;
+        r[4] = d[4] * t;
+        r[5] = d[5] * t;
+        r[6] = d[6] * t;
+        r[7] = 0;
+    }
+    else {
+        // Screw parameters: axis l, moment m, angle and pitch along the axis
+        float lx = d[0] / s, ly = d[1] / s, lz = d[2] / s;
+        float tx, ty, tz, mx, my, mz, cot;
+        angle = 2 * atan2f(s, d[3]);
+        cot = d[3] / s;
+
+        // Translation = 2 * dual * conjugate(real)
+        tx = 2 * (d[4] * d[3] - d[7] * d[0] + d[6] * d[1] - d[5] * d[2]);
+        ty = 2 * (d[5] * d[3] - d[7] * d[1] + d[4] * d[2] - d[6] * d[0]);
+        tz = 2 * (d[6] * d[3] - d[7] * d[2] + d[5] * d[0] - d[4] * d[1]);
+        pitch = tx * lx + ty * ly + tz * lz;
+        mx = 0.5f * ((ty * lz - tz * ly) + (tx - lx * pitch) * cot);
+        my = 0.5f * ((tz * lx - tx * lz) + (ty - ly * pitch) * cot);
+        mz = 0.5f * ((tx * ly - ty * lx) + (tz - lz * pitch) * cot);
+
+        // Raise d to the power t by scaling angle and pitch
+        angle *= t;
+        pitch *= t;
+        sin_half = sinf(angle * 0.5f);
+        cos_half = cosf(angle * 0.5f);
+        c = pitch * 0.5f;
+        r[0] = lx * sin_half;
+        r[1] = ly * sin_half;
+        r[2] = lz * sin_half;
+        r[3] = cos_half;
+        r[4] = mx * sin_half + lx * c * cos_half;
+        r[5] = my * sin_half + ly * c * cos_half;
+        r[6] = mz * sin_half + lz * c * cos_half;
+        r[7] = -c * sin_half;
+    }
+
+    quat2_multiply(dst, r);
+}
+
+/**
+ * Transforms a point with a normalized dual quat
+ *
+ * @param {vec3} out the receiving point, and the point to transform
+ * @param {quat2} a dual quaternion to transform with
+ */
+GL_MATRIX_API void quat2_transformPoint(float* dst, float* a) {
+    float qx = a[0], qy = a[1], qz = a[2], qw = a[3];
+    float x = dst[0], y = dst[1], z = dst[2];
+    float t[3];
+
+    // Rotation as in vec3_transformQuat
+    float uvx = qy * z - qz * y, uvy = qz * x - qx * z, uvz = qx * y - qy * x;
+    float uuvx = qy * uvz - qz * uvy, uuvy = qz * uvx - qx * uvz, uuvz = qx * uvy - qy * uvx;
+    float w2 = qw * 2;
+
+    quat2_getTranslation(t, a);
+    dst[0] = x + uvx * w2 + uuvx * 2 + t[0];
+    dst[1] = y + uvy * w2 + uuvy * 2 + t[1];
+    dst[2] = z + uvz * w2 + uuvz * 2 + t[2];
+}
+
+/**
+ * Returns whether or not the dual quaternions have exactly the same elements.
+ *
+ * @param {quat2} a the first dual quaternion.
+ * @param {quat2} b the second dual quaternion.
+ * @returns {uint8_t} True if the dual quats are equal, false otherwise.
+ */
+GL_MATRIX_API uint8_t quat2_equals(float* a, float* b) {
+    return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3] &&
+        a[4] == b[4] && a[5] == b[5] && a[6] == b[6] && a[7] == b[7];
+}
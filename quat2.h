@@ -0,0 +1,131 @@
+#ifndef QUAT2_H
+#define QUAT2_H
+
+#include <stdint.h>
+#include "api.h"
+
+/**
+ * Dual quaternions are 8 floats: the real part [x, y, z, w] holds the
+ * rotation and the dual part [x, y, z, w] half the translation times the
+ * rotation. A unit dual quaternion describes a rigid transform in half the
+ * space of a mat4.
+ */
+
+/**
+ * Set a dual quat to the identity dual quaternion
+ *
+ * @param {quat2} out the receiving dual quaternion
+ */
+GL_MATRIX_API void quat2_identity(float* dst);
+
+/**
+ * Copy the values from one dual quat to another
+ *
+ * @param {quat2} out the receiving dual quaternion
+ * @param {quat2} a the source dual quaternion
+ */
+GL_MATRIX_API void quat2_copy(float* dst, float* a);
+
+/**
+ * Creates a dual quat from a quaternion and a translation
+ *
+ * @param {quat2} out the receiving dual quaternion
+ * @param {quat} q rotation, should be normalized
+ * @param {vec3} t translation
+ */
+GL_MATRIX_API void quat2_fromRotationTranslation(float* dst, float* q, float* t);
+
+/**
+ * Creates a dual quat from a translation
+ *
+ * @param {quat2} out the receiving dual quaternion
+ * @param {vec3} t translation
+ */
+GL_MATRIX_API void quat2_fromTranslation(float* dst, float* t);
+
+/**
+ * Gets the translation of a normalized dual quat
+ *
+ * @param {vec3} out the receiving translation
+ * @param {quat2} a dual quaternion to be decomposed
+ */
+GL_MATRIX_API void quat2_getTranslation(float* dst, float* a);
+
+/**
+ * Multiplies two dual quats
+ *
+ * @param {quat2} out the receiving dual quaternion, and the first operand
+ * @param {quat2} b the second operand
+ */
+GL_MATRIX_API void quat2_multiply(float* dst, float* b);
+
+/**
+ * Calculates the conjugate of a dual quat
+ * If the dual quaternion is normalized, this function is faster than quat2_invert and produces the same result.
+ *
+ * @param {quat2} out the receiving dual quaternion
+ */
+GL_MATRIX_API void quat2_conjugate(float* dst);
+
+/**
+ * Calculates the inverse of a dual quat
+ *
+ * @param {quat2} out the receiving dual quaternion
+ */
+GL_MATRIX_API void quat2_invert(float* dst);
+
+/**
+ * Normalize a dual quat
+ *
+ * @param {quat2} out the receiving dual quaternion
+ */
+GL_MATRIX_API void quat2_normalize(float* dst);
+
+/**
+ * Calculates the dot product of two dual quats (the dot product of the real parts)
+ *
+ * @param {quat2} a the first operand
+ * @param {quat2} b the second operand
+ * @returns {Number} dot product of a and b
+ */
+GL_MATRIX_API float quat2_dot(float* a, float* b);
+
+/**
+ * Performs a linear interpolation between two dual quats
+ * NOTE: The resulting dual quaternions won't always be normalized (The error is most noticeable when t = 0.5)
+ *
+ * @param {quat2} out the receiving dual quaternion, and the first operand
+ * @param {quat2} b the second operand
+ * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
+ */
+GL_MATRIX_API void quat2_lerp(float* dst, float* b, float t);
+
+/**
+ * Performs a screw linear interpolation between two normalized dual quats
+ * Rotation and translation move together along the screw axis between the
+ * two transforms, at constant speed.
+ *
+ * @param {quat2} out the receiving dual quaternion, and the first operand
+ * @param {quat2} b the second operand
+ * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
+ */
+GL_MATRIX_API void quat2_sclerp(float* dst, float* b, float t);
+
+/**
+ * Transforms a point with a normalized dual quat
+ *
+ * @param {vec3} out the receiving point, and the point to transform
+ * @param {quat2} a dual quaternion to transform with
+ */
+GL_MATRIX_API void quat2_transformPoint(float* dst, float* a);
+
+/**
+ * Returns whether or not the dual quaternions have exactly the same elements.
+ *
+ * @param {quat2} a the first dual quaternion.
+ * @param {quat2} b the second dual quaternion.
+ * @returns {uint8_t} True if the dual quats are equal, false otherwise.
+ */
+GL_MATRIX_API uint8_t quat2_equals(float* a, float* b);
+
+#endif
@@ -0,0 +1,139 @@
+#include "relative.h"
+#include "cpu.h"
+#include "simd.h"
+
+// The AVX2 kernels do the same operations in the same order as the scalar
+// code, without FMA, so both paths give the same results. The batch kernel
+// handles whole blocks of 4 points and returns how many it processed; the
+// scalar loop in relative_vec3_n finishes the tail.
+static uint8_t relative_use_avx2 = 0;
+
+__attribute__((constructor))
+static void relative_dispatch(void) {
+    relative_use_avx2 = (cpu_features() & CPU_AVX2) != 0;
+}
+
+/**
+ * Converts a point to a float point relative to an origin
+ *
+ * @param {vec3} out the receiving point
+ * @param {dvec3} a the world point
+ * @param {dvec3} origin the world position of the new origin
+ */
+GL_MATRIX_API void relative_vec3(float* dst, double* a, double* origin) {
+    dst[0] = (float)(a[0] - origin[0]);
+    dst[1] = (float)(a[1] - origin[1]);
+    dst[2] = (float)(a[2] - origin[2]);
+}
+
+#if GL_MATRIX_SIMD
+// Four packed points are 12 doubles, so the origin repeats every 3 registers
+SIMD_AVX2_NOFMA static size_t relative_vec3_n_avx2(float* dst, double* src, double* origin, size_t n) {
+    __m256d o0 = _mm256_setr_pd(origin[0], origin[1], origin[2], origin[0]);
+    __m256d o1 = _mm256_setr_pd(origin[1], origin[2], origin[0], origin[1]);
+    __m256d o2 = _mm256_setr_pd(origin[2], origin[0], origin[1], origin[2]);
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        double* s = src + i * 3;
+        float* d = dst + i * 3;
+        _mm_storeu_ps(d, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(s), o0)));
+        _mm_storeu_ps(d + 4, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(s + 4), o1)));
+        _mm_storeu_ps(d + 8, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(s + 8), o2)));
+    }
+    return i;
+}
+
+// One matrix column per register
+SIMD_AVX2_NOFMA static void relative_model_avx2(float* dst, double* a, double* origin) {
+    __m256d o = _mm256_setr_pd(origin[0], origin[1], origin[2], 0);
+    uint8_t i;
+    for (i = 0; i < 16; i += 4) {
+        __m256d w = _mm256_broadcast_sd(a + i + 3);
+        _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_mul_pd(o, w))));
+    }
+}
+
+SIMD_AVX2_NOFMA static void relative_view_avx2(float* dst, double* a, double* origin) {
+    __m256d c0 = _mm256_loadu_pd(a);
+    __m256d c1 = _mm256_loadu_pd(a + 4);
+    __m256d c2 = _mm256_loadu_pd(a + 8);
+    __m256d t = _mm256_add_pd(_mm256_mul_pd(c0, _mm256_set1_pd(origin[0])), _mm256_mul_pd(c1, _mm256_set1_pd(origin[1])));
+    t = _mm256_add_pd(_mm256_add_pd(t, _mm256_mul_pd(c2, _mm256_set1_pd(origin[2]))), _mm256_loadu_pd(a + 12));
+    _mm_storeu_ps(dst, _mm256_cvtpd_ps(c0));
+    _mm_storeu_ps(dst + 4, _mm256_cvtpd_ps(c1));
+    _mm_storeu_ps(dst + 8, _mm256_cvtpd_ps(c2));
+    _mm_storeu_ps(dst + 12, _mm256_cvtpd_ps(t));
+}
+#endif
+
+/**
+ * Converts an array of points to float points relative to an origin.
+ * Runs 4 points at a time with AVX2 when available, with the same results
+ * as relative_vec3.
+ *
+ * @param {vec3[]} out array of n receiving points, packed 3 floats apart
+ * @param {dvec3[]} src array of n world points, packed 3 doubles apart
+ * @param {dvec3} origin the world position of the new origin
+ * @param {Number} n number of points
+ */
+GL_MATRIX_API void relative_vec3_n(float* dst, double* src, double* origin, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (relative_use_avx2) {
+        i = relative_vec3_n_avx2(dst, src, origin, n);
+    }
+#endif
+    for (; i < n; i++) {
+        relative_vec3(dst + i * 3, src + i * 3, origin);
+    }
+}
+
+/**
+ * Converts a model matrix to a float matrix that maps into the space of an
+ * origin, i.e. translate(-origin) * a
+ *
+ * @param {mat4} out the receiving matrix
+ * @param {dmat4} a the model to world matrix
+ * @param {dvec3} origin the world position of the new origin
+ */
+GL_MATRIX_API void relative_model(float* dst, double* a, double* origin) {
+    uint8_t i;
+#if GL_MATRIX_SIMD
+    if (relative_use_avx2) {
+        relative_model_avx2(dst, a, origin);
+        return;
+    }
+#endif
+    for (i = 0; i < 16; i += 4) {
+        dst[i] = (float)(a[i] - origin[0] * a[i + 3]);
+        dst[i + 1] = (float)(a[i + 1] - origin[1] * a[i + 3]);
+        dst[i + 2] = (float)(a[i + 2] - origin[2] * a[i + 3]);
+        dst[i + 3] = (float)a[i + 3];
+    }
+}
+
+/**
+ * Converts a view matrix to a float matrix for points relative to an
+ * origin, i.e. a * translate(origin). With the origin at the camera
+ * position the translation of the result is close to zero.
+ *
+ * @param {mat4} out the receiving matrix
+ * @param {dmat4} a the world to view matrix
+ * @param {dvec3} origin the world position of the new origin
+ */
+GL_MATRIX_API void relative_view(float* dst, double* a, double* origin) {
+    uint8_t i;
+#if GL_MATRIX_SIMD
+    if (relative_use_avx2) {
+        relative_view_avx2(dst, a, origin);
+        return;
+    }
+#endif
+    for (i = 0; i < 4; i++) {
+        dst[i] = (float)a[i];
+        dst[i + 4] = (float)a[i + 4];
+        dst[i + 8] = (float)a[i + 8];
+        dst[i + 12] = (float)(a[i] * origin[0] + a[i + 4] * origin[1] + a[i + 8] * origin[2] + a[i + 12]);
+    }
+}
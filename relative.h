@@ -0,0 +1,57 @@
+#ifndef RELATIVE_H
+#define RELATIVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+
+/**
+ * Converts double precision world data to float data relative to an
+ * origin, usually the camera position. The subtraction happens in double,
+ * so positions far from the world origin keep their precision near the
+ * camera once they are rounded to float for rendering.
+ */
+
+/**
+ * Converts a point to a float point relative to an origin
+ *
+ * @param {vec3} out the receiving point
+ * @param {dvec3} a the world point
+ * @param {dvec3} origin the world position of the new origin
+ */
+GL_MATRIX_API void relative_vec3(float* dst, double* a, double* origin);
+
+/**
+ * Converts an array of points to float points relative to an origin.
+ * Runs 4 points at a time with AVX2 when available, with the same results
+ * as relative_vec3.
+ *
+ * @param {vec3[]} out array of n receiving points, packed 3 floats apart
+ * @param {dvec3[]} src array of n world points, packed 3 doubles apart
+ * @param {dvec3} origin the world position of the new origin
+ * @param {Number} n number of points
+ */
+GL_MATRIX_API void relative_vec3_n(float* dst, double* src, double* origin, size_t n);
+
+/**
+ * Converts a model matrix to a float matrix that maps into the space of an
+ * origin, i.e. translate(-origin) * a
+ *
+ * @param {mat4} out the receiving matrix
+ * @param {dmat4} a the model to world matrix
+ * @param {dvec3} origin the world position of the new origin
+ */
+GL_MATRIX_API void relative_model(float* dst, double* a, double* origin);
+
+/**
+ * Converts a view matrix to a float matrix for points relative to an
+ * origin, i.e. a * translate(origin). With the origin at the camera
+ * position the translation of the result is close to zero.
+ *
+ * @param {mat4} out the receiving matrix
+ * @param {dmat4} a the world to view matrix
+ * @param {dvec3} origin the world position of the new origin
+ */
+GL_MATRIX_API void relative_view(float* dst, double* a, double* origin);
+
+#endif
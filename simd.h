@@ -0,0 +1,106 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+/**
+ * Internal helpers for the vectorized kernels. Not part of gl-matrix.h.
+ *
+ * GL_MATRIX_SIMD is 1 when the x86 kernels are compiled in. Define
+ * GL_MATRIX_NO_SIMD to build the scalar code only.
+ */
+#if !defined(GL_MATRIX_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GL_MATRIX_SIMD 1
+#include <immintrin.h>
+#else
+#define GL_MATRIX_SIMD 0
+#endif
+#include <assert.h>
+#include <stdint.h>
+
+#define SIMD_SSE41 __attribute__((target("sse4.1")))
+#define SIMD_AVX2 __attribute__((target("avx2,fma")))
+// For kernels that must match the scalar rounding, so the compiler can not contract into FMA
+#define SIMD_AVX2_NOFMA __attribute__((target("avx2")))
+#define SIMD_F16C __attribute__((target("avx,f16c")))
+#define SIMD_INLINE inline __attribute__((always_inline))
+
+/**
+ * SIMD_CLONES compiles a hot scalar function for x86-64-v2, v3 and v4 as
+ * well as the baseline, and an ifunc resolver picks the best variant at
+ * load time (see cpu_level()). The clones do not contract multiplies and
+ * adds into FMA, so every variant rounds like the baseline and the
+ * functions keep matching their batched and SIMD counterparts. It is empty
+ * in header-only builds, where the clones could not be inlined.
+ */
+#if GL_MATRIX_SIMD && !defined(GL_MATRIX_HEADER_ONLY) && defined(__x86_64__) && defined(__ELF__) && !defined(__clang__) && __GNUC__ >= 12
+#define GL_MATRIX_CLONES 1
+#define SIMD_CLONES __attribute__((target_clones("default", "arch=x86-64-v2", "arch=x86-64-v3", "arch=x86-64-v4"), optimize("fp-contract=off")))
+#else
+#define GL_MATRIX_CLONES 0
+#define SIMD_CLONES
+#endif
+
+/**
+ * Checks that an argument of an _aligned function has the alignment it
+ * promises, in bytes. Compiled out with NDEBUG, like assert.
+ */
+#define SIMD_ASSERT_ALIGNED(p, alignment) assert(((uintptr_t)(p) & ((alignment) - 1)) == 0)
+
+#if GL_MATRIX_SIMD
+// Loads and stores of kernels built for both unaligned and aligned data;
+// aligned is a constant once they are inlined
+SIMD_SSE41 static SIMD_INLINE __m128 simd_load_ps(const float* p, uint8_t aligned) {
+    return aligned ? _mm_load_ps(p) : _mm_loadu_ps(p);
+}
+
+SIMD_SSE41 static SIMD_INLINE void simd_store_ps(float* p, __m128 v, uint8_t aligned) {
+    if (aligned) {
+        _mm_store_ps(p, v);
+    }
+    else {
+        _mm_storeu_ps(p, v);
+    }
+}
+
+SIMD_AVX2_NOFMA static SIMD_INLINE __m256 simd_load8_ps(const float* p, uint8_t aligned) {
+    return aligned ? _mm256_load_ps(p) : _mm256_loadu_ps(p);
+}
+
+SIMD_AVX2_NOFMA static SIMD_INLINE void simd_store8_ps(float* p, __m256 v, uint8_t aligned) {
+    if (aligned) {
+        _mm256_store_ps(p, v);
+    }
+    else {
+        _mm256_storeu_ps(p, v);
+    }
+}
+
+// Transposes an 8x8 block held in eight registers
+SIMD_AVX2_NOFMA static SIMD_INLINE void simd_transpose8_ps(__m256* r) {
+    __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+    __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+    __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+    __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+    __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+    __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+    __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+    __m256 s0 = _mm256_shuffle_ps(t0, t2, 0x44);
+    __m256 s1 = _mm256_shuffle_ps(t0, t2, 0xee);
+    __m256 s2 = _mm256_shuffle_ps(t1, t3, 0x44);
+    __m256 s3 = _mm256_shuffle_ps(t1, t3, 0xee);
+    __m256 s4 = _mm256_shuffle_ps(t4, t6, 0x44);
+    __m256 s5 = _mm256_shuffle_ps(t4, t6, 0xee);
+    __m256 s6 = _mm256_shuffle_ps(t5, t7, 0x44);
+    __m256 s7 = _mm256_shuffle_ps(t5, t7, 0xee);
+    r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+    r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+    r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+    r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+    r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+    r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+    r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+    r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+#endif
+
+#endif
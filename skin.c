@@ -0,0 +1,328 @@
+#include "skin.h"
+#include "vec3.h"
+#include "quat2.h"
+#include "cpu.h"
+#include "simd.h"
+#include <math.h>
+
+static uint8_t skin_use_avx2 = 0;
+
+__attribute__((constructor))
+static void skin_dispatch(void) {
+    uint32_t features = cpu_features();
+    skin_use_avx2 = (features & CPU_AVX2) && (features & CPU_FMA);
+}
+
+static void skin_linearBlend_scalar(skin* dst, size_t begin, size_t n) {
+    size_t i;
+    uint8_t j, k;
+
+    for (i = begin; i < begin + n; i++) {
+        float m[12] = { 0 };
+        float* p = dst->positions + i * 3;
+        float* out = dst->out_positions + i * 3;
+
+        // Blend the affine part of the four joint matrices
+        for (j = 0; j < 4; j++) {
+            float w = dst->weights[i * 4 + j];
+            float* b = dst->palette + dst->joints[i * 4 + j] * 16;
+            for (k = 0; k < 3; k++) {
+                m[k] += w * b[k];
+                m[3 + k] += w * b[4 + k];
+                m[6 + k] += w * b[8 + k];
+                m[9 + k] += w * b[12 + k];
+            }
+        }
+
+        out[0] = m[0] * p[0] + m[3] * p[1] + m[6] * p[2] + m[9];
+        out[1] = m[1] * p[0] + m[4] * p[1] + m[7] * p[2] + m[10];
+        out[2] = m[2] * p[0] + m[5] * p[1] + m[8] * p[2] + m[11];
+
+        if (dst->normals) {
+            float* nr = dst->normals + i * 3;
+            out = dst->out_normals + i * 3;
+            out[0] = m[0] * nr[0] + m[3] * nr[1] + m[6] * nr[2];
+            out[1] = m[1] * nr[0] + m[4] * nr[1] + m[7] * nr[2];
+            out[2] = m[2] * nr[0] + m[5] * nr[1] + m[8] * nr[2];
+            vec3_normalize(out);
+        }
+    }
+}
+
+// Writes the skinned position and normal of vertex i from a blended dual quat
+static void skin_dualQuat_apply(skin* dst, size_t i, float* b) {
+    float* out = dst->out_positions + i * 3;
+    out[0] = dst->positions[i * 3];
+    out[1] = dst->positions[i * 3 + 1];
+    out[2] = dst->positions[i * 3 + 2];
+    quat2_transformPoint(out, b);
+
+    if (dst->normals) {
+        out = dst->out_normals + i * 3;
+        out[0] = dst->normals[i * 3];
+        out[1] = dst->normals[i * 3 + 1];
+        out[2] = dst->normals[i * 3 + 2];
+        vec3_transformQuat(out, b);
+    }
+}
+
+static void skin_dualQuat_scalar(skin* dst, size_t begin, size_t n) {
+    size_t i;
+    uint8_t j, k;
+
+    for (i = begin; i < begin + n; i++) {
+        float b[8] = { 0 };
+        float* first = dst->palette + dst->joints[i * 4] * 8;
+        float len;
+
+        for (j = 0; j < 4; j++) {
+            float w = dst->weights[i * 4 + j];
+            float* q = dst->palette + dst->joints[i * 4 + j] * 8;
+            // q and -q are the same transform, blend on the side of the first joint
+            if (quat2_dot(first, q) < 0) {
+                w = -w;
+            }
+            for (k = 0; k < 8; k++) {
+                b[k] += w * q[k];
+            }
+        }
+
+        len = sqrtf(b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3]);
+        if (len > 0) {
+            len = 1 / len;
+        }
+        for (k = 0; k < 8; k++) {
+            b[k] *= len;
+        }
+        skin_dualQuat_apply(dst, i, b);
+    }
+}
+
+#if GL_MATRIX_SIMD
+// Rotates the vectors [x, y, z] of eight lanes by the quats [qx, qy, qz, qw],
+// as in vec3_transformQuat
+#define SKIN_ROTATE_AVX2(x, y, z, qx, qy, qz, qw) do { \
+    __m256 uvx = _mm256_fmsub_ps(qy, z, _mm256_mul_ps(qz, y)); \
+    __m256 uvy = _mm256_fmsub_ps(qz, x, _mm256_mul_ps(qx, z)); \
+    __m256 uvz = _mm256_fmsub_ps(qx, y, _mm256_mul_ps(qy, x)); \
+    __m256 uuvx = _mm256_fmsub_ps(qy, uvz, _mm256_mul_ps(qz, uvy)); \
+    __m256 uuvy = _mm256_fmsub_ps(qz, uvx, _mm256_mul_ps(qx, uvz)); \
+    __m256 uuvz = _mm256_fmsub_ps(qx, uvy, _mm256_mul_ps(qy, uvx)); \
+    __m256 w2 = _mm256_add_ps(qw, qw); \
+    x = _mm256_fmadd_ps(uvx, w2, _mm256_fmadd_ps(uuvx, two, x)); \
+    y = _mm256_fmadd_ps(uvy, w2, _mm256_fmadd_ps(uuvy, two, y)); \
+    z = _mm256_fmadd_ps(uvz, w2, _mm256_fmadd_ps(uuvz, two, z)); \
+} while (0)
+
+// Eight vertices at a time: each palette entry is one 256-bit load, and
+// transposing eight of them gives one register per dual quat component
+SIMD_AVX2 static size_t skin_dualQuat_avx2(skin* dst, size_t begin, size_t n) {
+    __m256i idx3 = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    __m256i idx4 = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 two = _mm256_set1_ps(2.0f);
+    float out[3][8];
+    size_t i;
+    uint8_t j, k;
+
+    for (i = begin; i + 8 <= begin + n; i += 8) {
+        uint16_t* joints = dst->joints + i * 4;
+        __m256 b[8], q[8];
+        __m256 w = _mm256_i32gather_ps(dst->weights + i * 4, idx4, 4);
+
+        for (k = 0; k < 8; k++) {
+            b[k] = _mm256_loadu_ps(dst->palette + joints[k * 4] * 8);
+        }
+        simd_transpose8_ps(b);
+        __m256 first0 = b[0], first1 = b[1], first2 = b[2], first3 = b[3];
+        for (k = 0; k < 8; k++) {
+            b[k] = _mm256_mul_ps(w, b[k]);
+        }
+
+        for (j = 1; j < 4; j++) {
+            w = _mm256_i32gather_ps(dst->weights + i * 4 + j, idx4, 4);
+            for (k = 0; k < 8; k++) {
+                q[k] = _mm256_loadu_ps(dst->palette + joints[k * 4 + j] * 8);
+            }
+            simd_transpose8_ps(q);
+
+            // q and -q are the same transform, blend on the side of the first joint.
+            // The dot is rounded like quat2_dot so orthogonal joints pick the
+            // same side as the scalar code.
+            __m256 dot = _mm256_mul_ps(first0, q[0]);
+            dot = _mm256_add_ps(dot, _mm256_mul_ps(first1, q[1]));
+            dot = _mm256_add_ps(dot, _mm256_mul_ps(first2, q[2]));
+            dot = _mm256_add_ps(dot, _mm256_mul_ps(first3, q[3]));
+            w = _mm256_xor_ps(w, _mm256_and_ps(_mm256_cmp_ps(dot, zero, _CMP_LT_OQ), sign));
+            for (k = 0; k < 8; k++) {
+                b[k] = _mm256_fmadd_ps(w, q[k], b[k]);
+            }
+        }
+
+        // Divide both parts by the length of the real part
+        __m256 len = _mm256_mul_ps(b[0], b[0]);
+        len = _mm256_fmadd_ps(b[1], b[1], len);
+        len = _mm256_fmadd_ps(b[2], b[2], len);
+        len = _mm256_fmadd_ps(b[3], b[3], len);
+        __m256 nonzero = _mm256_cmp_ps(len, zero, _CMP_GT_OQ);
+        __m256 inv = _mm256_blendv_ps(one, _mm256_div_ps(one, _mm256_sqrt_ps(len)), nonzero);
+        for (k = 0; k < 8; k++) {
+            b[k] = _mm256_mul_ps(b[k], inv);
+        }
+
+        // Translation = 2 * dual * conjugate(real), as in quat2_getTranslation
+        __m256 tx = _mm256_mul_ps(b[4], b[3]);
+        tx = _mm256_fnmadd_ps(b[7], b[0], tx);
+        tx = _mm256_fmadd_ps(b[6], b[1], _mm256_fnmadd_ps(b[5], b[2], tx));
+        __m256 ty = _mm256_mul_ps(b[5], b[3]);
+        ty = _mm256_fnmadd_ps(b[7], b[1], ty);
+        ty = _mm256_fmadd_ps(b[4], b[2], _mm256_fnmadd_ps(b[6], b[0], ty));
+        __m256 tz = _mm256_mul_ps(b[6], b[3]);
+        tz = _mm256_fnmadd_ps(b[7], b[2], tz);
+        tz = _mm256_fmadd_ps(b[5], b[0], _mm256_fnmadd_ps(b[4], b[1], tz));
+
+        __m256 x = _mm256_i32gather_ps(dst->positions + i * 3, idx3, 4);
+        __m256 y = _mm256_i32gather_ps(dst->positions + i * 3 + 1, idx3, 4);
+        __m256 z = _mm256_i32gather_ps(dst->positions + i * 3 + 2, idx3, 4);
+        SKIN_ROTATE_AVX2(x, y, z, b[0], b[1], b[2], b[3]);
+        _mm256_storeu_ps(out[0], _mm256_fmadd_ps(tx, two, x));
+        _mm256_storeu_ps(out[1], _mm256_fmadd_ps(ty, two, y));
+        _mm256_storeu_ps(out[2], _mm256_fmadd_ps(tz, two, z));
+        for (k = 0; k < 8; k++) {
+            dst->out_positions[(i + k) * 3] = out[0][k];
+            dst->out_positions[(i + k) * 3 + 1] = out[1][k];
+            dst->out_positions[(i + k) * 3 + 2] = out[2][k];
+        }
+
+        if (dst->normals) {
+            x = _mm256_i32gather_ps(dst->normals + i * 3, idx3, 4);
+            y = _mm256_i32gather_ps(dst->normals + i * 3 + 1, idx3, 4);
+            z = _mm256_i32gather_ps(dst->normals + i * 3 + 2, idx3, 4);
+            SKIN_ROTATE_AVX2(x, y, z, b[0], b[1], b[2], b[3]);
+            _mm256_storeu_ps(out[0], x);
+            _mm256_storeu_ps(out[1], y);
+            _mm256_storeu_ps(out[2], z);
+            for (k = 0; k < 8; k++) {
+                dst->out_normals[(i + k) * 3] = out[0][k];
+                dst->out_normals[(i + k) * 3 + 1] = out[1][k];
+                dst->out_normals[(i + k) * 3 + 2] = out[2][k];
+            }
+        }
+    }
+    return i - begin;
+}
+
+#undef SKIN_ROTATE_AVX2
+
+SIMD_AVX2 static void skin_linearBlend_avx2(skin* dst, size_t begin, size_t n) {
+    size_t i;
+    uint8_t j;
+
+    for (i = begin; i < begin + n; i++) {
+        float* p = dst->positions + i * 3;
+        float out[4];
+        __m256 m01 = _mm256_setzero_ps();
+        __m256 m23 = _mm256_setzero_ps();
+
+        // Columns 0 and 1 of the blended matrix in m01, 2 and 3 in m23
+        for (j = 0; j < 4; j++) {
+            __m256 w = _mm256_set1_ps(dst->weights[i * 4 + j]);
+            float* b = dst->palette + dst->joints[i * 4 + j] * 16;
+            m01 = _mm256_fmadd_ps(w, _mm256_loadu_ps(b), m01);
+            m23 = _mm256_fmadd_ps(w, _mm256_loadu_ps(b + 8), m23);
+        }
+
+        // [c0 * x | c1 * y] + [c2 * z | c3], then fold the halves
+        __m256 xy = _mm256_setr_ps(p[0], p[0], p[0], p[0], p[1], p[1], p[1], p[1]);
+        __m256 z1 = _mm256_setr_ps(p[2], p[2], p[2], p[2], 1, 1, 1, 1);
+        __m256 r = _mm256_fmadd_ps(m01, xy, _mm256_mul_ps(m23, z1));
+        __m128 pos = _mm_add_ps(_mm256_castps256_ps128(r), _mm256_extractf128_ps(r, 1));
+        _mm_storeu_ps(out, pos);
+        dst->out_positions[i * 3] = out[0];
+        dst->out_positions[i * 3 + 1] = out[1];
+        dst->out_positions[i * 3 + 2] = out[2];
+
+        if (dst->normals) {
+            float* nr = dst->normals + i * 3;
+            __m256 nxy = _mm256_setr_ps(nr[0], nr[0], nr[0], nr[0], nr[1], nr[1], nr[1], nr[1]);
+            __m256 nz0 = _mm256_setr_ps(nr[2], nr[2], nr[2], nr[2], 0, 0, 0, 0);
+            __m256 t = _mm256_fmadd_ps(m01, nxy, _mm256_mul_ps(m23, nz0));
+            __m128 nrm = _mm_add_ps(_mm256_castps256_ps128(t), _mm256_extractf128_ps(t, 1));
+            // w of the sum is 0 for affine matrices, so a 4-wide dot product is safe
+            __m128 len = _mm_dp_ps(nrm, nrm, 0x77);
+            __m128 nonzero = _mm_cmpgt_ps(len, _mm_setzero_ps());
+            nrm = _mm_blendv_ps(nrm, _mm_div_ps(nrm, _mm_sqrt_ps(len)), nonzero);
+            _mm_storeu_ps(out, nrm);
+            dst->out_normals[i * 3] = out[0];
+            dst->out_normals[i * 3 + 1] = out[1];
+            dst->out_normals[i * 3 + 2] = out[2];
+        }
+    }
+}
+#endif
+
+/**
+ * Linear blend skinning of the vertices [begin, begin + n)
+ *
+ * @param {skin} out the mesh
+ * @param {Number} begin first vertex to skin
+ * @param {Number} n number of vertices to skin
+ */
+GL_MATRIX_API void skin_linearBlend(skin* dst, size_t begin, size_t n) {
+#if GL_MATRIX_SIMD
+    if (skin_use_avx2) {
+        skin_linearBlend_avx2(dst, begin, n);
+        return;
+    }
+#endif
+    skin_linearBlend_scalar(dst, begin, n);
+}
+
+static void skin_linearBlend_chunk(float* dst, size_t begin, size_t count, void* user) {
+    skin_linearBlend((skin*)user, begin, count);
+}
+
+/**
+ * Linear blend skinning of the whole mesh, split across the threads of a pool
+ *
+ * @param {skin} out the mesh
+ * @param {pool} p the pool to run on
+ */
+GL_MATRIX_API void skin_linearBlend_pool(skin* dst, pool* p) {
+    pool_op op = { POOL_CUSTOM, 0, 3, NULL, 0, NULL, skin_linearBlend_chunk, dst };
+    pool_run(p, dst->out_positions, dst->count, &op);
+}
+
+/**
+ * Dual quaternion skinning of the vertices [begin, begin + n)
+ *
+ * @param {skin} out the mesh, with a quat2 palette
+ * @param {Number} begin first vertex to skin
+ * @param {Number} n number of vertices to skin
+ */
+GL_MATRIX_API void skin_dualQuat(skin* dst, size_t begin, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (skin_use_avx2) {
+        i = skin_dualQuat_avx2(dst, begin, n);
+    }
+#endif
+    skin_dualQuat_scalar(dst, begin + i, n - i);
+}
+
+static void skin_dualQuat_chunk(float* dst, size_t begin, size_t count, void* user) {
+    skin_dualQuat((skin*)user, begin, count);
+}
+
+/**
+ * Dual quaternion skinning of the whole mesh, split across the threads of a pool
+ *
+ * @param {skin} out the mesh, with a quat2 palette
+ * @param {pool} p the pool to run on
+ */
+GL_MATRIX_API void skin_dualQuat_pool(skin* dst, pool* p) {
+    pool_op op = { POOL_CUSTOM, 0, 3, NULL, 0, NULL, skin_dualQuat_chunk, dst };
+    pool_run(p, dst->out_positions, dst->count, &op);
+}
@@ -0,0 +1,86 @@
+#ifndef SKIN_H
+#define SKIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+#include "pool.h"
+
+/**
+ * A skinned mesh of count vertices with four joint influences each.
+ * All arrays are caller storage:
+ *
+ * positions, normals          source vec3s, tightly packed
+ * joints                      4 palette indices per vertex
+ * weights                     4 weights per vertex, summing to 1
+ * palette                     one transform per joint, already combined
+ *                             with the inverse bind pose: a mat4 (16 floats)
+ *                             for linear blend skinning, a normalized quat2
+ *                             (8 floats) for dual quaternion skinning
+ * out_positions, out_normals  receiving vec3s, tightly packed
+ *
+ * normals and out_normals may be NULL to skin positions only.
+ */
+typedef struct {
+    float* positions;
+    float* normals;
+    uint16_t* joints;
+    float* weights;
+    float* palette;
+    float* out_positions;
+    float* out_normals;
+    size_t count;
+} skin;
+
+/**
+ * Linear blend skinning of the vertices [begin, begin + n)
+ * The four palette matrices of a vertex are blended into one matrix,
+ * which then transforms the position and the normal in the same pass.
+ * Palette matrices are assumed affine, and normals are renormalized.
+ *
+ * With AVX2/FMA each blended matrix is kept in two 256-bit registers, and
+ * fused multiply-adds may make results differ by a few ULP from the
+ * scalar path.
+ *
+ * @param {skin} out the mesh
+ * @param {Number} begin first vertex to skin
+ * @param {Number} n number of vertices to skin
+ */
+GL_MATRIX_API void skin_linearBlend(skin* dst, size_t begin, size_t n);
+
+/**
+ * Linear blend skinning of the whole mesh, split across the threads of a
+ * pool. The output is the same as skin_linearBlend(dst, 0, dst->count).
+ *
+ * @param {skin} out the mesh
+ * @param {pool} p the pool to run on
+ */
+GL_MATRIX_API void skin_linearBlend_pool(skin* dst, pool* p);
+
+/**
+ * Dual quaternion skinning of the vertices [begin, begin + n)
+ * The four palette dual quats of a vertex are blended on the same
+ * hemisphere as the first one and normalized, which keeps the volume that
+ * linear blend skinning loses around twisting joints. The blended dual
+ * quat then transforms the position and rotates the normal. A palette
+ * entry is half the size of a mat4, which halves the palette bandwidth.
+ *
+ * With AVX2/FMA eight vertices are skinned at a time, and fused
+ * multiply-adds may make results differ by a few ULP from the scalar path.
+ *
+ * @param {skin} out the mesh, with a quat2 palette
+ * @param {Number} begin first vertex to skin
+ * @param {Number} n number of vertices to skin
+ */
+GL_MATRIX_API void skin_dualQuat(skin* dst, size_t begin, size_t n);
+
+/**
+ * Dual quaternion skinning of the whole mesh, split across the threads of
+ * a pool. The output is the same as skin_dualQuat(dst, 0, dst->count).
+ *
+ * @param {skin} out the mesh, with a quat2 palette
+ * @param {pool} p the pool to run on
+ */
+GL_MATRIX_API void skin_dualQuat_pool(skin* dst, pool* p);
+
+#endif
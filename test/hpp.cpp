@@ -0,0 +1,171 @@
+/*
+ * Tests for gl-matrix.hpp.
+ *
+ * Every case evaluates an expression with the C++ layer and the same
+ * operations as a chain of C calls, and requires bitwise equal results:
+ * fusing a chain into one pass must not change its rounding. Built
+ * header-only, so it also checks that the implementation compiles as C++.
+ */
+#include "gl-matrix.hpp"
+#include <cstdio>
+#include <cstring>
+
+using namespace gl_matrix;
+
+static_assert(sizeof(vec3) == 3 * sizeof(float) && sizeof(mat4) == 16 * sizeof(float), "values are bare floats");
+static_assert(std::is_standard_layout_v<mat4> && std::is_trivially_copyable_v<mat4>, "values are C compatible");
+
+static int cases, failed;
+
+static void check(const char* name, const float* got, const float* expected, size_t n) {
+    cases++;
+    if (memcmp(got, expected, n * sizeof(float))) {
+        failed++;
+        printf("FAIL %s\n", name);
+        for (size_t i = 0; i < n; i++) {
+            printf("    [%zu] = %.9g, expected %.9g\n", i, got[i], expected[i]);
+        }
+    }
+}
+
+int main() {
+    vec3 a(1.5f, -2.25f, 0.1f), b(0.3f, 7, -1), c(-4, 0.7f, 2.5f);
+    vec4 h(0.2f, 0.4f, -0.6f, 1);
+    quat q(0.1f, 0.7f, -0.1f, 0.7f), r(-0.5f, 0.5f, 0.5f, 0.5f);
+    mat4 m, n;
+    mat3 k;
+    float s = 0.37f, t = 0.8f;
+    float e[16], f[16];
+
+    mat4_fromRotationTranslationScale(m.data(), q.data(), b.data(), c.data());
+    mat4_perspective(n.data(), 1.1f, 1.5f, 0.1f, 100);
+    mat3_fromMat4(k.data(), m.data());
+
+    vec3 fused = a * s + b - c;
+    vec3_copy(e, a.data());
+    vec3_scale(e, s);
+    vec3_add(e, b.data());
+    vec3_subtract(e, c.data());
+    check("a * s + b - c", fused.data(), e, 3);
+
+    vec3 moved = m * (a * s + b) + c;
+    vec3_copy(e, a.data());
+    vec3_scale(e, s);
+    vec3_add(e, b.data());
+    vec3_transformMat4(e, m.data());
+    vec3_add(e, c.data());
+    check("m * (a * s + b) + c", moved.data(), e, 3);
+
+    vec3 blend = lerp(a, b, t) * c / 2 - -a;
+    vec3_copy(e, a.data());
+    vec3_lerp(e, b.data(), t);
+    vec3_multiply(e, c.data());
+    vec3_scale(e, 0.5f);
+    vec3_add(e, a.data());
+    check("lerp(a, b, t) * c / 2 - -a", blend.data(), e, 3);
+
+    vec3 bounds = max(min(a, b), c);
+    vec3_copy(e, a.data());
+    vec3_min(e, b.data());
+    vec3_max(e, c.data());
+    check("max(min(a, b), c)", bounds.data(), e, 3);
+
+    vec3 normal = normalize(cross(b - a, c - a));
+    vec3_copy(e, b.data());
+    vec3_subtract(e, a.data());
+    vec3_copy(f, c.data());
+    vec3_subtract(f, a.data());
+    vec3_cross(e, f);
+    vec3_normalize(e);
+    check("normalize(cross(b - a, c - a))", normal.data(), e, 3);
+
+    float d = dot(a + b, c);
+    vec3_copy(e, a.data());
+    vec3_add(e, b.data());
+    f[0] = vec3_dot(e, c.data());
+    check("dot(a + b, c)", &d, f, 1);
+
+    vec3 rotated = q * (k * a);
+    vec3_copy(e, a.data());
+    vec3_transformMat3(e, k.data());
+    vec3_transformQuat(e, q.data());
+    check("q * (k * a)", rotated.data(), e, 3);
+
+    vec4 clip = n * (m * h);
+    vec4_copy(e, h.data());
+    vec4_transformMat4(e, m.data());
+    vec4_transformMat4(e, n.data());
+    check("n * (m * h)", clip.data(), e, 4);
+
+    quat spin = normalize(slerp(q * r, conjugate(r), t));
+    vec4_copy(e, q.data());
+    quat_multiply(e, r.data());
+    vec4_copy(f, r.data());
+    quat_conjugate(f);
+    quat_slerp(e, f, t);
+    vec4_normalize(e);
+    check("normalize(slerp(q * r, conjugate(r), t))", spin.data(), e, 4);
+
+    mat4 mvp = transpose(n * m) * 2.0f - m;
+    mat4_copy(e, n.data());
+    mat4_multiply(e, m.data());
+    mat4_transpose(e);
+    mat4_multiplyScalar(e, 2);
+    mat4_subtract(e, m.data());
+    check("transpose(n * m) * 2 - m", mvp.data(), e, 16);
+
+    // In place through refs, with the destination on both sides
+    float buffer[6] = { 1, 2, 3, 4, 5, 6 };
+    vec3_ref first(buffer), second(buffer + 3);
+    first = first * s + second;
+    second = second + a;
+    vec3_set(e, 1, 2, 3);
+    vec3_set(f, 4, 5, 6);
+    vec3_scale(e, s);
+    vec3_add(e, f);
+    vec3_add(f, a.data());
+    check("first = first * s + second", buffer, e, 3);
+    check("second = second + a", buffer + 3, f, 3);
+
+    vec3 sum = a;
+    sum += b;
+    sum -= c;
+    sum *= s;
+    vec3_copy(e, a.data());
+    vec3_add(e, b.data());
+    vec3_subtract(e, c.data());
+    vec3_scale(e, s);
+    check("sum += b, -= c, *= s", sum.data(), e, 3);
+
+    // Constant initializers against the functions they stand for
+    constexpr mat4 ortho = MAT4_ORTHO(0, 1280, 0, 720, -1, 1);
+    constexpr mat4 frustum = MAT4_FRUSTUM(-0.2f, 0.3f, -0.1f, 0.15f, 0.1f, 100);
+    // GCC folds the tanf of MAT4_PERSPECTIVE, see gl-matrix.hpp
+    constexpr mat4 perspective = MAT4_PERSPECTIVE(1.1f, 1.5f, 0.1f, 100);
+    constexpr mat4 infinite = MAT4_PERSPECTIVE(0.9f, 16.0f / 9, 0.05f, 0);
+    constexpr mat4 moving = MAT4_FROM_TRANSLATION(1.5f, -2, 0.1f);
+    constexpr mat4 scaling = MAT4_FROM_SCALING(2, 0.5f, -1);
+    constexpr mat3 screen = MAT3_PROJECTION(1280, 720);
+    static_assert(ortho[0] == 2.0f / 1280 && ortho[15] == 1, "folds at compile time");
+    static_assert(perspective[11] == -1 && infinite[10] == -1, "folds at compile time");
+
+    mat4_ortho(e, 0, 1280, 0, 720, -1, 1);
+    check("MAT4_ORTHO", ortho.data(), e, 16);
+    mat4_frustum(e, -0.2f, 0.3f, -0.1f, 0.15f, 0.1f, 100);
+    check("MAT4_FRUSTUM", frustum.data(), e, 16);
+    mat4_perspective(e, 1.1f, 1.5f, 0.1f, 100);
+    check("MAT4_PERSPECTIVE", perspective.data(), e, 16);
+    mat4_perspective(e, 0.9f, 16.0f / 9, 0.05f, 0);
+    check("MAT4_PERSPECTIVE infinite", infinite.data(), e, 16);
+    vec3_set(f, 1.5f, -2, 0.1f);
+    mat4_fromTranslation(e, f);
+    check("MAT4_FROM_TRANSLATION", moving.data(), e, 16);
+    vec3_set(f, 2, 0.5f, -1);
+    mat4_fromScaling(e, f);
+    check("MAT4_FROM_SCALING", scaling.data(), e, 16);
+    mat3_projection(e, 1280, 720);
+    check("MAT3_PROJECTION", screen.data(), e, 9);
+
+    printf("%d cases, %d failed\n", cases, failed);
+    return failed != 0;
+}
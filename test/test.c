@@ -0,0 +1,1506 @@
+/*
+ * Accuracy tests for the public gl-matrix functions.
+ *
+ * Every case runs a function on randomized and adversarial inputs and
+ * compares the float result with a long double reference: either the same
+ * function generated in long double from the float sources (reference.h,
+ * see test/longdouble.sed), or an independent long double computation of
+ * what the function promises, for the fast paths that approximate (slerp
+ * polynomials, packing, skinning).
+ *
+ * Errors are measured in ULPs of the largest reference component of each
+ * result (a matrix, a vector, a scalar), so that rounding in a component
+ * that cancelled to nearly zero does not count against a function that is
+ * accurate in norm. Each case gives a floor for that scale: 1 for
+ * quantized formats like snorm16, whose error is absolute, and the operand
+ * norms for dots, cross products and lerps, whose results may cancel. A case fails when its worst
+ * error across all iterations exceeds its budget; the budgets are about
+ * twice the worst error measured on the scalar and SIMD paths, so a kernel
+ * that drifts from the scalar code fails here. They come from runs of 1000
+ * iterations over several seeds: inverses and conversions of badly
+ * conditioned inputs have long tails, which much longer runs can reach.
+ *
+ * Every fourth iteration uses adversarial inputs: large translations and
+ * extreme scales, nearly identical and nearly antipodal quaternions, t at
+ * exactly 0 and 1, axis aligned normals, half precision specials. Batches
+ * have odd sizes so that the scalar tails of the SIMD kernels run too.
+ *
+ * Functions documented to give the same results as another function, such
+ * as a batch and the single call it repeats, are also compared with it
+ * bitwise on the same inputs (see SAME_CASES).
+ *
+ * test/dtest.c is generated from this file by double.sed, like the double
+ * modules, and runs the cases of the modules they cover in double against
+ * the same references, on the same random inputs. The modules and entry
+ * points that only exist in single precision are between "Float only"
+ * markers, which double.sed leaves out.
+ *
+ *   test [--iters N] [--seed N] [--filter STR] [--verbose]
+ */
+#include "gl-matrix.h"
+#include "reference.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BATCH 37
+#define JOINTS 16
+// Large enough for several pool chunks of vec3s, vec4s and skinned vertices
+#define BIG 6007
+#define BIGM 1129
+#define WORK (BIG * 6)
+
+enum {
+    K_NONE, K_MAT2, K_MAT3, K_MAT4, K_VEC, K_QUAT, K_QUAT2, K_BMAT4, K_BVEC, K_BQUAT,
+    K_SOA, K_RANGE, K_HALF, K_NORMALS, K_BIG, K_BIGM, K_COUNT
+};
+
+// Operands and results are aligned for the _aligned functions
+#define ALIGNED GL_MATRIX_ALIGNED(64)
+
+// Operands, with long double copies holding exactly the same values
+#define OPERANDS(X) \
+    X(m2, 4) X(n2, 4) X(m3, 9) X(n3, 9) X(m4, 16) X(n4, 16) X(proj, 16) X(planes, 24) \
+    X(a, 4) X(b, 4) X(c, 4) X(e, 4) X(axis, 4) X(sc, 4) X(sph, 4) X(box, 4) \
+    X(q, 4) X(r, 4) X(dq, 8) X(dr, 8) X(s, 1) X(t, 1) X(rad, 1) \
+    X(bm, BATCH * 16) X(bn, BATCH * 16) X(bv, BATCH * 4) X(bq, BATCH * 4) X(br, BATCH * 4) X(bt, BATCH) \
+    X(bsa, BATCH * 4) X(bsb, BATCH * 4) X(bext, BATCH * 4) X(brange, BATCH * 4) X(bhalf, BATCH * 4) \
+    X(bnorm, BATCH * 3) X(big, BIG * 4) X(bigm, BIGM * 16) \
+    X(tree_t, BATCH * 3) X(tree_r, BATCH * 4) X(tree_s, BATCH * 3) \
+    X(skin_pos, BIG * 3) X(skin_nrm, BIG * 3) X(skin_weights, BIG * 4) X(skin_mats, JOINTS * 16) X(skin_dqs, JOINTS * 8)
+
+#define DECLARE_OPERAND(name, size) static float name[size] ALIGNED; static long double l##name[size];
+OPERANDS(DECLARE_OPERAND)
+
+static float up[3] = { 0, 1, 0 };
+static long double lup[3] = { 0, 1, 0 };
+
+// Integer operands of the hierarchy and skin cases
+static int32_t tree_parent[BATCH];
+static uint16_t skin_joints[BIG * 4];
+
+// Double precision operands of the relative module
+static double dm[16], dorigin[3], dpts[BATCH * 3];
+
+// Results
+static float d[WORK] ALIGNED;
+static float expected[WORK] ALIGNED;
+static long double ld[WORK];
+static uint8_t ok[BIGM], lok[BIGM];
+
+// Float only
+static mat3_aligned p3;
+static float m43[12], bn43[BATCH * 12];
+static uint8_t bits[BATCH], lbits[BATCH];
+static uint16_t half[BATCH * 4];
+static int16_t snorm[BATCH * 4];
+static uint8_t unorm[BATCH * 4];
+static uint16_t packed48[BATCH * 3];
+static uint32_t packed32[BATCH];
+
+// SoA views of d and of the operands
+static vec3soa sa3 = { d, d + BATCH, d + BATCH * 2 };
+static vec3soa sb3 = { bsb, bsb + BATCH, bsb + BATCH * 2 };
+static vec3soa ext3 = { bext, bext + BATCH, bext + BATCH * 2 };
+static vec4soa sa4 = { d, d + BATCH, d + BATCH * 2, d + BATCH * 3 };
+static vec4soa sb4 = { bsb, bsb + BATCH, bsb + BATCH * 2, bsb + BATCH * 3 };
+static lvec3soa lsa3 = { ld, ld + BATCH, ld + BATCH * 2 };
+static lvec3soa lsb3 = { lbsb, lbsb + BATCH, lbsb + BATCH * 2 };
+static lvec3soa lext3 = { lbext, lbext + BATCH, lbext + BATCH * 2 };
+static lvec4soa lsa4 = { ld, ld + BATCH, ld + BATCH * 2, ld + BATCH * 3 };
+static lvec4soa lsb4 = { lbsb, lbsb + BATCH, lbsb + BATCH * 2, lbsb + BATCH * 3 };
+
+// A hierarchy of BATCH nodes
+static float tree_local[BATCH * 16], tree_world[BATCH * 16];
+static long double ltree_local[BATCH * 16], ltree_world[BATCH * 16];
+static uint8_t tree_dirty[BATCH], ltree_dirty[BATCH];
+static hierarchy tree = { tree_parent, tree_t, tree_r, tree_s, tree_local, tree_world, tree_dirty, BATCH };
+static lhierarchy ltree = { tree_parent, ltree_t, ltree_r, ltree_s, ltree_local, ltree_world, ltree_dirty, BATCH };
+
+// A skinned mesh of BIG vertices, skinned into d: positions, then normals
+static skin mesh = { skin_pos, skin_nrm, skin_joints, skin_weights, skin_mats, d, d + BIG * 3, BIG };
+static skin mesh_dq = { skin_pos, skin_nrm, skin_joints, skin_weights, skin_dqs, d, d + BIG * 3, BIG };
+static skin mesh_expected = { skin_pos, skin_nrm, skin_joints, skin_weights, skin_mats, expected, expected + BIG * 3, BIG };
+static skin mesh_dq_expected = { skin_pos, skin_nrm, skin_joints, skin_weights, skin_dqs, expected, expected + BIG * 3, BIG };
+
+static pool workers;
+static pool_op op_vec3 = { POOL_VEC3_TRANSFORM_MAT4, 0, 3, big, 3, m4 };
+static pool_op op_vec3_affine = { POOL_VEC3_TRANSFORM_MAT4_AFFINE, POOL_DETERMINISTIC, 3, big, 4, m4 };
+static pool_op op_vec4 = { POOL_VEC4_TRANSFORM_MAT4, 0, 4, big, 4, m4 };
+static pool_op op_multiply = { POOL_MAT4_MULTIPLY, 0, 16, NULL, 0, n4 };
+// The mat4 operations ignore strides, these must not move the chunks
+static pool_op op_multiply_strided = { POOL_MAT4_MULTIPLY, 0, 20, NULL, 20, n4 };
+static pool_op op_pairwise = { POOL_MAT4_MULTIPLY_PAIRWISE, 0, 16, big, 16, NULL };
+static pool_op op_invert = { POOL_MAT4_INVERT, 0, 16 };
+// End float only
+
+/*
+ * Random inputs
+ */
+static uint64_t rng = 1;
+
+// xorshift64*, so the inputs only depend on the seed
+static uint32_t rnd_next(void) {
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return (uint32_t)((rng * 0x2545f4914f6cdd1dull) >> 32);
+}
+
+// Uniform in [lo, hi)
+static float rnd(float lo, float hi) {
+    return lo + (hi - lo) * (float)(rnd_next() >> 8) * (1.0f / 16777216);
+}
+
+// Uniform in [lo, hi) on a log scale
+static float rnd_log(float lo, float hi) {
+    return expf(rnd(logf(lo), logf(hi)));
+}
+
+static void rnd_vec(float* dst, size_t n, float scale) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        dst[i] = rnd(-1, 1) * scale;
+    }
+}
+
+static void rnd_unit(float* dst, size_t n) {
+    float len;
+    do {
+        rnd_vec(dst, n, 1);
+        len = n == 4 ? vec4_length(dst) : vec3_length(dst);
+    } while (len < 0.1f || len > 1);
+    if (n == 4) {
+        vec4_normalize(dst);
+    }
+    else {
+        vec3_normalize(dst);
+    }
+}
+
+// A unit quat, adversarial ones have equal or zero components. M_SQRT1_2
+// rounds to a unit length in double as well
+static void rnd_quat(float* dst, uint8_t hard) {
+    static const float specials[4][4] = {
+        { 0, 0, 0, 1 }, { 0.5f, 0.5f, 0.5f, 0.5f }, { M_SQRT1_2, M_SQRT1_2, 0, 0 }, { M_SQRT1_2, 0, 0, M_SQRT1_2 }
+    };
+    size_t i, k;
+    float tmp;
+
+    rnd_unit(dst, 4);
+    if (hard && (rnd_next() & 1)) {
+        vec4_copy(dst, (float*)specials[rnd_next() % 4]);
+        for (i = 0; i < 4; i++) {
+            k = rnd_next() % 4;
+            tmp = dst[i];
+            dst[i] = dst[k] * (rnd_next() & 1 ? -1 : 1);
+            dst[k] = tmp;
+        }
+    }
+}
+
+// A quat close to a or to -a
+static void rnd_nearQuat(float* dst, float* a) {
+    float eps = rnd_log(1e-7f, 1e-2f);
+    float sign = rnd_next() & 1 ? -1 : 1;
+    size_t i;
+    for (i = 0; i < 4; i++) {
+        dst[i] = (a[i] + rnd(-eps, eps)) * sign;
+    }
+    vec4_normalize(dst);
+}
+
+// A translation, rotation and non-uniform scale
+static void rnd_trs(float* dst, uint8_t hard) {
+    float rot[4], tr[3], scale[3];
+    size_t i;
+    rnd_quat(rot, hard);
+    for (i = 0; i < 3; i++) {
+        tr[i] = rnd(-10, 10) * (hard ? 100 : 1);
+        scale[i] = hard ? rnd_log(1e-2f, 1e2f) : rnd(0.5f, 2);
+    }
+    mat4_fromRotationTranslationScale(dst, rot, tr, scale);
+}
+
+// A unit dual quat
+static void rnd_quat2(float* dst, uint8_t hard) {
+    float rot[4], tr[3];
+    rnd_quat(rot, hard);
+    rnd_vec(tr, 3, hard ? 1000 : 10);
+    quat2_fromRotationTranslation(dst, rot, tr);
+}
+
+// A value whose half is normal, subnormal, overflows or is special
+static float rnd_half(uint8_t hard) {
+    static const float specials[] = {
+        0.0f, -0.0f, INFINITY, -INFINITY, NAN, 65504.0f, 65519.99f, 65520.0f, -65520.0f,
+        6.1035156e-5f, 6.0975552e-5f, 5.9604645e-8f, 2.9802322e-8f, 2.9802326e-8f, 1.0009766f, 1.0004883f
+    };
+    if (hard && (rnd_next() & 1)) {
+        return specials[rnd_next() % (sizeof(specials) / sizeof(specials[0]))];
+    }
+    return rnd(-1, 1) * exp2f(rnd(-26, 17));
+}
+
+// A unit normal, adversarial ones are on or next to the octahedron edges
+static void rnd_normal(float* dst, uint8_t hard) {
+    size_t i;
+    rnd_unit(dst, 3);
+    if (hard && (rnd_next() & 1)) {
+        for (i = 0; i < 3; i++) {
+            if (rnd_next() & 1) {
+                dst[i] = rnd_next() & 1 ? 0 : rnd(-1e-6f, 1e-6f);
+            }
+        }
+        if (vec3_length(dst) < 1e-3f) {
+            dst[rnd_next() % 3] = rnd_next() & 1 ? 1 : -1;
+        }
+        vec3_normalize(dst);
+    }
+}
+
+static void widen(long double* dst, float* a, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        dst[i] = a[i];
+    }
+}
+
+// Euclidean norm of n components step apart
+static long double lnorm(long double* a, size_t n, size_t step) {
+    long double sum = 0;
+    size_t i;
+    for (i = 0; i < n; i++) {
+        sum += a[i * step] * a[i * step];
+    }
+    return sqrtl(sum);
+}
+
+static void generate(uint8_t hard) {
+    // Adversarial vectors are tiny or huge, but alike within an iteration
+    float scale = hard ? rnd_log(1e-3f, 1e3f) : 1;
+    size_t i, k;
+
+    rnd_trs(m4, hard);
+    rnd_trs(n4, hard);
+    mat3_fromMat4(m3, m4);
+    mat3_fromMat4(n3, n4);
+    mat2_fromRotation(m2, rnd(-3.14159265f, 3.14159265f));
+    mat2_fromRotation(n2, rnd(-3.14159265f, 3.14159265f));
+    for (i = 0; i < 4; i++) {
+        m2[i] *= rnd(0.5f, 2);
+        n2[i] *= rnd(0.5f, 2);
+    }
+    mat4_perspective(proj, 1, 1.5f, 0.1f, 100);
+    mat4_multiply(proj, n4);
+    // Float only
+    frustum_fromMat4(planes, proj);
+    // End float only
+
+    rnd_vec(a, 4, scale);
+    rnd_vec(b, 4, scale);
+    rnd_vec(c, 4, scale);
+    rnd_vec(e, 4, scale);
+    rnd_unit(axis, 3);
+    for (i = 0; i < 3; i++) {
+        sc[i] = rnd(0.5f, 2);
+        sph[i] = rnd(-30, 30);
+        box[i] = rnd(0, 5);
+    }
+    sph[3] = rnd(0, 5);
+    rnd_quat(q, hard);
+    if (hard) {
+        rnd_nearQuat(r, q);
+    }
+    else {
+        rnd_quat(r, 0);
+    }
+    rnd_quat2(dq, hard);
+    rnd_quat2(dr, hard);
+    s[0] = rnd(-2, 2);
+    t[0] = hard ? (float)(rnd_next() % 3) / 2 : rnd(0, 1);
+    rad[0] = hard ? (float)(rnd_next() % 5) * 1.57079633f - 3.14159265f : rnd(-3.14159265f, 3.14159265f);
+
+    for (i = 0; i < BATCH; i++) {
+        rnd_trs(bm + i * 16, hard);
+        rnd_trs(bn + i * 16, hard);
+        rnd_vec(bv + i * 4, 4, scale);
+        rnd_quat(bq + i * 4, hard);
+        if (hard && (i & 1)) {
+            rnd_nearQuat(br + i * 4, bq + i * 4);
+        }
+        else {
+            rnd_quat(br + i * 4, hard);
+        }
+        bt[i] = hard && (i % 3) ? (float)(i % 3 - 1) : rnd(0, 1);
+        for (k = 0; k < 4; k++) {
+            bsa[k * BATCH + i] = rnd(-30, 30);
+            bsb[k * BATCH + i] = rnd(-1, 1);
+            bext[k * BATCH + i] = rnd(0, 5);
+            brange[i * 4 + k] = rnd(-1.25f, 1.25f);
+            bhalf[i * 4 + k] = rnd_half(hard);
+        }
+        bsa[3 * BATCH + i] = rnd(0, 5);
+        rnd_normal(bnorm + i * 3, hard);
+    }
+    rnd_vec(big, BIG * 4, 1);
+    for (i = 0; i < BIGM; i++) {
+        rnd_trs(bigm + i * 16, hard);
+    }
+
+    for (i = 0; i < BATCH; i++) {
+        tree_parent[i] = hard ? (int32_t)i - 1 : (int32_t)(rnd_next() % (i + 1)) - 1;
+        rnd_vec(tree_t + i * 3, 3, hard ? 100 : 2);
+        rnd_quat(tree_r + i * 4, hard);
+        for (k = 0; k < 3; k++) {
+            tree_s[i * 3 + k] = rnd(0.8f, 1.25f);
+        }
+    }
+
+    for (i = 0; i < JOINTS; i++) {
+        rnd_trs(skin_mats + i * 16, 0);
+        rnd_quat2(skin_dqs + i * 8, hard);
+    }
+    for (i = 0; i < BIG; i++) {
+        float w[4], sum;
+        rnd_vec(skin_pos + i * 3, 3, 1);
+        rnd_normal(skin_nrm + i * 3, 0);
+        sum = 0;
+        for (k = 0; k < 4; k++) {
+            skin_joints[i * 4 + k] = rnd_next() % JOINTS;
+            w[k] = hard && k && (i & 1) ? 0 : rnd(0, 1);
+            sum += w[k];
+        }
+        for (k = 0; k < 4; k++) {
+            skin_weights[i * 4 + k] = w[k] / sum;
+        }
+    }
+
+    for (i = 0; i < 3; i++) {
+        dorigin[i] = (double)rnd(-1, 1) * (hard ? 1e8 : 1e6);
+    }
+    for (i = 0; i < 16; i++) {
+        dm[i] = m4[i];
+    }
+    for (i = 0; i < 3; i++) {
+        dm[12 + i] += dorigin[i];
+    }
+    for (i = 0; i < BATCH * 3; i++) {
+        dpts[i] = dorigin[i % 3] + rnd(-100, 100);
+    }
+
+#define WIDEN_OPERAND(name, size) widen(l##name, name, size);
+    OPERANDS(WIDEN_OPERAND)
+}
+
+/*
+ * Helpers for cases that need more than one call
+ */
+
+// Replaces a packed quat by its round trip, on the side of the original
+static void align_quats(float* dst, float* a, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        if (vec4_dot(dst + i * 4, a + i * 4) < 0) {
+            vec4_negate(dst + i * 4);
+        }
+    }
+}
+
+// Float only
+static void quat_pack48_roundTrip(void) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        quat_pack48(packed48 + i * 3, d + i * 4);
+        quat_unpack48(d + i * 4, packed48 + i * 3);
+    }
+    align_quats(d, bq, BATCH);
+}
+
+static void quat_pack32_roundTrip(void) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        quat_pack32(packed32 + i, d + i * 4);
+        quat_unpack32(d + i * 4, packed32 + i);
+    }
+    align_quats(d, bq, BATCH);
+}
+
+static void quat_unpack48_n_roundTrip(void) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        quat_pack48(packed48 + i * 3, d + i * 4);
+    }
+    quat_unpack48_n(d, packed48, BATCH);
+    align_quats(d, bq, BATCH);
+}
+
+static void quat_unpack32_n_roundTrip(void) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        quat_pack32(packed32 + i, d + i * 4);
+    }
+    quat_unpack32_n(d, packed32, BATCH);
+    align_quats(d, bq, BATCH);
+}
+// End float only
+
+static void mat4_getRotation_roundTrip(void) {
+    float m[16];
+    mat4_fromRotationTranslation(m, q, b);
+    mat4_getRotation(d, m);
+    align_quats(d, q, 1);
+}
+
+static void quat_fromMat3_roundTrip(void) {
+    float m[9];
+    mat3_fromQuat(m, q);
+    quat_fromMat3(d, m);
+    align_quats(d, q, 1);
+}
+
+// Float only
+static void pack_octahedral_roundTrip(void) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        pack_toOctahedral(snorm + i * 2, d + i * 3);
+        pack_fromOctahedral(d + i * 3, snorm + i * 2);
+    }
+}
+
+// The nearest half of a, rounded to even, as a long double
+static long double ref_half(long double a) {
+    long double quantum;
+    if (isnan(a) || isinf(a)) {
+        return a;
+    }
+    quantum = fabsl(a) < 0x1p-14L ? 0x1p-24L : ldexpl(1, ilogbl(a) - 10);
+    a = rintl(a / quantum) * quantum;
+    return fabsl(a) >= 65520 ? copysignl(INFINITY, a) : a;
+}
+
+static void ref_halves(size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        ld[i] = ref_half(ld[i]);
+    }
+}
+
+static void ref_clamp(long double lo, long double hi, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        ld[i] = fminl(fmaxl(ld[i], lo), hi);
+    }
+}
+
+// Slerp through the angle between the quats, on the side the float dot
+// picks: for orthogonal quats both sides are right
+static void ref_slerp_n(void) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        long double* x = ld + i * 4;
+        long double* y = lbr + i * 4;
+        long double sign = vec4_dot(bq + i * 4, br + i * 4) < 0 ? -1 : 1;
+        long double cosom = fminl(fabsl(lvec4_dot(x, y)), 1);
+        long double omega = acosl(cosom), sinom = sinl(omega), s0, s1;
+        size_t k;
+
+        if (sinom < 1e-12L) {
+            s0 = 1 - lbt[i];
+            s1 = lbt[i];
+        }
+        else {
+            s0 = sinl((1 - lbt[i]) * omega) / sinom;
+            s1 = sinl(lbt[i] * omega) / sinom;
+        }
+        for (k = 0; k < 4; k++) {
+            x[k] = s0 * x[k] + s1 * sign * y[k];
+        }
+        lvec4_normalize(x);
+    }
+}
+
+// Moves one node after a full update, the operands are regenerated before
+// the next iteration
+static void hierarchy_updatePartial(void) {
+    hierarchy_markAllDirty(&tree);
+    hierarchy_update(&tree);
+    hierarchy_setTRS(&tree, BATCH / 2, a, q, sc);
+    hierarchy_markDirty(&tree, 1);
+    hierarchy_update(&tree);
+    memcpy(d, tree_world, sizeof(tree_world));
+}
+
+// Changes the TRS of node 3 without marking it dirty, then updates the
+// block through node 7. Node 3 has to keep its old local matrix.
+static void hierarchy_updateClean(void) {
+    float x = tree_t[9];
+    hierarchy_markAllDirty(&tree);
+    hierarchy_update(&tree);
+    tree_t[9] = x + 1;
+    hierarchy_markDirty(&tree, 7);
+    hierarchy_update(&tree);
+    tree_t[9] = x;
+    memcpy(d, tree_local, sizeof(tree_local));
+}
+
+static void ref_hierarchy_updatePartial(void) {
+    lhierarchy_markAllDirty(&ltree);
+    lhierarchy_update(&ltree);
+    lhierarchy_setTRS(&ltree, BATCH / 2, la, lq, lsc);
+    lhierarchy_markDirty(&ltree, 1);
+    lhierarchy_update(&ltree);
+    memcpy(ld, ltree_world, sizeof(ltree_world));
+}
+
+// The affine blend of the four palette matrices, applied to the position
+// and the renormalized normal
+static void ref_skin_linearBlend(void) {
+    size_t i, j, k;
+    for (i = 0; i < BIG; i++) {
+        long double m[16] = { 0 };
+        long double* out = ld + i * 3;
+        long double* nr = ld + BIG * 3 + i * 3;
+        for (j = 0; j < 4; j++) {
+            for (k = 0; k < 16; k++) {
+                m[k] += lskin_weights[i * 4 + j] * lskin_mats[skin_joints[i * 4 + j] * 16 + k];
+            }
+        }
+        lvec3_copy(out, lskin_pos + i * 3);
+        lvec3_transformMat4(out, m);
+        for (k = 0; k < 3; k++) {
+            nr[k] = m[k] * lskin_nrm[i * 3] + m[4 + k] * lskin_nrm[i * 3 + 1] + m[8 + k] * lskin_nrm[i * 3 + 2];
+        }
+        lvec3_normalize(nr);
+    }
+}
+
+// The normalized blend of the palette dual quats on the side of the first
+// joint as the float dot decides it, applied to the position and the normal
+static void ref_skin_dualQuat(void) {
+    size_t i, j, k;
+    for (i = 0; i < BIG; i++) {
+        long double blend[8] = { 0 }, len;
+        long double* first = lskin_dqs + skin_joints[i * 4] * 8;
+        long double* out = ld + i * 3;
+        long double* nr = ld + BIG * 3 + i * 3;
+        for (j = 0; j < 4; j++) {
+            long double* x = lskin_dqs + skin_joints[i * 4 + j] * 8;
+            long double w = lskin_weights[i * 4 + j] * (quat2_dot(skin_dqs + (first - lskin_dqs), skin_dqs + (x - lskin_dqs)) < 0 ? -1 : 1);
+            for (k = 0; k < 8; k++) {
+                blend[k] += w * x[k];
+            }
+        }
+        len = lvec4_length(blend);
+        for (k = 0; k < 8; k++) {
+            blend[k] /= len;
+        }
+        lvec3_copy(out, lskin_pos + i * 3);
+        lquat2_transformPoint(out, blend);
+        lvec3_copy(nr, lskin_nrm + i * 3);
+        lvec3_transformQuat(nr, blend);
+    }
+}
+// End float only
+
+static void ref_vec4_transformMat4_n(long double* dst, long double* src, long double* m, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        lvec4_copy(dst + i * 4, src + i * 4);
+        lvec4_transformMat4(dst + i * 4, m);
+    }
+}
+
+// Float only
+// Padded normal matrices, packed back into d for measuring
+static void mat3_normalFromMat4_padded_all(void) {
+    size_t i;
+    mat3_normalFromMat4_padded_n(d, bm, BATCH);
+    for (i = 0; i < BATCH; i++) {
+        mat3_fromPadded(d + i * 9, d + i * 12);
+    }
+}
+
+static void ref_mat3_normalFromMat4_n(void) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        lmat3_normalFromMat4(ld + i * 9, lbm + i * 16);
+    }
+}
+
+static void ref_mat4x3_fromRotationTranslationScale_n(void) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        lmat4_fromRotationTranslationScale(ld + i * 16, ltree_r + i * 4, ltree_t + i * 3, ltree_s + i * 3);
+    }
+}
+
+static void ref_mat4x3_transformVector_n(void) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        lvec3_copy(ld + i * 3, lbv + i * 4);
+        lvec3_transformMat3(ld + i * 3, lm3);
+    }
+}
+
+static void relative_vec3_all(void) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        relative_vec3(d + i * 3, dpts + i * 3, dorigin);
+    }
+}
+
+static void ref_relative_vec3(void) {
+    size_t i;
+    for (i = 0; i < BATCH * 3; i++) {
+        ld[i] = (long double)dpts[i] - dorigin[i % 3];
+    }
+}
+
+// translate(-origin) * a
+static void ref_relative_model(void) {
+    size_t i, k;
+    for (i = 0; i < 4; i++) {
+        for (k = 0; k < 3; k++) {
+            ld[i * 4 + k] = (long double)dm[i * 4 + k] - (long double)dorigin[k] * dm[i * 4 + 3];
+        }
+        ld[i * 4 + 3] = dm[i * 4 + 3];
+    }
+}
+
+// a * translate(origin)
+static void ref_relative_view(void) {
+    size_t k;
+    for (k = 0; k < 16; k++) {
+        ld[k] = dm[k];
+    }
+    for (k = 0; k < 4; k++) {
+        ld[12 + k] += (long double)dm[k] * dorigin[0] + (long double)dm[4 + k] * dorigin[1] + (long double)dm[8 + k] * dorigin[2];
+    }
+}
+// End float only
+
+/*
+ * The cases. Each entry is
+ *
+ *   X(name, kind, layout, floor, budget, body, reference)
+ *
+ * kind picks what d and ld hold before the call; layout says how the result
+ * in d splits into groups: ONE(k) one group of k floats, AOS(n, k) n packed
+ * groups, STRIDED(n, k, s) n groups s floats apart, SOA(n, k) n groups with
+ * components BATCH floats apart. floor is the smallest scale the error of
+ * group i is measured against: 1 for quantized formats, the size of the
+ * inputs for results that cancel, like dot and cross products. budget is the
+ * most ULPs the case may be off by.
+ *
+ * CASES covers the functions that have double versions, FLOAT_CASES the
+ * modules and entry points that only exist in single precision.
+ */
+#define ONE(k) 1, k, k, 1
+#define AOS(n, k) n, k, k, 1
+#define STRIDED(n, k, s) n, k, s, 1
+#define SOA(n, k) n, k, 1, BATCH
+
+// The budget of a case that is worse conditioned with doubles: f ULPs for
+// the 24 bit significands here, d in test/dtest.c. quat_calculateW takes
+// its cancelling difference in double here but in nothing wider there,
+// and quat_getAxisAngle divides by a sine that double inputs bring much
+// closer to 0
+#define PRECISION_BUDGET(f, d) (FLT_MANT_DIG == 24 ? (f) : (d))
+
+#define CASES(X) \
+    X(mat2_identity, K_MAT2, ONE(4), 0, 0, mat2_identity(d), lmat2_identity(ld)) \
+    X(mat2_copy, K_MAT2, ONE(4), 0, 0, mat2_copy(d, n2), lmat2_copy(ld, ln2)) \
+    X(mat2_transpose, K_MAT2, ONE(4), 0, 0, mat2_transpose(d), lmat2_transpose(ld)) \
+    X(mat2_invert, K_MAT2, ONE(4), 0, 7, mat2_invert(d), lmat2_invert(ld)) \
+    X(mat2_adjoint, K_MAT2, ONE(4), 0, 0, mat2_adjoint(d), lmat2_adjoint(ld)) \
+    X(mat2_determinant, K_MAT2, ONE(1), 0, 5, d[0] = mat2_determinant(d), ld[0] = lmat2_determinant(ld)) \
+    X(mat2_multiply, K_MAT2, ONE(4), 0, 6, mat2_multiply(d, n2), lmat2_multiply(ld, ln2)) \
+    X(mat2_rotate, K_MAT2, ONE(4), 0, 6, mat2_rotate(d, rad[0]), lmat2_rotate(ld, lrad[0])) \
+    X(mat2_scale, K_MAT2, ONE(4), 0, 0.5, mat2_scale(d, b), lmat2_scale(ld, lb)) \
+    X(mat2_fromRotation, K_MAT2, ONE(4), 0, 4, mat2_fromRotation(d, rad[0]), lmat2_fromRotation(ld, lrad[0])) \
+    X(mat2_fromScaling, K_MAT2, ONE(4), 0, 0, mat2_fromScaling(d, b), lmat2_fromScaling(ld, lb)) \
+    X(mat2_add, K_MAT2, ONE(4), 0, 0.5, mat2_add(d, n2), lmat2_add(ld, ln2)) \
+    X(mat2_subtract, K_MAT2, ONE(4), 0, 0.5, mat2_subtract(d, n2), lmat2_subtract(ld, ln2)) \
+    X(mat2_equals, K_MAT2, ONE(2), 0, 0, d[0] = mat2_equals(d, n2); d[1] = mat2_equals(d, d), \
+        ld[0] = lmat2_equals(ld, ln2); ld[1] = lmat2_equals(ld, ld)) \
+    X(mat2_multiplyScalar, K_MAT2, ONE(4), 0, 0.5, mat2_multiplyScalar(d, s[0]), lmat2_multiplyScalar(ld, ls[0])) \
+    X(mat2_multiplyScalarAndAdd, K_MAT2, ONE(4), 0, 10, mat2_multiplyScalarAndAdd(d, n2, s[0]), lmat2_multiplyScalarAndAdd(ld, ln2, ls[0])) \
+    X(mat3_fromMat4, K_MAT3, ONE(9), 0, 0, mat3_fromMat4(d, n4), lmat3_fromMat4(ld, ln4)) \
+    X(mat3_copy, K_MAT3, ONE(9), 0, 0, mat3_copy(d, n3), lmat3_copy(ld, ln3)) \
+    X(mat3_set, K_MAT3, ONE(9), 0, 0, mat3_set(d, a[0], a[1], a[2], b[0], b[1], b[2], c[0], c[1], c[2]), \
+        lmat3_set(ld, la[0], la[1], la[2], lb[0], lb[1], lb[2], lc[0], lc[1], lc[2])) \
+    X(mat3_identity, K_MAT3, ONE(9), 0, 0, mat3_identity(d), lmat3_identity(ld)) \
+    X(mat3_transpose, K_MAT3, ONE(9), 0, 0, mat3_transpose(d), lmat3_transpose(ld)) \
+    X(mat3_invert, K_MAT3, ONE(9), 0, 9, mat3_invert(d), lmat3_invert(ld)) \
+    X(mat3_adjoint, K_MAT3, ONE(9), 0, 5, mat3_adjoint(d), lmat3_adjoint(ld)) \
+    X(mat3_determinant, K_MAT3, ONE(1), 0, 8, d[0] = mat3_determinant(d), ld[0] = lmat3_determinant(ld)) \
+    X(mat3_multiply, K_MAT3, ONE(9), 0, 7, mat3_multiply(d, n3), lmat3_multiply(ld, ln3)) \
+    X(mat3_translate, K_MAT3, ONE(9), 0, 5, mat3_translate(d, b), lmat3_translate(ld, lb)) \
+    X(mat3_rotate, K_MAT3, ONE(9), 0, 6, mat3_rotate(d, rad[0]), lmat3_rotate(ld, lrad[0])) \
+    X(mat3_scale, K_MAT3, ONE(9), 0, 0.5, mat3_scale(d, b), lmat3_scale(ld, lb)) \
+    X(mat3_fromTranslation, K_MAT3, ONE(9), 0, 0, mat3_fromTranslation(d, b), lmat3_fromTranslation(ld, lb)) \
+    X(mat3_fromRotation, K_MAT3, ONE(9), 0, 0.5, mat3_fromRotation(d, rad[0]), lmat3_fromRotation(ld, lrad[0])) \
+    X(mat3_fromScaling, K_MAT3, ONE(9), 0, 0, mat3_fromScaling(d, b), lmat3_fromScaling(ld, lb)) \
+    X(mat3_fromMat2d, K_MAT3, ONE(9), 0, 0, mat3_fromMat2d(d, n3), lmat3_fromMat2d(ld, ln3)) \
+    X(mat3_fromQuat, K_MAT3, ONE(9), 0, 6, mat3_fromQuat(d, q), lmat3_fromQuat(ld, lq)) \
+    X(mat3_normalFromMat4, K_MAT3, ONE(9), 0, 10, mat3_normalFromMat4(d, n4), lmat3_normalFromMat4(ld, ln4)) \
+    X(mat3_projection, K_MAT3, ONE(9), 0, 0.5, mat3_projection(d, 800 * sc[0], 600 * sc[1]), lmat3_projection(ld, 800 * lsc[0], 600 * lsc[1])) \
+    X(mat3_frob, K_MAT3, ONE(1), 0, 5, d[0] = mat3_frob(d), ld[0] = lmat3_frob(ld)) \
+    X(mat3_add, K_MAT3, ONE(9), 0, 0.5, mat3_add(d, n3), lmat3_add(ld, ln3)) \
+    X(mat3_subtract, K_MAT3, ONE(9), 0, 0.5, mat3_subtract(d, n3), lmat3_subtract(ld, ln3)) \
+    X(mat3_multiplyScalar, K_MAT3, ONE(9), 0, 0.5, mat3_multiplyScalar(d, s[0]), lmat3_multiplyScalar(ld, ls[0])) \
+    X(mat3_multiplyScalarAndAdd, K_MAT3, ONE(9), 0, 5, mat3_multiplyScalarAndAdd(d, n3, s[0]), lmat3_multiplyScalarAndAdd(ld, ln3, ls[0])) \
+    X(mat3_equals, K_MAT3, ONE(2), 0, 0, d[0] = mat3_equals(d, n3); d[1] = mat3_equals(d, d), \
+        ld[0] = lmat3_equals(ld, ln3); ld[1] = lmat3_equals(ld, ld)) \
+    X(mat4_identity, K_MAT4, ONE(16), 0, 0, mat4_identity(d), lmat4_identity(ld)) \
+    X(mat4_copy, K_MAT4, ONE(16), 0, 0, mat4_copy(d, n4), lmat4_copy(ld, ln4)) \
+    X(mat4_set, K_MAT4, ONE(16), 0, 0, \
+        mat4_set(d, a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3], c[0], c[1], c[2], c[3], e[0], e[1], e[2], e[3]), \
+        lmat4_set(ld, la[0], la[1], la[2], la[3], lb[0], lb[1], lb[2], lb[3], lc[0], lc[1], lc[2], lc[3], le[0], le[1], le[2], le[3])) \
+    X(mat4_transpose, K_MAT4, ONE(16), 0, 0, mat4_transpose(d), lmat4_transpose(ld)) \
+    X(mat4_invert, K_MAT4, ONE(16), 0, 90, mat4_invert(d), lmat4_invert(ld)) \
+    X(mat4_invertAffine, K_MAT4, ONE(16), 0, 90, mat4_invertAffine(d), lmat4_invert(ld)) \
+    X(mat4_invertRigid, K_NONE, ONE(16), 0, 34, mat4_fromRotationTranslation(d, q, b); mat4_invertRigid(d), \
+        lmat4_fromRotationTranslation(ld, lq, lb); lmat4_invert(ld)) \
+    X(mat4_invert_n, K_BMAT4, AOS(BATCH, 16), 0, 2300, mat4_invert_n(d, ok, BATCH), lmat4_invert_n(ld, lok, BATCH)) \
+    X(mat4_invert_roundTrip, K_MAT4, ONE(16), 1, 270000, mat4_invert(d); mat4_multiply(d, m4), lmat4_identity(ld)) \
+    X(mat4_adjoint, K_MAT4, ONE(16), 0, 56, mat4_adjoint(d), lmat4_adjoint(ld)) \
+    X(mat4_determinant, K_MAT4, ONE(1), 0, 7, d[0] = mat4_determinant(d), ld[0] = lmat4_determinant(ld)) \
+    X(mat4_multiply, K_MAT4, ONE(16), 0, 15, mat4_multiply(d, n4), lmat4_multiply(ld, ln4)) \
+    X(mat4_multiply_n, K_BMAT4, AOS(BATCH, 16), 0, 20, mat4_multiply_n(d, n4, BATCH), lmat4_multiply_n(ld, ln4, BATCH)) \
+    X(mat4_multiplyPairwise_n, K_BMAT4, AOS(BATCH, 16), 0, 22, mat4_multiplyPairwise_n(d, bn, BATCH), lmat4_multiplyPairwise_n(ld, lbn, BATCH)) \
+    X(mat4_translate, K_MAT4, ONE(16), 0, 8, mat4_translate(d, b), lmat4_translate(ld, lb)) \
+    X(mat4_translatef, K_MAT4, ONE(16), 0, 8, mat4_translatef(d, b[0], b[1], b[2]), lmat4_translatef(ld, lb[0], lb[1], lb[2])) \
+    X(mat4_scale, K_MAT4, ONE(16), 0, 0.5, mat4_scale(d, b), lmat4_scale(ld, lb)) \
+    X(mat4_rotate, K_MAT4, ONE(16), 0, 6, mat4_rotate(d, rad[0], b), lmat4_rotate(ld, lrad[0], lb)) \
+    X(mat4_rotateX, K_MAT4, ONE(16), 0, 5, mat4_rotateX(d, rad[0]), lmat4_rotateX(ld, lrad[0])) \
+    X(mat4_rotateY, K_MAT4, ONE(16), 0, 4, mat4_rotateY(d, rad[0]), lmat4_rotateY(ld, lrad[0])) \
+    X(mat4_rotateZ, K_MAT4, ONE(16), 0, 5, mat4_rotateZ(d, rad[0]), lmat4_rotateZ(ld, lrad[0])) \
+    X(mat4_fromTranslation, K_MAT4, ONE(16), 0, 0, mat4_fromTranslation(d, b), lmat4_fromTranslation(ld, lb)) \
+    X(mat4_fromScaling, K_MAT4, ONE(16), 0, 0, mat4_fromScaling(d, b), lmat4_fromScaling(ld, lb)) \
+    X(mat4_fromRotation, K_MAT4, ONE(16), 0, 11, mat4_fromRotation(d, rad[0], b), lmat4_fromRotation(ld, lrad[0], lb)) \
+    X(mat4_fromXRotation, K_MAT4, ONE(16), 0, 0.5, mat4_fromXRotation(d, rad[0]), lmat4_fromXRotation(ld, lrad[0])) \
+    X(mat4_fromYRotation, K_MAT4, ONE(16), 0, 0.5, mat4_fromYRotation(d, rad[0]), lmat4_fromYRotation(ld, lrad[0])) \
+    X(mat4_fromZRotation, K_MAT4, ONE(16), 0, 0.5, mat4_fromZRotation(d, rad[0]), lmat4_fromZRotation(ld, lrad[0])) \
+    X(mat4_fromRotationTranslation, K_MAT4, ONE(16), 0, 5, mat4_fromRotationTranslation(d, q, b), lmat4_fromRotationTranslation(ld, lq, lb)) \
+    X(mat4_fromQuat2, K_MAT4, ONE(16), 0, 9, mat4_fromQuat2(d, dq), lmat4_fromQuat2(ld, ldq)) \
+    X(mat4_getTranslation, K_MAT4, ONE(3), 0, 0, mat4_getTranslation(d, n4), lmat4_getTranslation(ld, ln4)) \
+    X(mat4_getScaling, K_MAT4, ONE(3), 0, 5, mat4_getScaling(d, n4), lmat4_getScaling(ld, ln4)) \
+    X(mat4_getRotation, K_MAT4, ONE(4), 0, 7, mat4_getRotation(d, n4), lmat4_getRotation(ld, ln4)) \
+    X(mat4_getRotation_roundTrip, K_MAT4, ONE(4), 0, 16, mat4_getRotation_roundTrip(), lvec4_copy(ld, lq)) \
+    X(mat4_fromRotationTranslationScale, K_MAT4, ONE(16), 0, 7, mat4_fromRotationTranslationScale(d, q, b, sc), \
+        lmat4_fromRotationTranslationScale(ld, lq, lb, lsc)) \
+    X(mat4_fromRotationTranslationScaleOrigin, K_MAT4, ONE(16), 0, 11, mat4_fromRotationTranslationScaleOrigin(d, q, b, sc, c), \
+        lmat4_fromRotationTranslationScaleOrigin(ld, lq, lb, lsc, lc)) \
+    X(mat4_fromQuat, K_MAT4, ONE(16), 0, 4, mat4_fromQuat(d, q), lmat4_fromQuat(ld, lq)) \
+    X(mat4_frustum, K_MAT4, ONE(16), 0, 4, mat4_frustum(d, -sc[0], sc[1], -1, 1, 0.1f, 100), lmat4_frustum(ld, -lsc[0], lsc[1], -1, 1, 0.1f, 100)) \
+    X(mat4_perspective, K_MAT4, ONE(16), 0, 6, mat4_perspective(d, sc[0], sc[1], 0.1f, 100), lmat4_perspective(ld, lsc[0], lsc[1], 0.1f, 100)) \
+    X(mat4_ortho, K_MAT4, ONE(16), 0, 5, mat4_ortho(d, -sc[0], sc[1], -1, 1, 0.1f, 100), lmat4_ortho(ld, -lsc[0], lsc[1], -1, 1, 0.1f, 100)) \
+    X(mat4_lookAt, K_MAT4, ONE(16), 0, 7, mat4_lookAt(d, b, c, up), lmat4_lookAt(ld, lb, lc, lup)) \
+    X(mat4_targetTo, K_MAT4, ONE(16), 0, 6, mat4_targetTo(d, b, c, up), lmat4_targetTo(ld, lb, lc, lup)) \
+    X(mat4_frob, K_MAT4, ONE(1), 0, 5, d[0] = mat4_frob(d), ld[0] = lmat4_frob(ld)) \
+    X(mat4_add, K_MAT4, ONE(16), 0, 0.5, mat4_add(d, n4), lmat4_add(ld, ln4)) \
+    X(mat4_subtract, K_MAT4, ONE(16), 0, 0.5, mat4_subtract(d, n4), lmat4_subtract(ld, ln4)) \
+    X(mat4_multiplyScalar, K_MAT4, ONE(16), 0, 0.5, mat4_multiplyScalar(d, s[0]), lmat4_multiplyScalar(ld, ls[0])) \
+    X(mat4_multiplyScalarAndAdd, K_MAT4, ONE(16), 0, 7, mat4_multiplyScalarAndAdd(d, n4, s[0]), lmat4_multiplyScalarAndAdd(ld, ln4, ls[0])) \
+    X(mat4_equals, K_MAT4, ONE(2), 0, 0, d[0] = mat4_equals(d, n4); d[1] = mat4_equals(d, d), \
+        ld[0] = lmat4_equals(ld, ln4); ld[1] = lmat4_equals(ld, ld)) \
+    X(vec2_copy, K_VEC, ONE(2), 0, 0, vec2_copy(d, b), lvec2_copy(ld, lb)) \
+    X(vec2_set, K_VEC, ONE(2), 0, 0, vec2_set(d, b[0], b[1]), lvec2_set(ld, lb[0], lb[1])) \
+    X(vec2_add, K_VEC, ONE(2), 0, 0.5, vec2_add(d, b), lvec2_add(ld, lb)) \
+    X(vec2_subtract, K_VEC, ONE(2), 0, 0.5, vec2_subtract(d, b), lvec2_subtract(ld, lb)) \
+    X(vec2_multiply, K_VEC, ONE(2), 0, 0.5, vec2_multiply(d, b), lvec2_multiply(ld, lb)) \
+    X(vec2_divide, K_VEC, ONE(2), 0, 0.5, vec2_divide(d, b), lvec2_divide(ld, lb)) \
+    X(vec2_ceil, K_VEC, ONE(2), 0, 0, vec2_ceil(d), lvec2_ceil(ld)) \
+    X(vec2_floor, K_VEC, ONE(2), 0, 0, vec2_floor(d), lvec2_floor(ld)) \
+    X(vec2_min, K_VEC, ONE(2), 0, 0, vec2_min(d, b), lvec2_min(ld, lb)) \
+    X(vec2_max, K_VEC, ONE(2), 0, 0, vec2_max(d, b), lvec2_max(ld, lb)) \
+    X(vec2_round, K_VEC, ONE(2), 0, 0, vec2_round(d), lvec2_round(ld)) \
+    X(vec2_scale, K_VEC, ONE(2), 0, 0.5, vec2_scale(d, s[0]), lvec2_scale(ld, ls[0])) \
+    X(vec2_scaleAndAdd, K_VEC, ONE(2), fmaxl(lnorm(la, 2, 1), fabsl(ls[0]) * lnorm(lb, 2, 1)), 4, vec2_scaleAndAdd(d, b, s[0]), lvec2_scaleAndAdd(ld, lb, ls[0])) \
+    X(vec2_distance, K_VEC, ONE(1), 0, 5, d[0] = vec2_distance(d, b), ld[0] = lvec2_distance(ld, lb)) \
+    X(vec2_squaredDistance, K_VEC, ONE(1), 0, 7, d[0] = vec2_squaredDistance(d, b), ld[0] = lvec2_squaredDistance(ld, lb)) \
+    X(vec2_length, K_VEC, ONE(1), 0, 5, d[0] = vec2_length(d), ld[0] = lvec2_length(ld)) \
+    X(vec2_squaredLength, K_VEC, ONE(1), 0, 5, d[0] = vec2_squaredLength(d), ld[0] = lvec2_squaredLength(ld)) \
+    X(vec2_negate, K_VEC, ONE(2), 0, 0, vec2_negate(d), lvec2_negate(ld)) \
+    X(vec2_inverse, K_VEC, ONE(2), 0, 0.5, vec2_inverse(d), lvec2_inverse(ld)) \
+    X(vec2_normalize, K_VEC, ONE(2), 0, 7, vec2_normalize(d), lvec2_normalize(ld)) \
+    X(vec2_dot, K_VEC, ONE(1), lnorm(la, 2, 1) * lnorm(lb, 2, 1), 5, d[0] = vec2_dot(d, b), ld[0] = lvec2_dot(ld, lb)) \
+    X(vec2_cross, K_VEC, ONE(3), lnorm(la, 2, 1) * lnorm(lb, 2, 1), 5, vec2_cross(d, b), lvec2_cross(ld, lb)) \
+    X(vec2_lerp, K_VEC, ONE(2), fmaxl(lnorm(la, 2, 1), lnorm(lb, 2, 1)), 4, vec2_lerp(d, b, t[0]), lvec2_lerp(ld, lb, lt[0])) \
+    X(vec2_transformMat2, K_VEC, ONE(2), lnorm(lm2, 4, 1) * lnorm(la, 2, 1), 5, vec2_transformMat2(d, m2), lvec2_transformMat2(ld, lm2)) \
+    X(vec2_transformMat2d, K_VEC, ONE(2), lnorm(lm3, 6, 1) * fmaxl(lnorm(la, 2, 1), 1), 6, vec2_transformMat2d(d, m3), lvec2_transformMat2d(ld, lm3)) \
+    X(vec2_transformMat3, K_VEC, ONE(2), lnorm(lm3, 9, 1) * fmaxl(lnorm(la, 2, 1), 1), 5, vec2_transformMat3(d, m3), lvec2_transformMat3(ld, lm3)) \
+    X(vec2_transformMat4, K_VEC, ONE(2), lnorm(lm4, 16, 1) * fmaxl(lnorm(la, 2, 1), 1), 4, vec2_transformMat4(d, m4), lvec2_transformMat4(ld, lm4)) \
+    X(vec2_rotate, K_VEC, ONE(2), 0, 94, vec2_rotate(d, b, rad[0]), lvec2_rotate(ld, lb, lrad[0])) \
+    X(vec2_angle, K_VEC, ONE(1), M_PI, 3500, d[0] = vec2_angle(d, b), ld[0] = lvec2_angle(ld, lb)) \
+    X(vec2_exactEquals, K_VEC, ONE(2), 0, 0, d[0] = vec2_exactEquals(d, b); d[1] = vec2_exactEquals(d, d), \
+        ld[0] = lvec2_exactEquals(ld, lb); ld[1] = lvec2_exactEquals(ld, ld)) \
+    X(vec3_length, K_VEC, ONE(1), 0, 5, d[0] = vec3_length(d), ld[0] = lvec3_length(ld)) \
+    X(vec3_copy, K_VEC, ONE(3), 0, 0, vec3_copy(d, b), lvec3_copy(ld, lb)) \
+    X(vec3_set, K_VEC, ONE(3), 0, 0, vec3_set(d, b[0], b[1], b[2]), lvec3_set(ld, lb[0], lb[1], lb[2])) \
+    X(vec3_add, K_VEC, ONE(3), 0, 0.5, vec3_add(d, b), lvec3_add(ld, lb)) \
+    X(vec3_subtract, K_VEC, ONE(3), 0, 0.5, vec3_subtract(d, b), lvec3_subtract(ld, lb)) \
+    X(vec3_multiply, K_VEC, ONE(3), 0, 0.5, vec3_multiply(d, b), lvec3_multiply(ld, lb)) \
+    X(vec3_divide, K_VEC, ONE(3), 0, 0.5, vec3_divide(d, b), lvec3_divide(ld, lb)) \
+    X(vec3_ceil, K_VEC, ONE(3), 0, 0, vec3_ceil(d), lvec3_ceil(ld)) \
+    X(vec3_floor, K_VEC, ONE(3), 0, 0, vec3_floor(d), lvec3_floor(ld)) \
+    X(vec3_min, K_VEC, ONE(3), 0, 0, vec3_min(d, b), lvec3_min(ld, lb)) \
+    X(vec3_max, K_VEC, ONE(3), 0, 0, vec3_max(d, b), lvec3_max(ld, lb)) \
+    X(vec3_round, K_VEC, ONE(3), 0, 0, vec3_round(d), lvec3_round(ld)) \
+    X(vec3_scale, K_VEC, ONE(3), 0, 0.5, vec3_scale(d, s[0]), lvec3_scale(ld, ls[0])) \
+    X(vec3_scaleAndAdd, K_VEC, ONE(3), fmaxl(lnorm(la, 3, 1), fabsl(ls[0]) * lnorm(lb, 3, 1)), 4, vec3_scaleAndAdd(d, b, s[0]), lvec3_scaleAndAdd(ld, lb, ls[0])) \
+    X(vec3_distance, K_VEC, ONE(1), 0, 5, d[0] = vec3_distance(d, b), ld[0] = lvec3_distance(ld, lb)) \
+    X(vec3_squaredDistance, K_VEC, ONE(1), 0, 7, d[0] = vec3_squaredDistance(d, b), ld[0] = lvec3_squaredDistance(ld, lb)) \
+    X(vec3_squaredLength, K_VEC, ONE(1), 0, 5, d[0] = vec3_squaredLength(d), ld[0] = lvec3_squaredLength(ld)) \
+    X(vec3_negate, K_VEC, ONE(3), 0, 0, vec3_negate(d), lvec3_negate(ld)) \
+    X(vec3_inverse, K_VEC, ONE(3), 0, 0.5, vec3_inverse(d), lvec3_inverse(ld)) \
+    X(vec3_normalize, K_VEC, ONE(3), 0, 7, vec3_normalize(d), lvec3_normalize(ld)) \
+    X(vec3_dot, K_VEC, ONE(1), lnorm(la, 3, 1) * lnorm(lb, 3, 1), 5, d[0] = vec3_dot(d, b), ld[0] = lvec3_dot(ld, lb)) \
+    X(vec3_cross, K_VEC, ONE(3), lnorm(la, 3, 1) * lnorm(lb, 3, 1), 5, vec3_cross(d, b), lvec3_cross(ld, lb)) \
+    X(vec3_lerp, K_VEC, ONE(3), fmaxl(lnorm(la, 3, 1), lnorm(lb, 3, 1)), 4, vec3_lerp(d, b, t[0]), lvec3_lerp(ld, lb, lt[0])) \
+    X(vec3_hermite, K_VEC, ONE(3), 0, 27, vec3_hermite(d, b, c, e, t[0]), lvec3_hermite(ld, lb, lc, le, lt[0])) \
+    X(vec3_bezier, K_VEC, ONE(3), 0, 33, vec3_bezier(d, b, c, e, t[0]), lvec3_bezier(ld, lb, lc, le, lt[0])) \
+    X(vec3_transformMat4, K_VEC, ONE(3), 0, 6, vec3_transformMat4(d, m4), lvec3_transformMat4(ld, lm4)) \
+    X(vec3_transformMat4_n, K_NONE, AOS(BATCH, 3), lnorm(lm4, 16, 1) * fmaxl(lnorm(lbv + i * 4, 3, 1), 1), 5, vec3_transformMat4_n(d, 0, bv, 4, m4, BATCH), \
+        lvec3_transformMat4_n(ld, 0, lbv, 4, lm4, BATCH)) \
+    X(vec3_transformMat4_n_inPlace, K_BVEC, STRIDED(BATCH, 3, 4), lnorm(lm4, 16, 1) * fmaxl(lnorm(lbv + i * 4, 3, 1), 1), 5, vec3_transformMat4_n(d, 4, d, 4, m4, BATCH), \
+        lvec3_transformMat4_n(ld, 4, ld, 4, lm4, BATCH)) \
+    X(vec3_transformMat4Affine_n, K_NONE, AOS(BATCH, 3), lnorm(lm4, 16, 1) * fmaxl(lnorm(lbv + i * 4, 3, 1), 1), 5, vec3_transformMat4Affine_n(d, 0, bv, 4, m4, BATCH), \
+        lvec3_transformMat4Affine_n(ld, 0, lbv, 4, lm4, BATCH)) \
+    X(vec3_transformMat3, K_VEC, ONE(3), lnorm(lm3, 9, 1) * lnorm(la, 3, 1), 5, vec3_transformMat3(d, m3), lvec3_transformMat3(ld, lm3)) \
+    X(vec3_transformQuat, K_VEC, ONE(3), 0, 11, vec3_transformQuat(d, q), lvec3_transformQuat(ld, lq)) \
+    X(vec3_rotateX, K_VEC, ONE(3), 0, 23, vec3_rotateX(d, b, rad[0]), lvec3_rotateX(ld, lb, lrad[0])) \
+    X(vec3_rotateY, K_VEC, ONE(3), 0, 15, vec3_rotateY(d, b, rad[0]), lvec3_rotateY(ld, lb, lrad[0])) \
+    X(vec3_rotateZ, K_VEC, ONE(3), 0, 15, vec3_rotateZ(d, b, rad[0]), lvec3_rotateZ(ld, lb, lrad[0])) \
+    X(vec3_angle, K_VEC, ONE(1), M_PI, 120, d[0] = vec3_angle(d, b), ld[0] = lvec3_angle(ld, lb)) \
+    X(vec3_equals, K_VEC, ONE(2), 0, 0, d[0] = vec3_equals(d, b); d[1] = vec3_equals(d, d), \
+        ld[0] = lvec3_equals(ld, lb); ld[1] = lvec3_equals(ld, ld)) \
+    X(vec4_copy, K_VEC, ONE(4), 0, 0, vec4_copy(d, b), lvec4_copy(ld, lb)) \
+    X(vec4_set, K_VEC, ONE(4), 0, 0, vec4_set(d, b[0], b[1], b[2], b[3]), lvec4_set(ld, lb[0], lb[1], lb[2], lb[3])) \
+    X(vec4_add, K_VEC, ONE(4), 0, 0.5, vec4_add(d, b), lvec4_add(ld, lb)) \
+    X(vec4_subtract, K_VEC, ONE(4), 0, 0.5, vec4_subtract(d, b), lvec4_subtract(ld, lb)) \
+    X(vec4_multiply, K_VEC, ONE(4), 0, 0.5, vec4_multiply(d, b), lvec4_multiply(ld, lb)) \
+    X(vec4_divide, K_VEC, ONE(4), 0, 0.5, vec4_divide(d, b), lvec4_divide(ld, lb)) \
+    X(vec4_ceil, K_VEC, ONE(4), 0, 0, vec4_ceil(d), lvec4_ceil(ld)) \
+    X(vec4_floor, K_VEC, ONE(4), 0, 0, vec4_floor(d), lvec4_floor(ld)) \
+    X(vec4_min, K_VEC, ONE(4), 0, 0, vec4_min(d, b), lvec4_min(ld, lb)) \
+    X(vec4_max, K_VEC, ONE(4), 0, 0, vec4_max(d, b), lvec4_max(ld, lb)) \
+    X(vec4_round, K_VEC, ONE(4), 0, 0, vec4_round(d), lvec4_round(ld)) \
+    X(vec4_scale, K_VEC, ONE(4), 0, 0.5, vec4_scale(d, s[0]), lvec4_scale(ld, ls[0])) \
+    X(vec4_scaleAndAdd, K_VEC, ONE(4), fmaxl(lnorm(la, 4, 1), fabsl(ls[0]) * lnorm(lb, 4, 1)), 4, vec4_scaleAndAdd(d, b, s[0]), lvec4_scaleAndAdd(ld, lb, ls[0])) \
+    X(vec4_distance, K_VEC, ONE(1), 0, 5, d[0] = vec4_distance(d, b), ld[0] = lvec4_distance(ld, lb)) \
+    X(vec4_squaredDistance, K_VEC, ONE(1), 0, 7, d[0] = vec4_squaredDistance(d, b), ld[0] = lvec4_squaredDistance(ld, lb)) \
+    X(vec4_length, K_VEC, ONE(1), 0, 5, d[0] = vec4_length(d), ld[0] = lvec4_length(ld)) \
+    X(vec4_squaredLength, K_VEC, ONE(1), 0, 6, d[0] = vec4_squaredLength(d), ld[0] = lvec4_squaredLength(ld)) \
+    X(vec4_negate, K_VEC, ONE(4), 0, 0, vec4_negate(d), lvec4_negate(ld)) \
+    X(vec4_inverse, K_VEC, ONE(4), 0, 0.5, vec4_inverse(d), lvec4_inverse(ld)) \
+    X(vec4_normalize, K_VEC, ONE(4), 0, 7, vec4_normalize(d), lvec4_normalize(ld)) \
+    X(vec4_dot, K_VEC, ONE(1), lnorm(la, 4, 1) * lnorm(lb, 4, 1), 5, d[0] = vec4_dot(d, b), ld[0] = lvec4_dot(ld, lb)) \
+    X(vec4_lerp, K_VEC, ONE(4), fmaxl(lnorm(la, 4, 1), lnorm(lb, 4, 1)), 4, vec4_lerp(d, b, t[0]), lvec4_lerp(ld, lb, lt[0])) \
+    X(vec4_transformMat4, K_VEC, ONE(4), lnorm(lm4, 16, 1) * lnorm(la, 4, 1), 4, vec4_transformMat4(d, m4), lvec4_transformMat4(ld, lm4)) \
+    X(vec4_transformMat4_n, K_NONE, AOS(BATCH, 4), lnorm(lm4, 16, 1) * fmaxl(lnorm(lbv + i * 4, 4, 1), 1), 5, vec4_transformMat4_n(d, 0, bv, 0, m4, BATCH), \
+        ref_vec4_transformMat4_n(ld, lbv, lm4, BATCH)) \
+    X(vec4_transformMat4_n_inPlace, K_BVEC, AOS(BATCH, 4), lnorm(lm4, 16, 1) * fmaxl(lnorm(lbv + i * 4, 4, 1), 1), 5, vec4_transformMat4_n(d, 0, d, 4, m4, BATCH), \
+        ref_vec4_transformMat4_n(ld, ld, lm4, BATCH)) \
+    X(vec4_transformQuat, K_VEC, ONE(4), 0, 8, vec4_transformQuat(d, q), lvec4_transformQuat(ld, lq)) \
+    X(vec4_equals, K_VEC, ONE(2), 0, 0, d[0] = vec4_equals(d, b); d[1] = vec4_equals(d, d), \
+        ld[0] = lvec4_equals(ld, lb); ld[1] = lvec4_equals(ld, ld)) \
+    X(quat_identity, K_QUAT, ONE(4), 0, 0, quat_identity(d), lquat_identity(ld)) \
+    X(quat_setAxisAngle, K_QUAT, ONE(4), 0, 4, quat_setAxisAngle(d, axis, rad[0]), lquat_setAxisAngle(ld, laxis, lrad[0])) \
+    X(quat_getAxisAngle, K_QUAT, ONE(4), M_PI, PRECISION_BUDGET(1000, 250000), d[3] = quat_getAxisAngle(d, r), ld[3] = lquat_getAxisAngle(ld, lr)) \
+    X(quat_multiply, K_QUAT, ONE(4), 0, 6, quat_multiply(d, r), lquat_multiply(ld, lr)) \
+    X(quat_rotateX, K_QUAT, ONE(4), 0, 6, quat_rotateX(d, rad[0]), lquat_rotateX(ld, lrad[0])) \
+    X(quat_rotateY, K_QUAT, ONE(4), 0, 6, quat_rotateY(d, rad[0]), lquat_rotateY(ld, lrad[0])) \
+    X(quat_rotateZ, K_QUAT, ONE(4), 0, 5, quat_rotateZ(d, rad[0]), lquat_rotateZ(ld, lrad[0])) \
+    X(quat_calculateW, K_QUAT, ONE(4), 1, PRECISION_BUDGET(4096, 3e7), quat_calculateW(d), lquat_calculateW(ld)) \
+    X(quat_slerp, K_QUAT, ONE(4), 0, 7, quat_slerp(d, r, t[0]), lquat_slerp(ld, lr, lt[0])) \
+    X(quat_invert, K_QUAT, ONE(4), 0, 7, quat_invert(d), lquat_invert(ld)) \
+    X(quat_conjugate, K_QUAT, ONE(4), 0, 0, quat_conjugate(d), lquat_conjugate(ld)) \
+    X(quat_fromMat3, K_QUAT, ONE(4), 0, 7, quat_fromMat3(d, m3), lquat_fromMat3(ld, lm3)) \
+    X(quat_fromMat3_roundTrip, K_QUAT, ONE(4), 0, 12, quat_fromMat3_roundTrip(), (void)0) \
+    X(quat_fromEuler, K_QUAT, ONE(4), 0, 8, quat_fromEuler(d, axis[0] * 180, axis[1] * 180, axis[2] * 180), \
+        lquat_fromEuler(ld, laxis[0] * 180, laxis[1] * 180, laxis[2] * 180)) \
+    X(quat2_identity, K_QUAT2, ONE(8), 0, 0, quat2_identity(d), lquat2_identity(ld)) \
+    X(quat2_copy, K_QUAT2, ONE(8), 0, 0, quat2_copy(d, dr), lquat2_copy(ld, ldr)) \
+    X(quat2_fromRotationTranslation, K_QUAT2, ONE(8), 0, 5, quat2_fromRotationTranslation(d, q, b), \
+        lquat2_fromRotationTranslation(ld, lq, lb)) \
+    X(quat2_fromTranslation, K_QUAT2, ONE(8), 0, 0, quat2_fromTranslation(d, b), lquat2_fromTranslation(ld, lb)) \
+    X(quat2_getTranslation, K_QUAT2, ONE(3), 0, 8, quat2_getTranslation(d, dr), lquat2_getTranslation(ld, ldr)) \
+    X(quat2_multiply, K_QUAT2, ONE(8), 0, 23, quat2_multiply(d, dr), lquat2_multiply(ld, ldr)) \
+    X(quat2_conjugate, K_QUAT2, ONE(8), 0, 0, quat2_conjugate(d), lquat2_conjugate(ld)) \
+    X(quat2_invert, K_QUAT2, ONE(8), 0, 8, quat2_invert(d), lquat2_invert(ld)) \
+    X(quat2_normalize, K_QUAT2, ONE(8), 0, 49, quat2_lerp(d, dr, 0.5f); quat2_normalize(d), lquat2_lerp(ld, ldr, 0.5f); lquat2_normalize(ld)) \
+    X(quat2_dot, K_QUAT2, ONE(1), lnorm(ldq, 4, 1) * lnorm(ldr, 4, 1), 6, d[0] = quat2_dot(d, dr), ld[0] = lquat2_dot(ld, ldr)) \
+    X(quat2_lerp, K_QUAT2, ONE(8), fmaxl(lnorm(ldq, 8, 1), lnorm(ldr, 8, 1)), 5, quat2_lerp(d, dr, t[0]), lquat2_lerp(ld, ldr, lt[0])) \
+    X(quat2_sclerp, K_QUAT2, ONE(8), 0, 110, quat2_sclerp(d, dr, t[0]), lquat2_sclerp(ld, ldr, lt[0])) \
+    X(quat2_transformPoint, K_VEC, ONE(3), 0, 20, quat2_transformPoint(d, dq), lquat2_transformPoint(ld, ldq)) \
+    X(quat2_equals, K_QUAT2, ONE(2), 0, 0, d[0] = quat2_equals(d, dr); d[1] = quat2_equals(d, d), \
+        ld[0] = lquat2_equals(ld, ldr); ld[1] = lquat2_equals(ld, ld))
+
+// Float only
+#define FLOAT_CASES(X) \
+    X(mat3_multiply_padded, K_MAT3, ONE(9), 0, 7, mat3_toPadded(d, d); mat3_toPadded(p3, n3); mat3_multiply_padded(d, p3); mat3_fromPadded(d, d), \
+        lmat3_multiply(ld, ln3)) \
+    X(mat3_transpose_padded, K_MAT3, ONE(9), 0, 0, mat3_toPadded(d, d); mat3_transpose_padded(d); mat3_fromPadded(d, d), lmat3_transpose(ld)) \
+    X(mat3_invert_padded, K_MAT3, ONE(9), 0, 9, mat3_toPadded(d, d); mat3_invert_padded(d); mat3_fromPadded(d, d), lmat3_invert(ld)) \
+    X(mat3_normalFromMat4_padded, K_MAT3, ONE(9), 0, 10, mat3_normalFromMat4_padded(d, n4); mat3_fromPadded(d, d), lmat3_normalFromMat4(ld, ln4)) \
+    X(mat3_normalFromMat4_padded_n, K_BMAT4, AOS(BATCH, 9), 0, 10, mat3_normalFromMat4_padded_all(), ref_mat3_normalFromMat4_n()) \
+    X(mat4_invert_n_aligned, K_BMAT4, AOS(BATCH, 16), 0, 2300, mat4_invert_n_aligned(d, ok, BATCH), lmat4_invert_n(ld, lok, BATCH)) \
+    X(mat4_multiply_aligned, K_MAT4, ONE(16), 0, 15, mat4_multiply_aligned(d, n4), lmat4_multiply(ld, ln4)) \
+    X(mat4_multiply_n_aligned, K_BMAT4, AOS(BATCH, 16), 0, 20, mat4_multiply_n_aligned(d, n4, BATCH), lmat4_multiply_n(ld, ln4, BATCH)) \
+    X(mat4x3_toMat4_n, K_BMAT4, AOS(BATCH, 16), 0, 0, mat4x3_fromMat4_n(d, d, BATCH); mat4x3_toMat4_n(d, d, BATCH), (void)0) \
+    X(mat4x3_fromRotationTranslationScale_n, K_NONE, AOS(BATCH, 16), 0, 7, \
+        mat4x3_fromRotationTranslationScale_n(d, tree_r, tree_t, tree_s, BATCH); mat4x3_toMat4_n(d, d, BATCH), ref_mat4x3_fromRotationTranslationScale_n()) \
+    X(mat4x3_multiply_n, K_BMAT4, AOS(BATCH, 16), 0, 20, \
+        mat4x3_fromMat4_n(m43, n4, 1); mat4x3_fromMat4_n(d, d, BATCH); mat4x3_multiply_n(d, m43, BATCH); mat4x3_toMat4_n(d, d, BATCH), \
+        lmat4_multiply_n(ld, ln4, BATCH)) \
+    X(mat4x3_multiplyPairwise_n, K_BMAT4, AOS(BATCH, 16), 0, 22, \
+        mat4x3_fromMat4_n(bn43, bn, BATCH); mat4x3_fromMat4_n(d, d, BATCH); mat4x3_multiplyPairwise_n(d, bn43, BATCH); mat4x3_toMat4_n(d, d, BATCH), \
+        lmat4_multiplyPairwise_n(ld, lbn, BATCH)) \
+    X(mat4x3_invert_n, K_BMAT4, AOS(BATCH, 16), 0, 2300, \
+        mat4x3_fromMat4_n(d, d, BATCH); mat4x3_invert_n(d, ok, BATCH); mat4x3_toMat4_n(d, d, BATCH), lmat4_invert_n(ld, lok, BATCH)) \
+    X(mat4x3_transformPoint_n, K_NONE, AOS(BATCH, 3), lnorm(lm4, 16, 1) * fmaxl(lnorm(lbv + i * 4, 3, 1), 1), 5, \
+        mat4x3_fromMat4_n(m43, m4, 1); mat4x3_transformPoint_n(d, 0, bv, 4, m43, BATCH), lvec3_transformMat4Affine_n(ld, 0, lbv, 4, lm4, BATCH)) \
+    X(mat4x3_transformVector_n, K_NONE, AOS(BATCH, 3), lnorm(lm3, 9, 1) * lnorm(lbv + i * 4, 3, 1), 5, \
+        mat4x3_fromMat4_n(m43, m4, 1); mat4x3_transformVector_n(d, 0, bv, 4, m43, BATCH), ref_mat4x3_transformVector_n()) \
+    X(vec4_transformMat4_aligned, K_VEC, ONE(4), lnorm(lm4, 16, 1) * lnorm(la, 4, 1), 4, vec4_transformMat4_aligned(d, m4), lvec4_transformMat4(ld, lm4)) \
+    X(quat_multiply_aligned, K_QUAT, ONE(4), 0, 6, quat_multiply_aligned(d, r), lquat_multiply(ld, lr)) \
+    X(quat_slerp_n_polynomial, K_BQUAT, AOS(BATCH, 4), 0, 7, quat_slerp_n(d, br, bt, BATCH, QUAT_SLERP_POLYNOMIAL), \
+        lquat_slerp_n(ld, lbr, lbt, BATCH, QUAT_SLERP_POLYNOMIAL)) \
+    X(quat_slerp_n_polynomial_vs_slerp, K_BQUAT, AOS(BATCH, 4), 0, 970, quat_slerp_n(d, br, bt, BATCH, QUAT_SLERP_POLYNOMIAL), ref_slerp_n()) \
+    X(quat_slerp_n_nlerp, K_BQUAT, AOS(BATCH, 4), 0, 8, quat_slerp_n(d, br, bt, BATCH, QUAT_SLERP_NLERP), \
+        lquat_slerp_n(ld, lbr, lbt, BATCH, QUAT_SLERP_NLERP)) \
+    X(quat_slerp_n_nlerp_vs_slerp, K_BQUAT, AOS(BATCH, 4), 0, 13000, quat_slerp_n(d, br, bt, BATCH, QUAT_SLERP_NLERP), ref_slerp_n()) \
+    X(quat_pack48, K_BQUAT, AOS(BATCH, 4), 0, 2100, quat_pack48_roundTrip(), (void)0) \
+    X(quat_pack32, K_BQUAT, AOS(BATCH, 4), 0, 58000, quat_pack32_roundTrip(), (void)0) \
+    X(quat_unpack48_n, K_BQUAT, AOS(BATCH, 4), 0, 2100, quat_unpack48_n_roundTrip(), (void)0) \
+    X(quat_unpack32_n, K_BQUAT, AOS(BATCH, 4), 0, 58000, quat_unpack32_n_roundTrip(), (void)0) \
+    X(vec3soa_fromInterleaved, K_SOA, SOA(BATCH, 3), 0, 0, vec3soa_fromInterleaved(&sa3, bv, 4, BATCH), \
+        lvec3soa_fromInterleaved(&lsa3, lbv, 4, BATCH)) \
+    X(vec3soa_toInterleaved, K_NONE, STRIDED(BATCH, 3, 4), 0, 0, vec3soa_toInterleaved(d, 4, &sb3, BATCH), \
+        lvec3soa_toInterleaved(ld, 4, &lsb3, BATCH)) \
+    X(vec3soa_add, K_SOA, SOA(BATCH, 3), 0, 0.5, vec3soa_add(&sa3, &sb3, BATCH), lvec3soa_add(&lsa3, &lsb3, BATCH)) \
+    X(vec3soa_scale, K_SOA, SOA(BATCH, 3), 0, 0.5, vec3soa_scale(&sa3, s[0], BATCH), lvec3soa_scale(&lsa3, ls[0], BATCH)) \
+    X(vec3soa_scaleAndAdd, K_SOA, SOA(BATCH, 3), 0, 8, vec3soa_scaleAndAdd(&sa3, &sb3, s[0], BATCH), \
+        lvec3soa_scaleAndAdd(&lsa3, &lsb3, ls[0], BATCH)) \
+    X(vec3soa_dot, K_SOA, AOS(BATCH, 1), lnorm(lbsa + i, 3, BATCH) * lnorm(lbsb + i, 3, BATCH), 6, vec3soa_dot(d + BATCH * 4, &sa3, &sb3, BATCH); memmove(d, d + BATCH * 4, BATCH * sizeof(float)), \
+        lvec3soa_dot(ld + BATCH * 4, &lsa3, &lsb3, BATCH); memmove(ld, ld + BATCH * 4, BATCH * sizeof(long double))) \
+    X(vec3soa_cross, K_SOA, SOA(BATCH, 3), lnorm(lbsa + i, 3, BATCH) * lnorm(lbsb + i, 3, BATCH), 5, vec3soa_cross(&sa3, &sb3, BATCH), lvec3soa_cross(&lsa3, &lsb3, BATCH)) \
+    X(vec3soa_normalize, K_SOA, SOA(BATCH, 3), 0, 7, vec3soa_normalize(&sa3, BATCH), lvec3soa_normalize(&lsa3, BATCH)) \
+    X(vec3soa_length, K_SOA, AOS(BATCH, 1), 0, 5, vec3soa_length(d + BATCH * 4, &sa3, BATCH); memmove(d, d + BATCH * 4, BATCH * sizeof(float)), \
+        lvec3soa_length(ld + BATCH * 4, &lsa3, BATCH); memmove(ld, ld + BATCH * 4, BATCH * sizeof(long double))) \
+    X(vec3soa_lerp, K_SOA, SOA(BATCH, 3), fmaxl(lnorm(lbsa + i, 3, BATCH), lnorm(lbsb + i, 3, BATCH)), 5, vec3soa_lerp(&sa3, &sb3, t[0], BATCH), lvec3soa_lerp(&lsa3, &lsb3, lt[0], BATCH)) \
+    X(vec3soa_transformMat4, K_SOA, SOA(BATCH, 3), lnorm(lm4, 16, 1) * fmaxl(lnorm(lbsa + i, 3, BATCH), 1), 4, vec3soa_transformMat4(&sa3, m4, BATCH), lvec3soa_transformMat4(&lsa3, lm4, BATCH)) \
+    X(vec4soa_fromInterleaved, K_SOA, SOA(BATCH, 4), 0, 0, vec4soa_fromInterleaved(&sa4, bv, 4, BATCH), \
+        lvec4soa_fromInterleaved(&lsa4, lbv, 4, BATCH)) \
+    X(vec4soa_toInterleaved, K_NONE, AOS(BATCH, 4), 0, 0, vec4soa_toInterleaved(d, 4, &sb4, BATCH), \
+        lvec4soa_toInterleaved(ld, 4, &lsb4, BATCH)) \
+    X(vec4soa_add, K_SOA, SOA(BATCH, 4), 0, 0.5, vec4soa_add(&sa4, &sb4, BATCH), lvec4soa_add(&lsa4, &lsb4, BATCH)) \
+    X(vec4soa_scale, K_SOA, SOA(BATCH, 4), 0, 0.5, vec4soa_scale(&sa4, s[0], BATCH), lvec4soa_scale(&lsa4, ls[0], BATCH)) \
+    X(vec4soa_scaleAndAdd, K_SOA, SOA(BATCH, 4), 0, 4, vec4soa_scaleAndAdd(&sa4, &sb4, s[0], BATCH), \
+        lvec4soa_scaleAndAdd(&lsa4, &lsb4, ls[0], BATCH)) \
+    X(vec4soa_dot, K_SOA, AOS(BATCH, 1), lnorm(lbsa + i, 4, BATCH) * lnorm(lbsb + i, 4, BATCH), 7, vec4soa_dot(d + BATCH * 4, &sa4, &sb4, BATCH); memmove(d, d + BATCH * 4, BATCH * sizeof(float)), \
+        lvec4soa_dot(ld + BATCH * 4, &lsa4, &lsb4, BATCH); memmove(ld, ld + BATCH * 4, BATCH * sizeof(long double))) \
+    X(vec4soa_normalize, K_SOA, SOA(BATCH, 4), 0, 8, vec4soa_normalize(&sa4, BATCH), lvec4soa_normalize(&lsa4, BATCH)) \
+    X(vec4soa_length, K_SOA, AOS(BATCH, 1), 0, 6, vec4soa_length(d + BATCH * 4, &sa4, BATCH); memmove(d, d + BATCH * 4, BATCH * sizeof(float)), \
+        lvec4soa_length(ld + BATCH * 4, &lsa4, BATCH); memmove(ld, ld + BATCH * 4, BATCH * sizeof(long double))) \
+    X(vec4soa_lerp, K_SOA, SOA(BATCH, 4), fmaxl(lnorm(lbsa + i, 4, BATCH), lnorm(lbsb + i, 4, BATCH)), 4, vec4soa_lerp(&sa4, &sb4, t[0], BATCH), lvec4soa_lerp(&lsa4, &lsb4, lt[0], BATCH)) \
+    X(vec4soa_transformMat4, K_SOA, SOA(BATCH, 4), lnorm(lm4, 16, 1) * fmaxl(lnorm(lbsa + i, 4, BATCH), 1), 4, vec4soa_transformMat4(&sa4, m4, BATCH), lvec4soa_transformMat4(&lsa4, lm4, BATCH)) \
+    X(frustum_fromMat4, K_NONE, AOS(6, 4), 0, 8, frustum_fromMat4(d, proj), lfrustum_fromMat4(ld, lproj)) \
+    X(frustum_testSphere, K_NONE, ONE(1), 1, 0, d[0] = frustum_testSphere(planes, sph, sph[3]), ld[0] = lfrustum_testSphere(lplanes, lsph, lsph[3])) \
+    X(frustum_testAABB, K_NONE, ONE(1), 1, 0, d[0] = frustum_testAABB(planes, sph, box), ld[0] = lfrustum_testAABB(lplanes, lsph, lbox)) \
+    X(frustum_cullSpheres, K_SOA, ONE(BATCH + 1), 1, 0, d[BATCH] = frustum_cullSpheres(bits, planes, &sa4, BATCH); expand_bits(d, bits), \
+        ld[BATCH] = lfrustum_cullSpheres(lbits, lplanes, &lsa4, BATCH); lexpand_bits(ld, lbits)) \
+    X(frustum_cullAABBs, K_SOA, ONE(BATCH + 1), 1, 0, d[BATCH] = frustum_cullAABBs(bits, planes, &sa3, &ext3, BATCH); expand_bits(d, bits), \
+        ld[BATCH] = lfrustum_cullAABBs(lbits, lplanes, &lsa3, &lext3, BATCH); lexpand_bits(ld, lbits)) \
+    X(frustum_cullSpheres_nan, K_SOA, ONE(BATCH + 1), 1, 0, \
+        d[2] = NAN; d[BATCH * 4 - 1] = NAN; d[BATCH] = frustum_cullSpheres(bits, planes, &sa4, BATCH); expand_bits(d, bits), \
+        ld[2] = NAN; ld[BATCH * 4 - 1] = NAN; ld[BATCH] = lfrustum_cullSpheres(lbits, lplanes, &lsa4, BATCH); lexpand_bits(ld, lbits)) \
+    X(frustum_cullAABBs_nan, K_SOA, ONE(BATCH + 1), 1, 0, \
+        d[2] = NAN; d[BATCH * 3 - 1] = NAN; d[BATCH] = frustum_cullAABBs(bits, planes, &sa3, &ext3, BATCH); expand_bits(d, bits), \
+        ld[2] = NAN; ld[BATCH * 3 - 1] = NAN; ld[BATCH] = lfrustum_cullAABBs(lbits, lplanes, &lsa3, &lext3, BATCH); lexpand_bits(ld, lbits)) \
+    X(hierarchy_validate, K_NONE, ONE(1), 1, 0, d[0] = hierarchy_validate(&tree), ld[0] = lhierarchy_validate(&ltree)) \
+    X(hierarchy_update, K_NONE, AOS(BATCH, 16), 0, 290, hierarchy_markAllDirty(&tree); hierarchy_update(&tree); memcpy(d, tree_world, sizeof(tree_world)), \
+        lhierarchy_markAllDirty(&ltree); lhierarchy_update(&ltree); memcpy(ld, ltree_world, sizeof(ltree_world))) \
+    X(hierarchy_update_partial, K_NONE, AOS(BATCH, 16), 0, 240, hierarchy_updatePartial(), ref_hierarchy_updatePartial()) \
+    X(skin_linearBlend, K_NONE, AOS(BIG * 2, 3), 0, 490, skin_linearBlend(&mesh, 0, BIG), ref_skin_linearBlend()) \
+    X(skin_linearBlend_pool, K_NONE, AOS(BIG * 2, 3), 0, 490, skin_linearBlend_pool(&mesh, &workers), ref_skin_linearBlend()) \
+    X(skin_dualQuat, K_NONE, AOS(BIG * 2, 3), 0, 1400, skin_dualQuat(&mesh_dq, 0, BIG), ref_skin_dualQuat()) \
+    X(skin_dualQuat_pool, K_NONE, AOS(BIG * 2, 3), 0, 1400, skin_dualQuat_pool(&mesh_dq, &workers), ref_skin_dualQuat()) \
+    X(pool_vec3_transformMat4, K_NONE, AOS(BIG, 3), lnorm(lm4, 16, 1) * fmaxl(lnorm(lbig + i * 3, 3, 1), 1), 5, pool_run(&workers, d, BIG, &op_vec3), lvec3_transformMat4_n(ld, 0, lbig, 0, lm4, BIG)) \
+    X(pool_vec3_transformMat4Affine, K_NONE, AOS(BIG, 3), lnorm(lm4, 16, 1) * fmaxl(lnorm(lbig + i * 4, 3, 1), 1), 5, pool_run(&workers, d, BIG, &op_vec3_affine), \
+        lvec3_transformMat4Affine_n(ld, 0, lbig, 4, lm4, BIG)) \
+    X(pool_vec4_transformMat4, K_NONE, AOS(BIG, 4), lnorm(lm4, 16, 1) * fmaxl(lnorm(lbig + i * 4, 4, 1), 1), 5, pool_run(&workers, d, BIG, &op_vec4), ref_vec4_transformMat4_n(ld, lbig, lm4, BIG)) \
+    X(pool_mat4_multiply, K_BIGM, AOS(BIGM, 16), 0, 50, pool_run(&workers, d, BIGM, &op_multiply), lmat4_multiply_n(ld, ln4, BIGM)) \
+    X(pool_mat4_multiplyPairwise, K_BIGM, AOS(BIGM, 16), 0, 9, pool_run(&workers, d, BIGM, &op_pairwise), lmat4_multiplyPairwise_n(ld, lbig, BIGM)) \
+    X(pool_mat4_invert, K_BIGM, AOS(BIGM, 16), 0, 2300, pool_run(&workers, d, BIGM, &op_invert), lmat4_invert_n(ld, lok, BIGM)) \
+    X(pack_half, K_HALF, AOS(BATCH * 4, 1), 0, 0, pack_half_roundTrip(), ref_halves(BATCH * 4)) \
+    X(pack_toHalf_n, K_HALF, AOS(BATCH * 4, 1), 0, 0, pack_toHalf_n(half, d, BATCH * 4); pack_fromHalf_n(d, half, BATCH * 4), ref_halves(BATCH * 4)) \
+    X(pack_snorm16_n, K_RANGE, AOS(BATCH * 4, 1), 1, 129, pack_toSnorm16_n(snorm, d, BATCH * 4); pack_fromSnorm16_n(d, snorm, BATCH * 4), \
+        ref_clamp(-1, 1, BATCH * 4)) \
+    X(pack_unorm8_n, K_RANGE, AOS(BATCH * 4, 1), 1, 16449, pack_toUnorm8_n(unorm, d, BATCH * 4); pack_fromUnorm8_n(d, unorm, BATCH * 4), \
+        ref_clamp(0, 1, BATCH * 4)) \
+    X(pack_octahedral, K_NORMALS, AOS(BATCH, 3), 0, 1900, pack_octahedral_roundTrip(), (void)0) \
+    X(pack_octahedral_n, K_NORMALS, AOS(BATCH, 3), 0, 1900, pack_toOctahedral_n(snorm, d, BATCH); pack_fromOctahedral_n(d, snorm, BATCH), (void)0) \
+    X(relative_vec3, K_NONE, AOS(BATCH, 3), 0, 0, relative_vec3_all(), ref_relative_vec3()) \
+    X(relative_vec3_n, K_NONE, AOS(BATCH, 3), 0, 0, relative_vec3_n(d, dpts, dorigin, BATCH), ref_relative_vec3()) \
+    X(relative_model, K_NONE, ONE(16), 0, 0, relative_model(d, dm, dorigin), ref_relative_model()) \
+    X(relative_view, K_NONE, ONE(16), 0, 0.5, relative_view(d, dm, dorigin), ref_relative_view())
+
+static void expand_bits(float* dst, uint8_t* a) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        dst[i] = (a[i / 8] >> (i % 8)) & 1;
+    }
+}
+
+// Puts every sphere on the surface of a plane and every box corner near one,
+// where a fused multiply-add would round to the other side
+static float edge_ext[BATCH * 3];
+static vec3soa edge3 = { edge_ext, edge_ext + BATCH, edge_ext + BATCH * 2 };
+
+static void edge_spheres(float* a) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        float* p = planes + i % 6 * 4;
+        a[BATCH * 3 + i] = -(p[0] * a[i] + p[1] * a[BATCH + i] + p[2] * a[BATCH * 2 + i] + p[3]);
+    }
+}
+
+static void edge_AABBs(float* a) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        float* p = planes + i % 6 * 4;
+        float dist = p[0] * a[i] + p[1] * a[BATCH + i] + p[2] * a[BATCH * 2 + i] + p[3];
+        edge_ext[i] = p[0] ? -dist / fabsf(p[0]) : 0;
+        edge_ext[BATCH + i] = 0;
+        edge_ext[BATCH * 2 + i] = 0;
+    }
+}
+
+// The single frustum tests on each volume of the SoA arrays in a, as 0 or 1
+// in dst, which may be a
+static void test_spheres(float* dst, float* a) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        float center[3] = { a[i], a[BATCH + i], a[BATCH * 2 + i] };
+        dst[i] = frustum_testSphere(planes, center, a[BATCH * 3 + i]);
+    }
+}
+
+static void test_AABBs(float* dst, float* a) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        float center[3] = { a[i], a[BATCH + i], a[BATCH * 2 + i] };
+        float extent[3] = { edge_ext[i], edge_ext[BATCH + i], edge_ext[BATCH * 2 + i] };
+        dst[i] = frustum_testAABB(planes, center, extent);
+    }
+}
+
+static void lexpand_bits(long double* dst, uint8_t* a) {
+    size_t i;
+    for (i = 0; i < BATCH; i++) {
+        dst[i] = (a[i / 8] >> (i % 8)) & 1;
+    }
+}
+
+static void pack_half_roundTrip(void) {
+    size_t i;
+    for (i = 0; i < BATCH * 4; i++) {
+        d[i] = pack_fromHalf(pack_toHalf(d[i]));
+    }
+}
+// End float only
+
+#define DEFINE_CASE(name, kind, count, comps, estep, cstride, floor, budget, body, ref) \
+    static void run_##name(void) { body; } \
+    static void reference_##name(void) { ref; } \
+    static long double floor_##name(size_t i) { (void)i; return floor; }
+#define EXPAND(X, ...) X(__VA_ARGS__)
+#define DEFINE(...) EXPAND(DEFINE_CASE, __VA_ARGS__)
+CASES(DEFINE)
+// Float only
+FLOAT_CASES(DEFINE)
+// End float only
+
+struct test_case {
+    const char* name;
+    uint8_t kind;
+    size_t count, comps, estep, cstride;
+    long double (*floor)(size_t i);
+    double budget;
+    void (*run)(void);
+    void (*ref)(void);
+};
+
+#define TABLE_ENTRY_CASE(name, kind, count, comps, estep, cstride, floor, budget, body, ref) \
+    { #name, kind, count, comps, estep, cstride, floor_##name, budget, run_##name, reference_##name },
+#define TABLE_ENTRY(...) EXPAND(TABLE_ENTRY_CASE, __VA_ARGS__)
+static struct test_case cases[] = {
+    CASES(TABLE_ENTRY)
+// Float only
+    FLOAT_CASES(TABLE_ENTRY)
+// End float only
+};
+
+/*
+ * Functions that must give exactly the same results as another one. Each
+ * entry is
+ *
+ *   X(name, kind, bytes, body, reference)
+ *
+ * d and expected both hold the operand of kind. body leaves its result in
+ * d, reference leaves the result of the function body must match in
+ * expected, and the case fails unless their first bytes are equal. The
+ * batches have BATCH elements, so both the 8-wide kernels and their scalar
+ * tails are compared with the single calls.
+ *
+ * As with the cases, FLOAT_SAME_CASES holds the single precision only ones.
+ */
+// The constant initializers, as C static initializers
+static float init_xy[2] = { 1.5f, -2 };
+static float init_xyz[3] = { 1.5f, -2, 0.1f };
+static const float init_mat2_identity[4] = MAT2_IDENTITY;
+static const float init_mat2_scaling[4] = MAT2_FROM_SCALING(1.5f, -2);
+static const float init_mat3_identity[9] = MAT3_IDENTITY;
+static const float init_mat3_translation[9] = MAT3_FROM_TRANSLATION(1.5f, -2);
+static const float init_mat3_scaling[9] = MAT3_FROM_SCALING(1.5f, -2);
+static const float init_mat3_projection[9] = MAT3_PROJECTION(1280, 720);
+static const float init_mat4_identity[16] = MAT4_IDENTITY;
+static const float init_mat4_translation[16] = MAT4_FROM_TRANSLATION(1.5f, -2, 0.1f);
+static const float init_mat4_scaling[16] = MAT4_FROM_SCALING(1.5f, -2, 0.1f);
+static const float init_mat4_frustum[16] = MAT4_FRUSTUM(-0.2f, 0.3f, -0.1f, 0.15f, 0.1f, 100);
+static const float init_mat4_perspective[16] = MAT4_PERSPECTIVE(1.1f, 1.5f, 0.1f, 100);
+static const float init_mat4_perspective_infinite[16] = MAT4_PERSPECTIVE(0.9f, 16.0f / 9, 0.05f, 0);
+static const float init_mat4_ortho[16] = MAT4_ORTHO(0, 1280, 0, 720, -1, 1);
+
+#define EACH(n, statement) { size_t i; for (i = 0; i < (n); i++) { statement; } }
+
+#define SAME_CASES(X) \
+    X(mat4_multiply_n, K_BMAT4, BATCH * 16 * sizeof(float), mat4_multiply_n(d, n4, BATCH), EACH(BATCH, mat4_multiply(expected + i * 16, n4))) \
+    X(mat4_multiplyPairwise_n, K_BMAT4, BATCH * 16 * sizeof(float), mat4_multiplyPairwise_n(d, bn, BATCH), \
+        EACH(BATCH, mat4_multiply(expected + i * 16, bn + i * 16))) \
+    X(mat4_invert_n, K_BMAT4, BATCH * 16 * sizeof(float), mat4_invert_n(d, ok, BATCH), EACH(BATCH, lok[i] = mat4_invert(expected + i * 16))) \
+    X(mat4_invert_n_ok, K_BMAT4, BATCH, mat4_invert_n(d, ok, BATCH); memcpy(d, ok, BATCH), \
+        EACH(BATCH, lok[i] = mat4_invert(expected + i * 16)); memcpy(expected, lok, BATCH)) \
+    X(vec4_transformMat4_n, K_BVEC, BATCH * 4 * sizeof(float), vec4_transformMat4_n(d, 0, d, 0, m4, BATCH), EACH(BATCH, vec4_transformMat4(expected + i * 4, m4))) \
+    X(MAT2_IDENTITY, K_NONE, sizeof(init_mat2_identity), memcpy(d, init_mat2_identity, sizeof(init_mat2_identity)), mat2_identity(expected)) \
+    X(MAT2_FROM_SCALING, K_NONE, sizeof(init_mat2_scaling), memcpy(d, init_mat2_scaling, sizeof(init_mat2_scaling)), mat2_fromScaling(expected, init_xy)) \
+    X(MAT3_IDENTITY, K_NONE, sizeof(init_mat3_identity), memcpy(d, init_mat3_identity, sizeof(init_mat3_identity)), mat3_identity(expected)) \
+    X(MAT3_FROM_TRANSLATION, K_NONE, sizeof(init_mat3_translation), memcpy(d, init_mat3_translation, sizeof(init_mat3_translation)), \
+        mat3_fromTranslation(expected, init_xy)) \
+    X(MAT3_FROM_SCALING, K_NONE, sizeof(init_mat3_scaling), memcpy(d, init_mat3_scaling, sizeof(init_mat3_scaling)), mat3_fromScaling(expected, init_xy)) \
+    X(MAT3_PROJECTION, K_NONE, sizeof(init_mat3_projection), memcpy(d, init_mat3_projection, sizeof(init_mat3_projection)), \
+        mat3_projection(expected, 1280, 720)) \
+    X(MAT4_IDENTITY, K_NONE, sizeof(init_mat4_identity), memcpy(d, init_mat4_identity, sizeof(init_mat4_identity)), mat4_identity(expected)) \
+    X(MAT4_FROM_TRANSLATION, K_NONE, sizeof(init_mat4_translation), memcpy(d, init_mat4_translation, sizeof(init_mat4_translation)), \
+        mat4_fromTranslation(expected, init_xyz)) \
+    X(MAT4_FROM_SCALING, K_NONE, sizeof(init_mat4_scaling), memcpy(d, init_mat4_scaling, sizeof(init_mat4_scaling)), mat4_fromScaling(expected, init_xyz)) \
+    X(MAT4_FRUSTUM, K_NONE, sizeof(init_mat4_frustum), memcpy(d, init_mat4_frustum, sizeof(init_mat4_frustum)), \
+        mat4_frustum(expected, -0.2f, 0.3f, -0.1f, 0.15f, 0.1f, 100)) \
+    X(MAT4_PERSPECTIVE, K_NONE, sizeof(init_mat4_perspective), memcpy(d, init_mat4_perspective, sizeof(init_mat4_perspective)), \
+        mat4_perspective(expected, 1.1f, 1.5f, 0.1f, 100)) \
+    X(MAT4_PERSPECTIVE_infinite, K_NONE, sizeof(init_mat4_perspective_infinite), \
+        memcpy(d, init_mat4_perspective_infinite, sizeof(init_mat4_perspective_infinite)), mat4_perspective(expected, 0.9f, 16.0f / 9, 0.05f, 0)) \
+    X(MAT4_ORTHO, K_NONE, sizeof(init_mat4_ortho), memcpy(d, init_mat4_ortho, sizeof(init_mat4_ortho)), mat4_ortho(expected, 0, 1280, 0, 720, -1, 1))
+
+// Float only
+#define FLOAT_SAME_CASES(X) \
+    X(mat4_multiply_aligned, K_MAT4, 16 * sizeof(float), mat4_multiply_aligned(d, n4), mat4_multiply(expected, n4)) \
+    X(mat4_multiply_n_aligned, K_BMAT4, BATCH * 16 * sizeof(float), mat4_multiply_n_aligned(d, n4, BATCH), mat4_multiply_n(expected, n4, BATCH)) \
+    X(mat4_invert_n_aligned, K_BMAT4, BATCH * 16 * sizeof(float), mat4_invert_n_aligned(d, ok, BATCH), mat4_invert_n(expected, lok, BATCH)) \
+    X(vec4_transformMat4_aligned, K_VEC, 4 * sizeof(float), vec4_transformMat4_aligned(d, m4), vec4_transformMat4(expected, m4)) \
+    X(quat_multiply_aligned, K_QUAT, 4 * sizeof(float), quat_multiply_aligned(d, r), quat_multiply(expected, r)) \
+    X(mat3_multiply_padded, K_MAT3, 9 * sizeof(float), mat3_toPadded(d, d); mat3_toPadded(p3, n3); mat3_multiply_padded(d, p3); mat3_fromPadded(d, d), \
+        mat3_multiply(expected, n3)) \
+    X(mat3_invert_padded, K_MAT3, 9 * sizeof(float), mat3_toPadded(d, d); mat3_invert_padded(d); mat3_fromPadded(d, d), mat3_invert(expected)) \
+    X(mat3_normalFromMat4_padded_n, K_NONE, BATCH * 12 * sizeof(float), mat3_normalFromMat4_padded_n(d, bm, BATCH), \
+        EACH(BATCH, mat3_normalFromMat4_padded(expected + i * 12, bm + i * 16))) \
+    X(mat4x3_multiplyPairwise_n, K_BMAT4, BATCH * 12 * sizeof(float), mat4x3_multiplyPairwise_n(d, bn, BATCH), \
+        EACH(BATCH, mat4x3_multiply_n(expected + i * 12, bn + i * 12, 1))) \
+    X(mat4x3_invert_n, K_BMAT4, BATCH * 12 * sizeof(float), mat4x3_invert_n(d, NULL, BATCH), EACH(BATCH, mat4x3_invert_n(expected + i * 12, NULL, 1))) \
+    X(mat4x3_transformPoint_n, K_NONE, BATCH * 3 * sizeof(float), mat4x3_transformPoint_n(d, 0, bv, 4, m43, BATCH), \
+        mat4x3_toMat4_n(expected + BATCH * 3, m43, 1); vec3_transformMat4Affine_n(expected, 0, bv, 4, expected + BATCH * 3, BATCH)) \
+    X(hierarchy_update_local, K_NONE, sizeof(tree_local), hierarchy_markAllDirty(&tree); hierarchy_update(&tree); memcpy(d, tree_local, sizeof(tree_local)), \
+        EACH(BATCH, mat4_fromRotationTranslationScale(expected + i * 16, tree_r + i * 4, tree_t + i * 3, tree_s + i * 3))) \
+    X(hierarchy_update_clean, K_NONE, sizeof(tree_local), hierarchy_updateClean(), \
+        hierarchy_markAllDirty(&tree); hierarchy_update(&tree); memcpy(expected, tree_local, sizeof(tree_local))) \
+    X(hierarchy_validate_negative, K_NONE, sizeof(float), tree_parent[5] -= 7; d[0] = hierarchy_validate(&tree); tree_parent[5] += 7, expected[0] = 0) \
+    X(quat_unpack48_n, K_BQUAT, BATCH * 4 * sizeof(float), EACH(BATCH, quat_pack48(packed48 + i * 3, d + i * 4)); quat_unpack48_n(d, packed48, BATCH), \
+        EACH(BATCH, quat_pack48(packed48 + i * 3, expected + i * 4)); EACH(BATCH, quat_unpack48(expected + i * 4, packed48 + i * 3))) \
+    X(quat_unpack32_n, K_BQUAT, BATCH * 4 * sizeof(float), EACH(BATCH, quat_pack32(packed32 + i, d + i * 4)); quat_unpack32_n(d, packed32, BATCH), \
+        EACH(BATCH, quat_pack32(packed32 + i, expected + i * 4)); EACH(BATCH, quat_unpack32(expected + i * 4, packed32 + i))) \
+    X(pack_toHalf_n, K_HALF, sizeof(half), pack_toHalf_n(half, d, BATCH * 4); memcpy(d, half, sizeof(half)), \
+        EACH(BATCH * 4, half[i] = pack_toHalf(expected[i])); memcpy(expected, half, sizeof(half))) \
+    X(pack_fromHalf_n, K_HALF, BATCH * 4 * sizeof(float), EACH(BATCH * 4, half[i] = pack_toHalf(d[i])); pack_fromHalf_n(d, half, BATCH * 4), \
+        EACH(BATCH * 4, expected[i] = pack_fromHalf(pack_toHalf(expected[i])))) \
+    X(pack_toSnorm16_n, K_RANGE, sizeof(snorm), pack_toSnorm16_n(snorm, d, BATCH * 4); memcpy(d, snorm, sizeof(snorm)), \
+        EACH(BATCH * 4, pack_toSnorm16_n(snorm + i, expected + i, 1)); memcpy(expected, snorm, sizeof(snorm))) \
+    X(pack_fromSnorm16_n, K_RANGE, BATCH * 4 * sizeof(float), pack_toSnorm16_n(snorm, d, BATCH * 4); pack_fromSnorm16_n(d, snorm, BATCH * 4), \
+        pack_toSnorm16_n(snorm, expected, BATCH * 4); EACH(BATCH * 4, pack_fromSnorm16_n(expected + i, snorm + i, 1))) \
+    X(pack_toUnorm8_n, K_RANGE, sizeof(unorm), pack_toUnorm8_n(unorm, d, BATCH * 4); memcpy(d, unorm, sizeof(unorm)), \
+        EACH(BATCH * 4, pack_toUnorm8_n(unorm + i, expected + i, 1)); memcpy(expected, unorm, sizeof(unorm))) \
+    X(pack_fromUnorm8_n, K_RANGE, BATCH * 4 * sizeof(float), pack_toUnorm8_n(unorm, d, BATCH * 4); pack_fromUnorm8_n(d, unorm, BATCH * 4), \
+        pack_toUnorm8_n(unorm, expected, BATCH * 4); EACH(BATCH * 4, pack_fromUnorm8_n(expected + i, unorm + i, 1))) \
+    X(pack_toOctahedral_n, K_NORMALS, BATCH * 2 * sizeof(int16_t), pack_toOctahedral_n(snorm, d, BATCH); memcpy(d, snorm, BATCH * 2 * sizeof(int16_t)), \
+        EACH(BATCH, pack_toOctahedral(snorm + i * 2, expected + i * 3)); memcpy(expected, snorm, BATCH * 2 * sizeof(int16_t))) \
+    X(pack_fromOctahedral_n, K_NORMALS, BATCH * 3 * sizeof(float), pack_toOctahedral_n(snorm, d, BATCH); pack_fromOctahedral_n(d, snorm, BATCH), \
+        pack_toOctahedral_n(snorm, expected, BATCH); EACH(BATCH, pack_fromOctahedral(expected + i * 3, snorm + i * 2))) \
+    X(relative_vec3_n, K_NONE, BATCH * 3 * sizeof(float), relative_vec3_n(d, dpts, dorigin, BATCH), EACH(BATCH, relative_vec3(expected + i * 3, dpts + i * 3, dorigin))) \
+    X(skin_linearBlend_pool, K_NONE, BIG * 6 * sizeof(float), skin_linearBlend_pool(&mesh, &workers), skin_linearBlend(&mesh_expected, 0, BIG)) \
+    X(skin_dualQuat_pool, K_NONE, BIG * 6 * sizeof(float), skin_dualQuat_pool(&mesh_dq, &workers), skin_dualQuat(&mesh_dq_expected, 0, BIG)) \
+    X(frustum_cullSpheres, K_SOA, BATCH * sizeof(float), edge_spheres(d); frustum_cullSpheres(bits, planes, &sa4, BATCH); expand_bits(d, bits), \
+        edge_spheres(expected); test_spheres(expected, expected)) \
+    X(frustum_cullAABBs, K_SOA, BATCH * sizeof(float), edge_AABBs(d); frustum_cullAABBs(bits, planes, &sa3, &edge3, BATCH); expand_bits(d, bits), \
+        edge_AABBs(expected); test_AABBs(expected, expected)) \
+    X(pool_vec3_transformMat4, K_NONE, BIG * 3 * sizeof(float), pool_run(&workers, d, BIG, &op_vec3), vec3_transformMat4_n(expected, 0, big, 3, m4, BIG)) \
+    X(pool_vec4_transformMat4, K_NONE, BIG * 4 * sizeof(float), pool_run(&workers, d, BIG, &op_vec4), vec4_transformMat4_n(expected, 0, big, 4, m4, BIG)) \
+    X(pool_mat4_multiply, K_BIGM, BIGM * 16 * sizeof(float), pool_run(&workers, d, BIGM, &op_multiply), mat4_multiply_n(expected, n4, BIGM)) \
+    X(pool_mat4_multiply_strided, K_BIGM, BIGM * 16 * sizeof(float), pool_run(&workers, d, BIGM, &op_multiply_strided), mat4_multiply_n(expected, n4, BIGM)) \
+    X(pool_mat4_invert, K_BIGM, BIGM * 16 * sizeof(float), pool_run(&workers, d, BIGM, &op_invert), mat4_invert_n(expected, NULL, BIGM))
+// End float only
+
+#define DEFINE_SAME(name, kind, bytes, body, ref) \
+    static void same_##name(void) { body; } \
+    static void same_reference_##name(void) { ref; }
+SAME_CASES(DEFINE_SAME)
+// Float only
+FLOAT_SAME_CASES(DEFINE_SAME)
+// End float only
+
+struct same_case {
+    const char* name;
+    uint8_t kind;
+    size_t bytes;
+    void (*run)(void);
+    void (*ref)(void);
+};
+
+#define SAME_ENTRY(name, kind, bytes, body, ref) { #name, kind, bytes, same_##name, same_reference_##name },
+static struct same_case same_cases[] = {
+    SAME_CASES(SAME_ENTRY)
+// Float only
+    FLOAT_SAME_CASES(SAME_ENTRY)
+// End float only
+};
+
+// Sets d and ld to the operand of a kind
+static void reset(uint8_t kind) {
+    static struct { float* f; long double* l; size_t n; } sources[K_COUNT] = {
+        [K_MAT2] = { m2, lm2, 4 }, [K_MAT3] = { m3, lm3, 9 }, [K_MAT4] = { m4, lm4, 16 },
+        [K_VEC] = { a, la, 4 }, [K_QUAT] = { q, lq, 4 }, [K_QUAT2] = { dq, ldq, 8 },
+        [K_BMAT4] = { bm, lbm, BATCH * 16 }, [K_BVEC] = { bv, lbv, BATCH * 4 }, [K_BQUAT] = { bq, lbq, BATCH * 4 },
+        [K_SOA] = { bsa, lbsa, BATCH * 4 }, [K_RANGE] = { brange, lbrange, BATCH * 4 }, [K_HALF] = { bhalf, lbhalf, BATCH * 4 },
+        [K_NORMALS] = { bnorm, lbnorm, BATCH * 3 }, [K_BIG] = { big, lbig, BIG * 4 }, [K_BIGM] = { bigm, lbigm, BIGM * 16 },
+    };
+    memset(d, 0, sizeof(d));
+    memset(ld, 0, sizeof(ld));
+    memcpy(d, sources[kind].f, sources[kind].n * sizeof(float));
+    memcpy(ld, sources[kind].l, sources[kind].n * sizeof(long double));
+}
+
+struct test_error {
+    double ulps;
+    size_t index;
+    size_t iteration;
+    float got;
+    long double ref;
+};
+
+static struct test_error worst[sizeof(cases) / sizeof(cases[0])];
+
+// The first mismatch of each SAME_CASES entry
+static struct {
+    uint8_t failed;
+    size_t index;
+    size_t iteration;
+    float got;
+    float expected;
+} mismatch[sizeof(same_cases) / sizeof(same_cases[0])];
+
+// Byte offset of the first difference between d and expected, or bytes
+static size_t first_difference(size_t bytes) {
+    unsigned char* got = (unsigned char*)d;
+    unsigned char* want = (unsigned char*)expected;
+    size_t i = 0;
+    while (i < bytes && got[i] == want[i]) {
+        i++;
+    }
+    return i;
+}
+
+// Worst error of the result in d against ld, in ULPs of the largest
+// reference component of each group
+static struct test_error measure(struct test_case* c) {
+    struct test_error worst = { 0 };
+    size_t i, k;
+
+    for (i = 0; i < c->count; i++) {
+        long double scale = c->floor(i), ulp;
+        for (k = 0; k < c->comps; k++) {
+            long double x = fabsl(ld[i * c->estep + k * c->cstride]);
+            if (isfinite(x) && x > scale) {
+                scale = x;
+            }
+        }
+        ulp = scale < FLT_MIN ? FLT_TRUE_MIN : ldexpl(1, ilogbl(scale) - (FLT_MANT_DIG - 1));
+
+        for (k = 0; k < c->comps; k++) {
+            size_t index = i * c->estep + k * c->cstride;
+            long double got = d[index], ref = ld[index];
+            double err;
+            if (isnan(got) || isnan(ref)) {
+                err = isnan(got) && isnan(ref) ? 0 : INFINITY;
+            }
+            else if (isinf(got) || isinf(ref)) {
+                err = got == ref ? 0 : INFINITY;
+            }
+            else {
+                err = (double)(fabsl(got - ref) / ulp);
+            }
+            if (err > worst.ulps || (i == 0 && k == 0)) {
+                worst.ulps = err;
+                worst.index = index;
+                worst.got = d[index];
+                worst.ref = ld[index];
+            }
+        }
+    }
+    return worst;
+}
+
+static void usage(const char* name) {
+    fprintf(stderr, "usage: %s [--iters N] [--seed N] [--filter STR] [--verbose]\n", name);
+    exit(2);
+}
+
+int main(int argc, char** argv) {
+    const char* filter = NULL;
+    size_t count = sizeof(cases) / sizeof(cases[0]);
+    size_t same_count = sizeof(same_cases) / sizeof(same_cases[0]);
+    size_t iters = 200, ran = 0, failed = 0, i, it;
+    uint64_t seed = 1;
+    int verbose = 0;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++) {
+        if (!strcmp(argv[arg], "--iters") && arg + 1 < argc) {
+            iters = strtoul(argv[++arg], NULL, 10);
+        }
+        else if (!strcmp(argv[arg], "--seed") && arg + 1 < argc) {
+            seed = strtoull(argv[++arg], NULL, 10);
+        }
+        else if (!strcmp(argv[arg], "--filter") && arg + 1 < argc) {
+            filter = argv[++arg];
+        }
+        else if (!strcmp(argv[arg], "--verbose")) {
+            verbose = 1;
+        }
+        else {
+            usage(argv[0]);
+        }
+    }
+    if (!iters) {
+        usage(argv[0]);
+    }
+    // Float only
+    if (!pool_init(&workers, 4)) {
+        fprintf(stderr, "pool_init failed\n");
+        return 1;
+    }
+    // End float only
+
+    printf("# cpu features: %s%s%s%s, level %u, %zu iterations, seed %llu\n",
+        cpu_features() & CPU_SSE41 ? "sse4.1 " : "", cpu_features() & CPU_AVX2 ? "avx2 " : "",
+        cpu_features() & CPU_FMA ? "fma " : "", cpu_features() & CPU_F16C ? "f16c " : "",
+        (unsigned)cpu_level(), iters, (unsigned long long)seed);
+
+    rng = seed * 0x9e3779b97f4a7c15ull + 1;
+    for (it = 0; it < iters; it++) {
+        generate(it % 4 == 3);
+        for (i = 0; i < count; i++) {
+            struct test_case* c = &cases[i];
+            struct test_error err;
+
+            if (filter && !strstr(c->name, filter)) {
+                continue;
+            }
+            reset(c->kind);
+            c->run();
+            c->ref();
+            err = measure(c);
+            if (err.ulps > worst[i].ulps || it == 0) {
+                worst[i] = err;
+                worst[i].iteration = it;
+            }
+        }
+        for (i = 0; i < same_count; i++) {
+            struct same_case* c = &same_cases[i];
+            size_t index;
+
+            if (filter && !strstr(c->name, filter)) {
+                continue;
+            }
+            reset(c->kind);
+            memcpy(expected, d, sizeof(d));
+            c->run();
+            c->ref();
+            index = first_difference(c->bytes);
+            if (index < c->bytes && !mismatch[i].failed) {
+                mismatch[i].failed = 1;
+                mismatch[i].index = index;
+                mismatch[i].iteration = it;
+                mismatch[i].got = d[index / sizeof(float)];
+                mismatch[i].expected = expected[index / sizeof(float)];
+            }
+        }
+    }
+
+    if (verbose) {
+        printf("%-42s %12s %10s\n", "function", "max ulps", "budget");
+    }
+    for (i = 0; i < count; i++) {
+        struct test_case* c = &cases[i];
+        struct test_error* w = &worst[i];
+
+        if (filter && !strstr(c->name, filter)) {
+            continue;
+        }
+        ran++;
+        if (w->ulps > c->budget) {
+            failed++;
+            printf("FAIL %-37s %12.2f %10.0f  iteration %zu, [%zu] = %.9g, expected %.12Lg\n",
+                c->name, w->ulps, c->budget, w->iteration, w->index, w->got, w->ref);
+        }
+        else if (verbose) {
+            printf("%-42s %12.2f %10.0f\n", c->name, w->ulps, c->budget);
+        }
+    }
+    for (i = 0; i < same_count; i++) {
+        struct same_case* c = &same_cases[i];
+
+        if (filter && !strstr(c->name, filter)) {
+            continue;
+        }
+        ran++;
+        if (mismatch[i].failed) {
+            failed++;
+            printf("FAIL %-37s %12s %10s  iteration %zu, byte %zu, [%zu] = %.9g, expected %.9g\n",
+                c->name, "differs", "same", mismatch[i].iteration, mismatch[i].index, mismatch[i].index / sizeof(float),
+                mismatch[i].got, mismatch[i].expected);
+        }
+        else if (verbose) {
+            printf("%-42s %12s %10s\n", c->name, "same", "same");
+        }
+    }
+
+    printf("%zu cases, %zu failed\n", ran, failed);
+    // Float only
+    pool_destroy(&workers);
+    // End float only
+    return failed ? 1 : 0;
+}
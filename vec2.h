@@ -2,6 +2,7 @@
 #define VEC2_H
 
 #include <stdint.h>
+#include "api.h"
 
 /**
  * Copy the values from one vec2 to another
@@ -9,7 +10,7 @@
  * @param {vec2} out the receiving vector
  * @param {vec2} a the source vector
  */
-void vec2_copy(float* dst, float* a);
+GL_MATRIX_API void vec2_copy(float* dst, float* a);
 
 /**
  * Set the components of a vec2 to the given values
@@ -18,7 +19,7 @@ void vec2_copy(float* dst, float* a);
  * @param {Number} x X component
  * @param {Number} y Y component
  */
-void vec2_set(float* dst, float x, float y);
+GL_MATRIX_API void vec2_set(float* dst, float x, float y);
 
 /**
  * Adds two vec2's
@@ -26,7 +27,7 @@ void vec2_set(float* dst, float x, float y);
  * @param {vec2} out the receiving vector
  * @param {vec2} b the second operand
  */
-void vec2_add(float* dst, float* b);
+GL_MATRIX_API void vec2_add(float* dst, float* b);
 
 /**
  * Subtracts vector b from vector a
@@ -34,7 +35,7 @@ void vec2_add(float* dst, float* b);
  * @param {vec2} out the receiving vector
  * @param {vec2} b the second operand
  */
-void vec2_subtract(float* dst, float* b);
+GL_MATRIX_API void vec2_subtract(float* dst, float* b);
 
 /**
  * Multiplies two vec2's
@@ -42,7 +43,7 @@ void vec2_subtract(float* dst, float* b);
  * @param {vec2} out the receiving vector
  * @param {vec2} b the second operand
  */
-void vec2_multiply(float* dst, float* b);
+GL_MATRIX_API void vec2_multiply(float* dst, float* b);
 
 /**
  * Divides two vec2's
@@ -50,21 +51,21 @@ void vec2_multiply(float* dst, float* b);
  * @param {vec2} out the receiving vector
  * @param {vec2} b the second operand
  */
-void vec2_divide(float* dst, float* b);
+GL_MATRIX_API void vec2_divide(float* dst, float* b);
 
 /**
  * ceilf the components of a vec2
  *
  * @param {vec2} out the receiving vector
  */
-void vec2_ceil(float* dst);
+GL_MATRIX_API void vec2_ceil(float* dst);
 
 /**
  * floorf the components of a vec2
  *
  * @param {vec2} out the receiving vector
  */
-void vec2_floor(float* dst);
+GL_MATRIX_API void vec2_floor(float* dst);
 
 /**
  * Returns the minimum of two vec2's
@@ -72,7 +73,7 @@ void vec2_floor(float* dst);
  * @param {vec2} out the receiving vector
  * @param {vec2} b the second operand
  */
-void vec2_min(float* dst, float* b);
+GL_MATRIX_API void vec2_min(float* dst, float* b);
 
 /**
  * Returns the maximum of two vec2's
@@ -80,14 +81,14 @@ void vec2_min(float* dst, float* b);
  * @param {vec2} out the receiving vector
  * @param {vec2} b the second operand
  */
-void vec2_max(float* dst, float* b);
+GL_MATRIX_API void vec2_max(float* dst, float* b);
 
 /**
  * roundf the components of a vec2
  *
  * @param {vec2} out the receiving vector
  */
-void vec2_round(float* dst);
+GL_MATRIX_API void vec2_round(float* dst);
 
 /**
  * Scales a vec2 by a scalar number
@@ -95,7 +96,7 @@ void vec2_round(float* dst);
  * @param {vec2} out the receiving vector
  * @param {Number} b amount to scale the vector by
  */
-void vec2_scale(float* dst, float b);
+GL_MATRIX_API void vec2_scale(float* dst, float b);
 
 /**
  * Adds two vec2's after scaling the second operand by a scalar value
@@ -104,7 +105,7 @@ void vec2_scale(float* dst, float b);
  * @param {vec2} b the second operand
  * @param {Number} scale the amount to scale b by before adding
  */
-void vec2_scaleAndAdd(float* dst, float* b, float scale);
+GL_MATRIX_API void vec2_scaleAndAdd(float* dst, float* b, float scale);
 
 /**
  * Calculates the euclidian distance between two vec2's
@@ -113,7 +114,7 @@ void vec2_scaleAndAdd(float* dst, float* b, float scale);
  * @param {vec2} b the second operand
  * @returns {Number} distance between a and b
  */
-float vec2_distance(float* a, float* b);
+GL_MATRIX_API float vec2_distance(float* a, float* b);
 
 /**
  * Calculates the squared euclidian distance between two vec2's
@@ -122,7 +123,7 @@ float vec2_distance(float* a, float* b);
  * @param {vec2} b the second operand
  * @returns {Number} squared distance between a and b
  */
-float vec2_squaredDistance(float* a, float* b);
+GL_MATRIX_API float vec2_squaredDistance(float* a, float* b);
 
 /**
  * Calculates the length of a vec2
@@ -130,7 +131,7 @@ float vec2_squaredDistance(float* a, float* b);
  * @param {vec2} a vector to calculate length of
  * @returns {Number} length of a
  */
-float vec2_length(float* a);
+GL_MATRIX_API float vec2_length(float* a);
 
 /**
  * Calculates the squared length of a vec2
@@ -138,7 +139,7 @@ float vec2_length(float* a);
  * @param {vec2} a vector to calculate squared length of
  * @returns {Number} squared length of a
  */
-float vec2_squaredLength(float* a);
+GL_MATRIX_API float vec2_squaredLength(float* a);
 
 /**
  * Negates the components of a vec2
@@ -147,21 +148,21 @@ float vec2_squaredLength(float* a);
  * @param {vec2} a vector to negate
  * @returns {vec2} out
  */
-void vec2_negate(float* dst);
+GL_MATRIX_API void vec2_negate(float* dst);
 
 /**
  * Returns the inverse of the components of a vec2
  *
  * @param {vec2} out the receiving vector
  */
-void vec2_inverse(float* dst);
+GL_MATRIX_API void vec2_inverse(float* dst);
 
 /**
  * Normalize a vec2
  *
  * @param {vec2} out the receiving vector
  */
-void vec2_normalize(float* dst);
+GL_MATRIX_API void vec2_normalize(float* dst);
 
 /**
  * Calculates the dot product of two vec2's
@@ -170,7 +171,7 @@ void vec2_normalize(float* dst);
  * @param {vec2} b the second operand
  * @returns {Number} dot product of a and b
  */
-float vec2_dot(float* a, float* b);
+GL_MATRIX_API float vec2_dot(float* a, float* b);
 
 /**
  * Computes the cross product of two vec2's
@@ -179,7 +180,7 @@ float vec2_dot(float* a, float* b);
  * @param {vec3} out the receiving vector
  * @param {vec2} b the second operand
  */
-void vec2_cross(float* dst, float* b);
+GL_MATRIX_API void vec2_cross(float* dst, float* b);
 
 /**
  * Performs a linear interpolation between two vec2's
@@ -188,7 +189,7 @@ void vec2_cross(float* dst, float* b);
  * @param {vec2} b the second operand
  * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
  */
-void vec2_lerp(float* dst, float* b, float t);
+GL_MATRIX_API void vec2_lerp(float* dst, float* b, float t);
 
 /**
  * Transforms the vec2 with a mat2
@@ -196,7 +197,7 @@ void vec2_lerp(float* dst, float* b, float t);
  * @param {vec2} out the receiving vector
  * @param {mat2} m matrix to transform with
  */
-void vec2_transformMat2(float* dst, float* m);
+GL_MATRIX_API void vec2_transformMat2(float* dst, float* m);
 
 /**
  * Transforms the vec2 with a mat2d
@@ -204,7 +205,7 @@ void vec2_transformMat2(float* dst, float* m);
  * @param {vec2} out the receiving vector
  * @param {mat2d} m matrix to transform with
  */
-void vec2_transformMat2d(float* dst, float* m);
+GL_MATRIX_API void vec2_transformMat2d(float* dst, float* m);
 
 /**
  * Transforms the vec2 with a mat3
@@ -213,7 +214,7 @@ void vec2_transformMat2d(float* dst, float* m);
  * @param {vec2} out the receiving vector
  * @param {mat3} m matrix to transform with
  */
-void vec2_transformMat3(float* dst, float* m);
+GL_MATRIX_API void vec2_transformMat3(float* dst, float* m);
 
 /**
  * Transforms the vec2 with a mat4
@@ -224,7 +225,7 @@ void vec2_transformMat3(float* dst, float* m);
  * @param {vec2} a the vector to transform
  * @param {mat4} m matrix to transform with
  */
-void vec2_transformMat4(float* dst, float* m);
+GL_MATRIX_API void vec2_transformMat4(float* dst, float* m);
 
 /**
  * Rotate a 2D vector
@@ -232,7 +233,7 @@ void vec2_transformMat4(float* dst, float* m);
  * @param {vec2} b The origin of the rotation
  * @param {Number} c The angle of rotation
  */
-void vec2_rotate(float* dst, float* b, float c);
+GL_MATRIX_API void vec2_rotate(float* dst, float* b, float c);
 
 /**
  * Get the angle between two 2D vectors
@@ -240,7 +241,7 @@ void vec2_rotate(float* dst, float* b, float c);
  * @param {vec2} b The second operand
  * @returns {Number} The angle in radians
  */
-float vec2_angle(float* a, float* b);
+GL_MATRIX_API float vec2_angle(float* a, float* b);
 
 /**
  * Returns whether or not the vectors exactly have the same elements
@@ -249,6 +250,6 @@ float vec2_angle(float* a, float* b);
  * @param {vec2} b The second vector.
  * @returns {Boolean} True if the vectors are equal, false otherwise.
  */
-uint8_t vec2_exactEquals(float* a, float* b);
+GL_MATRIX_API uint8_t vec2_exactEquals(float* a, float* b);
 
 #endif
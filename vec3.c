@@ -1,4 +1,6 @@
 #include "vec3.h"
+#include "cpu.h"
+#include "simd.h"
 #include <math.h>
 
 /**
@@ -7,7 +9,7 @@
  * @param {vec3} a vector to calculate length of
  * @returns {Number} length of a
  */
-float vec3_length(float* a) {
+GL_MATRIX_API float vec3_length(float* a) {
     float x = a[0];
     float y = a[1];
     float z = a[2];
@@ -20,7 +22,7 @@ float vec3_length(float* a) {
  * @param {vec3} out the receiving vector
  * @param {vec3} a the source vector
  */
-void vec3_copy(float* dst, float* a) {
+GL_MATRIX_API void vec3_copy(float* dst, float* a) {
     dst[0] = a[0];
     dst[1] = a[1];
     dst[2] = a[2];
@@ -34,7 +36,7 @@ void vec3_copy(float* dst, float* a) {
  * @param {Number} y Y component
  * @param {Number} z Z component
  */
-void vec3_set(float* dst, float x, float y, float z) {
+GL_MATRIX_API void vec3_set(float* dst, float x, float y, float z) {
     dst[0] = x;
     dst[1] = y;
     dst[2] = z;
@@ -46,7 +48,7 @@ void vec3_set(float* dst, float x, float y, float z) {
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_add(float* dst, float* b) {
+GL_MATRIX_API void vec3_add(float* dst, float* b) {
     dst[0] = dst[0] + b[0];
     dst[1] = dst[1] + b[1];
     dst[2] = dst[2] + b[2];
@@ -58,7 +60,7 @@ void vec3_add(float* dst, float* b) {
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_subtract(float* dst, float* b) {
+GL_MATRIX_API void vec3_subtract(float* dst, float* b) {
     dst[0] = dst[0] - b[0];
     dst[1] = dst[1] - b[1];
     dst[2] = dst[2] - b[2];
@@ -70,7 +72,7 @@ void vec3_subtract(float* dst, float* b) {
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_multiply(float* dst, float* b) {
+GL_MATRIX_API void vec3_multiply(float* dst, float* b) {
     dst[0] = dst[0] * b[0];
     dst[1] = dst[1] * b[1];
     dst[2] = dst[2] * b[2];
@@ -82,7 +84,7 @@ void vec3_multiply(float* dst, float* b) {
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_divide(float* dst, float* b) {
+GL_MATRIX_API void vec3_divide(float* dst, float* b) {
     dst[0] = dst[0] / b[0];
     dst[1] = dst[1] / b[1];
     dst[2] = dst[2] / b[2];
@@ -93,7 +95,7 @@ void vec3_divide(float* dst, float* b) {
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_ceil(float* dst) {
+GL_MATRIX_API void vec3_ceil(float* dst) {
     dst[0] = ceilf(dst[0]);
     dst[1] = ceilf(dst[1]);
     dst[2] = ceilf(dst[2]);
@@ -104,7 +106,7 @@ void vec3_ceil(float* dst) {
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_floor(float* dst) {
+GL_MATRIX_API void vec3_floor(float* dst) {
     dst[0] = floorf(dst[0]);
     dst[1] = floorf(dst[1]);
     dst[2] = floorf(dst[2]);
@@ -116,7 +118,7 @@ void vec3_floor(float* dst) {
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_min(float* dst, float* b) {
+GL_MATRIX_API void vec3_min(float* dst, float* b) {
     dst[0] = fmin(dst[0], b[0]);
     dst[1] = fmin(dst[1], b[1]);
     dst[2] = fmin(dst[2], b[2]);
@@ -128,7 +130,7 @@ void vec3_min(float* dst, float* b) {
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_max(float* dst, float* b) {
+GL_MATRIX_API void vec3_max(float* dst, float* b) {
     dst[0] = fmax(dst[0], b[0]);
     dst[1] = fmax(dst[1], b[1]);
     dst[2] = fmax(dst[2], b[2]);
@@ -139,7 +141,7 @@ void vec3_max(float* dst, float* b) {
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_round(float* dst) {
+GL_MATRIX_API void vec3_round(float* dst) {
     dst[0] = roundf(dst[0]);
     dst[1] = roundf(dst[1]);
     dst[2] = roundf(dst[2]);
@@ -151,7 +153,7 @@ void vec3_round(float* dst) {
  * @param {vec3} out the receiving vector
  * @param {Number} b amount to scale the vector by
  */
-void vec3_scale(float* dst, float b) {
+GL_MATRIX_API void vec3_scale(float* dst, float b) {
     dst[0] = dst[0] * b;
     dst[1] = dst[1] * b;
     dst[2] = dst[2] * b;
@@ -164,7 +166,7 @@ void vec3_scale(float* dst, float b) {
  * @param {vec3} b the second operand
  * @param {Number} scale the amount to scale b by before adding
  */
-void vec3_scaleAndAdd(float* dst, float* b, float scale) {
+GL_MATRIX_API void vec3_scaleAndAdd(float* dst, float* b, float scale) {
     dst[0] = dst[0] + (b[0] * scale);
     dst[1] = dst[1] + (b[1] * scale);
     dst[2] = dst[2] + (b[2] * scale);
@@ -177,7 +179,7 @@ void vec3_scaleAndAdd(float* dst, float* b, float scale) {
  * @param {vec3} b the second operand
  * @returns {Number} distance between a and b
  */
-float vec3_distance(float* a, float* b) {
+GL_MATRIX_API float vec3_distance(float* a, float* b) {
     float x = b[0] - a[0];
     float y = b[1] - a[1];
     float z = b[2] - a[2];
@@ -191,7 +193,7 @@ float vec3_distance(float* a, float* b) {
  * @param {vec3} b the second operand
  * @returns {Number} squared distance between a and b
  */
-float vec3_squaredDistance(float* a, float* b) {
+GL_MATRIX_API float vec3_squaredDistance(float* a, float* b) {
     float x = b[0] - a[0];
     float y = b[1] - a[1];
     float z = b[2] - a[2];
@@ -204,7 +206,7 @@ float vec3_squaredDistance(float* a, float* b) {
  * @param {vec3} a vector to calculate squared length of
  * @returns {Number} squared length of a
  */
-float vec3_squaredLength(float* a) {
+GL_MATRIX_API float vec3_squaredLength(float* a) {
     float x = a[0];
     float y = a[1];
     float z = a[2];
@@ -216,7 +218,7 @@ float vec3_squaredLength(float* a) {
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_negate(float* dst) {
+GL_MATRIX_API void vec3_negate(float* dst) {
     dst[0] = -dst[0];
     dst[1] = -dst[1];
     dst[2] = -dst[2];
@@ -227,7 +229,7 @@ void vec3_negate(float* dst) {
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_inverse(float* dst) {
+GL_MATRIX_API void vec3_inverse(float* dst) {
     dst[0] = 1.0 / dst[0];
     dst[1] = 1.0 / dst[1];
     dst[2] = 1.0 / dst[2];
@@ -238,7 +240,7 @@ void vec3_inverse(float* dst) {
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_normalize(float* dst) {
+GL_MATRIX_API void vec3_normalize(float* dst) {
     float x = dst[0];
     float y = dst[1];
     float z = dst[2];
@@ -258,7 +260,7 @@ void vec3_normalize(float* dst) {
  * @param {vec3} b the second operand
  * @returns {Number} dot product of a and b
  */
-float vec3_dot(float* a, float* b) {
+GL_MATRIX_API float vec3_dot(float* a, float* b) {
     return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
 }
 
@@ -268,7 +270,7 @@ float vec3_dot(float* a, float* b) {
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_cross(float* dst, float* b) {
+GL_MATRIX_API void vec3_cross(float* dst, float* b) {
     float ax = dst[0], ay = dst[1], az = dst[2];
     float bx = b[0], by = b[1], bz = b[2];
 
@@ -284,7 +286,7 @@ void vec3_cross(float* dst, float* b) {
  * @param {vec3} b the second operand
  * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
  */
-void vec3_lerp(float* dst, float* b, float t) {
+GL_MATRIX_API void vec3_lerp(float* dst, float* b, float t) {
     float ax = dst[0];
     float ay = dst[1];
     float az = dst[2];
@@ -302,7 +304,7 @@ void vec3_lerp(float* dst, float* b, float t) {
  * @param {vec3} d the fourth operand
  * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
  */
-void vec3_hermite(float* dst, float* b, float* c, float* d, float t) {
+GL_MATRIX_API void vec3_hermite(float* dst, float* b, float* c, float* d, float t) {
     float factorTimes2 = t * t;
     float factor1 = factorTimes2 * (2 * t - 3) + 1;
     float factor2 = factorTimes2 * (t - 2) + t;
@@ -323,7 +325,7 @@ void vec3_hermite(float* dst, float* b, float* c, float* d, float t) {
  * @param {vec3} d the fourth operand
  * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
  */
-void vec3_bezier(float* dst, float* b, float* c, float* d, float t) {
+GL_MATRIX_API void vec3_bezier(float* dst, float* b, float* c, float* d, float t) {
     float inverseFactor = 1 - t;
     float inverseFactorTimesTwo = inverseFactor * inverseFactor;
     float factorTimes2 = t * t;
@@ -344,22 +346,176 @@ void vec3_bezier(float* dst, float* b, float* c, float* d, float t) {
  * @param {vec3} out the receiving vector
  * @param {mat4} m matrix to transform with
  */
-void vec3_transformMat4(float* dst, float* m) {
+GL_MATRIX_API SIMD_CLONES void vec3_transformMat4(float* dst, float* m) {
     float x = dst[0], y = dst[1], z = dst[2];
     float w = m[3] * x + m[7] * y + m[11] * z + m[15];
-    w = w || 1.0;
+    w = w ? w : 1.0;
     dst[0] = (m[0] * x + m[4] * y + m[8] * z + m[12]) / w;
     dst[1] = (m[1] * x + m[5] * y + m[9] * z + m[13]) / w;
     dst[2] = (m[2] * x + m[6] * y + m[10] * z + m[14]) / w;
 }
 
+static void vec3_transformMat4_n_scalar(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n, uint8_t projective) {
+    float m0 = m[0], m1 = m[1], m2 = m[2], m3 = m[3];
+    float m4 = m[4], m5 = m[5], m6 = m[6], m7 = m[7];
+    float m8 = m[8], m9 = m[9], m10 = m[10], m11 = m[11];
+    float m12 = m[12], m13 = m[13], m14 = m[14], m15 = m[15];
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        float* s = src + i * src_stride;
+        float* d = dst + i * dst_stride;
+        float x = s[0], y = s[1], z = s[2];
+        float w = 1.0;
+        if (projective) {
+            w = m3 * x + m7 * y + m11 * z + m15;
+            w = w ? w : 1.0;
+        }
+        d[0] = (m0 * x + m4 * y + m8 * z + m12) / w;
+        d[1] = (m1 * x + m5 * y + m9 * z + m13) / w;
+        d[2] = (m2 * x + m6 * y + m10 * z + m14) / w;
+    }
+}
+
+#if GL_MATRIX_SIMD
+SIMD_SSE41 static void vec3_transformMat4_n_sse41(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n, uint8_t projective) {
+    __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]), m3 = _mm_set1_ps(m[3]);
+    __m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]), m7 = _mm_set1_ps(m[7]);
+    __m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]), m11 = _mm_set1_ps(m[11]);
+    __m128 m12 = _mm_set1_ps(m[12]), m13 = _mm_set1_ps(m[13]), m14 = _mm_set1_ps(m[14]), m15 = _mm_set1_ps(m[15]);
+    __m128 one = _mm_set1_ps(1.0f);
+    float ox[4], oy[4], oz[4];
+    size_t i;
+    uint8_t k;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        float* s = src + i * src_stride;
+        __m128 x = _mm_setr_ps(s[0], s[src_stride], s[2 * src_stride], s[3 * src_stride]);
+        __m128 y = _mm_setr_ps(s[1], s[src_stride + 1], s[2 * src_stride + 1], s[3 * src_stride + 1]);
+        __m128 z = _mm_setr_ps(s[2], s[src_stride + 2], s[2 * src_stride + 2], s[3 * src_stride + 2]);
+
+        // Same evaluation order as the scalar path
+        __m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_mul_ps(m8, z)), m12);
+        __m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m9, z)), m13);
+        __m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_mul_ps(m10, z)), m14);
+
+        if (projective) {
+            __m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m3, x), _mm_mul_ps(m7, y)), _mm_mul_ps(m11, z)), m15);
+            w = _mm_blendv_ps(w, one, _mm_cmpeq_ps(w, _mm_setzero_ps()));
+            rx = _mm_div_ps(rx, w);
+            ry = _mm_div_ps(ry, w);
+            rz = _mm_div_ps(rz, w);
+        }
+
+        _mm_storeu_ps(ox, rx);
+        _mm_storeu_ps(oy, ry);
+        _mm_storeu_ps(oz, rz);
+        for (k = 0; k < 4; k++) {
+            float* d = dst + (i + k) * dst_stride;
+            d[0] = ox[k];
+            d[1] = oy[k];
+            d[2] = oz[k];
+        }
+    }
+    vec3_transformMat4_n_scalar(dst + i * dst_stride, dst_stride, src + i * src_stride, src_stride, m, n - i, projective);
+}
+
+SIMD_AVX2 static void vec3_transformMat4_n_avx2(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n, uint8_t projective) {
+    __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]), m3 = _mm256_set1_ps(m[3]);
+    __m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]), m7 = _mm256_set1_ps(m[7]);
+    __m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]), m11 = _mm256_set1_ps(m[11]);
+    __m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]), m14 = _mm256_set1_ps(m[14]), m15 = _mm256_set1_ps(m[15]);
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256i idx = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((int)src_stride));
+    float ox[8], oy[8], oz[8];
+    size_t i;
+    uint8_t k;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        float* s = src + i * src_stride;
+        __m256 x = _mm256_i32gather_ps(s, idx, 4);
+        __m256 y = _mm256_i32gather_ps(s + 1, idx, 4);
+        __m256 z = _mm256_i32gather_ps(s + 2, idx, 4);
+
+        __m256 rx = _mm256_add_ps(_mm256_fmadd_ps(m8, z, _mm256_fmadd_ps(m4, y, _mm256_mul_ps(m0, x))), m12);
+        __m256 ry = _mm256_add_ps(_mm256_fmadd_ps(m9, z, _mm256_fmadd_ps(m5, y, _mm256_mul_ps(m1, x))), m13);
+        __m256 rz = _mm256_add_ps(_mm256_fmadd_ps(m10, z, _mm256_fmadd_ps(m6, y, _mm256_mul_ps(m2, x))), m14);
+
+        if (projective) {
+            __m256 w = _mm256_add_ps(_mm256_fmadd_ps(m11, z, _mm256_fmadd_ps(m7, y, _mm256_mul_ps(m3, x))), m15);
+            w = _mm256_blendv_ps(w, one, _mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_EQ_OQ));
+            rx = _mm256_div_ps(rx, w);
+            ry = _mm256_div_ps(ry, w);
+            rz = _mm256_div_ps(rz, w);
+        }
+
+        _mm256_storeu_ps(ox, rx);
+        _mm256_storeu_ps(oy, ry);
+        _mm256_storeu_ps(oz, rz);
+        for (k = 0; k < 8; k++) {
+            float* d = dst + (i + k) * dst_stride;
+            d[0] = ox[k];
+            d[1] = oy[k];
+            d[2] = oz[k];
+        }
+    }
+    vec3_transformMat4_n_scalar(dst + i * dst_stride, dst_stride, src + i * src_stride, src_stride, m, n - i, projective);
+}
+#endif
+
+static void (*vec3_transformMat4_n_impl)(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n, uint8_t projective) = vec3_transformMat4_n_scalar;
+
+__attribute__((constructor))
+static void vec3_dispatch(void) {
+#if GL_MATRIX_SIMD
+    uint32_t features = cpu_features();
+
+    if ((features & CPU_AVX2) && (features & CPU_FMA)) {
+        vec3_transformMat4_n_impl = vec3_transformMat4_n_avx2;
+    }
+    else if (features & CPU_SSE41) {
+        vec3_transformMat4_n_impl = vec3_transformMat4_n_sse41;
+    }
+#endif
+}
+
+/**
+ * Transforms an array of vec3s with a mat4.
+ * 4th vector component is implicitly '1'
+ *
+ * @param {vec3[]} out the receiving vectors
+ * @param {Number} dst_stride floats between the start of each receiving vector, 0 if tightly packed
+ * @param {vec3[]} a the source vectors, may be out itself when the strides match
+ * @param {Number} src_stride floats between the start of each source vector, 0 if tightly packed
+ * @param {mat4} m matrix to transform with
+ * @param {Number} n number of vectors to transform
+ */
+GL_MATRIX_API void vec3_transformMat4_n(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n) {
+    vec3_transformMat4_n_impl(dst, dst_stride ? dst_stride : 3, src, src_stride ? src_stride : 3, m, n, 1);
+}
+
+/**
+ * Transforms an array of vec3s with an affine mat4, skipping the divide by w.
+ * The bottom row of m is assumed to be [0, 0, 0, 1].
+ *
+ * @param {vec3[]} out the receiving vectors
+ * @param {Number} dst_stride floats between the start of each receiving vector, 0 if tightly packed
+ * @param {vec3[]} a the source vectors, may be out itself when the strides match
+ * @param {Number} src_stride floats between the start of each source vector, 0 if tightly packed
+ * @param {mat4} m affine matrix to transform with
+ * @param {Number} n number of vectors to transform
+ */
+GL_MATRIX_API void vec3_transformMat4Affine_n(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n) {
+    vec3_transformMat4_n_impl(dst, dst_stride ? dst_stride : 3, src, src_stride ? src_stride : 3, m, n, 0);
+}
+
 /**
  * Transforms the vec3 with a mat3.
  *
  * @param {vec3} out the receiving vector
  * @param {mat3} m the 3x3 matrix to transform with
  */
-void vec3_transformMat3(float* dst, float* m) {
+GL_MATRIX_API SIMD_CLONES void vec3_transformMat3(float* dst, float* m) {
     float x = dst[0], y = dst[1], z = dst[2];
     dst[0] = x * m[0] + y * m[3] + z * m[6];
     dst[1] = x * m[1] + y * m[4] + z * m[7];
@@ -373,7 +529,7 @@ void vec3_transformMat3(float* dst, float* m) {
  * @param {vec3} out the receiving vector
  * @param {quat} q quaternion to transform with
  */
-void vec3_transformQuat(float* dst, float* q) {
+GL_MATRIX_API SIMD_CLONES void vec3_transformQuat(float* dst, float* q) {
     // benchmarks: https://jsperf.com/quaternion-transform-vec3-implementations-fixed
     float qx = q[0], qy = q[1], qz = q[2], qw = q[3];
     float x = dst[0], y = dst[1], z = dst[2];
@@ -407,7 +563,7 @@ void vec3_transformQuat(float* dst, float* q) {
  * @param {vec3} b The origin of the rotation
  * @param {Number} c The angle of rotation
  */
-void vec3_rotateX(float* dst, float* b, float c) {
+GL_MATRIX_API void vec3_rotateX(float* dst, float* b, float c) {
     float p[3], r[3];
     //Translate point to the origin
     p[0] = dst[0] - b[0];
@@ -431,7 +587,7 @@ void vec3_rotateX(float* dst, float* b, float c) {
  * @param {vec3} b The origin of the rotation
  * @param {Number} c The angle of rotation
  */
-void vec3_rotateY(float* dst, float* b, float c) {
+GL_MATRIX_API void vec3_rotateY(float* dst, float* b, float c) {
     float p[3], r[3];
     //Translate point to the origin
     p[0] = dst[0] - b[0];
@@ -455,7 +611,7 @@ void vec3_rotateY(float* dst, float* b, float c) {
  * @param {vec3} b The origin of the rotation
  * @param {Number} c The angle of rotation
  */
-void vec3_rotateZ(float* dst, float* b, float c) {
+GL_MATRIX_API void vec3_rotateZ(float* dst, float* b, float c) {
     float p[3], r[3];
     //Translate point to the origin
     p[0] = dst[0] - b[0];
@@ -479,7 +635,7 @@ void vec3_rotateZ(float* dst, float* b, float c) {
  * @param {vec3} b The second operand
  * @returns {Number} The angle in radians
  */
-float vec3_angle(float* a, float* b) {
+GL_MATRIX_API float vec3_angle(float* a, float* b) {
     float tempA[3];
     float tempB[3];
     tempA[0] = a[0], tempA[1] = a[1], tempA[2] = a[2];
@@ -507,6 +663,6 @@ float vec3_angle(float* a, float* b) {
  * @param {vec3} b The second vector.
  * @returns {Boolean} True if the vectors are equal, false otherwise.
  */
-uint8_t vec3_equals(float* a, float* b) {
+GL_MATRIX_API uint8_t vec3_equals(float* a, float* b) {
     return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
 }
@@ -1,7 +1,9 @@
 #ifndef VEC3_H
 #define VEC3_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include "api.h"
 
 /**
  * Calculates the length of a vec3
@@ -9,7 +11,7 @@
  * @param {vec3} a vector to calculate length of
  * @returns {Number} length of a
  */
-float vec3_length(float* a);
+GL_MATRIX_API float vec3_length(float* a);
 
 /**
  * Copy the values from one vec3 to another
@@ -17,7 +19,7 @@ float vec3_length(float* a);
  * @param {vec3} out the receiving vector
  * @param {vec3} a the source vector
  */
-void vec3_copy(float* dst, float* a);
+GL_MATRIX_API void vec3_copy(float* dst, float* a);
 
 /**
  * Set the components of a vec3 to the given values
@@ -27,7 +29,7 @@ void vec3_copy(float* dst, float* a);
  * @param {Number} y Y component
  * @param {Number} z Z component
  */
-void vec3_set(float* dst, float x, float y, float z);
+GL_MATRIX_API void vec3_set(float* dst, float x, float y, float z);
 
 /**
  * Adds two vec3's
@@ -35,7 +37,7 @@ void vec3_set(float* dst, float x, float y, float z);
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_add(float* dst, float* b);
+GL_MATRIX_API void vec3_add(float* dst, float* b);
 
 /**
  * Subtracts vector b from vector a
@@ -43,7 +45,7 @@ void vec3_add(float* dst, float* b);
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_subtract(float* dst, float* b);
+GL_MATRIX_API void vec3_subtract(float* dst, float* b);
 
 /**
  * Multiplies two vec3's
@@ -51,7 +53,7 @@ void vec3_subtract(float* dst, float* b);
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_multiply(float* dst, float* b);
+GL_MATRIX_API void vec3_multiply(float* dst, float* b);
 
 /**
  * Divides two vec3's
@@ -59,21 +61,21 @@ void vec3_multiply(float* dst, float* b);
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_divide(float* dst, float* b);
+GL_MATRIX_API void vec3_divide(float* dst, float* b);
 
 /**
  * Math.ceil the components of a vec3
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_ceil(float* dst);
+GL_MATRIX_API void vec3_ceil(float* dst);
 
 /**
  * Math.floor the components of a vec3
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_floor(float* dst);
+GL_MATRIX_API void vec3_floor(float* dst);
 
 /**
  * Returns the minimum of two vec3's
@@ -81,7 +83,7 @@ void vec3_floor(float* dst);
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_min(float* dst, float* b);
+GL_MATRIX_API void vec3_min(float* dst, float* b);
 
 /**
  * Returns the maximum of two vec3's
@@ -89,14 +91,14 @@ void vec3_min(float* dst, float* b);
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_max(float* dst, float* b);
+GL_MATRIX_API void vec3_max(float* dst, float* b);
 
 /**
  * Math.round the components of a vec3
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_round(float* dst);
+GL_MATRIX_API void vec3_round(float* dst);
 
 /**
  * Scales a vec3 by a scalar number
@@ -104,7 +106,7 @@ void vec3_round(float* dst);
  * @param {vec3} out the receiving vector
  * @param {Number} b amount to scale the vector by
  */
-void vec3_scale(float* dst, float b);
+GL_MATRIX_API void vec3_scale(float* dst, float b);
 
 /**
  * Adds two vec3's after scaling the second operand by a scalar value
@@ -113,7 +115,7 @@ void vec3_scale(float* dst, float b);
  * @param {vec3} b the second operand
  * @param {Number} scale the amount to scale b by before adding
  */
-void vec3_scaleAndAdd(float* dst, float* b, float scale);
+GL_MATRIX_API void vec3_scaleAndAdd(float* dst, float* b, float scale);
 
 /**
  * Calculates the euclidian distance between two vec3's
@@ -122,7 +124,7 @@ void vec3_scaleAndAdd(float* dst, float* b, float scale);
  * @param {vec3} b the second operand
  * @returns {Number} distance between a and b
  */
-float vec3_distance(float* a, float* b);
+GL_MATRIX_API float vec3_distance(float* a, float* b);
 
 /**
  * Calculates the squared euclidian distance between two vec3's
@@ -131,7 +133,7 @@ float vec3_distance(float* a, float* b);
  * @param {vec3} b the second operand
  * @returns {Number} squared distance between a and b
  */
-float vec3_squaredDistance(float* a, float* b);
+GL_MATRIX_API float vec3_squaredDistance(float* a, float* b);
 
 /**
  * Calculates the squared length of a vec3
@@ -139,28 +141,28 @@ float vec3_squaredDistance(float* a, float* b);
  * @param {vec3} a vector to calculate squared length of
  * @returns {Number} squared length of a
  */
-float vec3_squaredLength(float* a);
+GL_MATRIX_API float vec3_squaredLength(float* a);
 
 /**
  * Negates the components of a vec3
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_negate(float* dst);
+GL_MATRIX_API void vec3_negate(float* dst);
 
 /**
  * Returns the inverse of the components of a vec3
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_inverse(float* dst);
+GL_MATRIX_API void vec3_inverse(float* dst);
 
 /**
  * Normalize a vec3
  *
  * @param {vec3} out the receiving vector
  */
-void vec3_normalize(float* dst);
+GL_MATRIX_API void vec3_normalize(float* dst);
 
 /**
  * Calculates the dot product of two vec3's
@@ -169,7 +171,7 @@ void vec3_normalize(float* dst);
  * @param {vec3} b the second operand
  * @returns {Number} dot product of a and b
  */
-float vec3_dot(float* a, float* b);
+GL_MATRIX_API float vec3_dot(float* a, float* b);
 
 /**
  * Computes the cross product of two vec3's
@@ -177,7 +179,7 @@ float vec3_dot(float* a, float* b);
  * @param {vec3} out the receiving vector
  * @param {vec3} b the second operand
  */
-void vec3_cross(float* dst, float* b);
+GL_MATRIX_API void vec3_cross(float* dst, float* b);
 
 /**
  * Performs a linear interpolation between two vec3's
@@ -186,7 +188,7 @@ void vec3_cross(float* dst, float* b);
  * @param {vec3} b the second operand
  * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
  */
-void vec3_lerp(float* dst, float* b, float t);
+GL_MATRIX_API void vec3_lerp(float* dst, float* b, float t);
 
 /**
  * Performs a hermite interpolation with two control points
@@ -197,7 +199,7 @@ void vec3_lerp(float* dst, float* b, float t);
  * @param {vec3} d the fourth operand
  * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
  */
-void vec3_hermite(float* dst, float* b, float* c, float* d, float t);
+GL_MATRIX_API void vec3_hermite(float* dst, float* b, float* c, float* d, float t);
 
 /**
  * Performs a bezier interpolation with two control points
@@ -208,7 +210,7 @@ void vec3_hermite(float* dst, float* b, float* c, float* d, float t);
  * @param {vec3} d the fourth operand
  * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
  */
-void vec3_bezier(float* dst, float* b, float* c, float* d, float t);
+GL_MATRIX_API void vec3_bezier(float* dst, float* b, float* c, float* d, float t);
 
 /**
  * Transforms the vec3 with a mat4.
@@ -217,7 +219,37 @@ void vec3_bezier(float* dst, float* b, float* c, float* d, float t);
  * @param {vec3} out the receiving vector
  * @param {mat4} m matrix to transform with
  */
-void vec3_transformMat4(float* dst, float* m);
+GL_MATRIX_API void vec3_transformMat4(float* dst, float* m);
+
+/**
+ * Transforms an array of vec3s with a mat4.
+ * 4th vector component is implicitly '1'
+ *
+ * Works on 4 (SSE4.1) or 8 (AVX2) vectors at a time when the CPU supports
+ * it. The AVX2 path fuses multiply-adds, so results may differ from
+ * vec3_transformMat4 by a few ULP.
+ *
+ * @param {vec3[]} out the receiving vectors
+ * @param {Number} dst_stride floats between the start of each receiving vector, 0 if tightly packed
+ * @param {vec3[]} a the source vectors, may be out itself when the strides match
+ * @param {Number} src_stride floats between the start of each source vector, 0 if tightly packed
+ * @param {mat4} m matrix to transform with
+ * @param {Number} n number of vectors to transform
+ */
+GL_MATRIX_API void vec3_transformMat4_n(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n);
+
+/**
+ * Transforms an array of vec3s with an affine mat4, skipping the divide by w.
+ * The bottom row of m is assumed to be [0, 0, 0, 1].
+ *
+ * @param {vec3[]} out the receiving vectors
+ * @param {Number} dst_stride floats between the start of each receiving vector, 0 if tightly packed
+ * @param {vec3[]} a the source vectors, may be out itself when the strides match
+ * @param {Number} src_stride floats between the start of each source vector, 0 if tightly packed
+ * @param {mat4} m affine matrix to transform with
+ * @param {Number} n number of vectors to transform
+ */
+GL_MATRIX_API void vec3_transformMat4Affine_n(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n);
 
 /**
  * Transforms the vec3 with a mat3.
@@ -225,7 +257,7 @@ void vec3_transformMat4(float* dst, float* m);
  * @param {vec3} out the receiving vector
  * @param {mat3} m the 3x3 matrix to transform with
  */
-void vec3_transformMat3(float* dst, float* m);
+GL_MATRIX_API void vec3_transformMat3(float* dst, float* m);
 
 /**
  * Transforms the vec3 with a quat
@@ -234,7 +266,7 @@ void vec3_transformMat3(float* dst, float* m);
  * @param {vec3} out the receiving vector
  * @param {quat} q quaternion to transform with
  */
-void vec3_transformQuat(float* dst, float* q);
+GL_MATRIX_API void vec3_transformQuat(float* dst, float* q);
 
 /**
  * Rotate a 3D vector around the x-axis
@@ -242,7 +274,7 @@ void vec3_transformQuat(float* dst, float* q);
  * @param {vec3} b The origin of the rotation
  * @param {Number} c The angle of rotation
  */
-void vec3_rotateX(float* dst, float* b, float c);
+GL_MATRIX_API void vec3_rotateX(float* dst, float* b, float c);
 
 /**
  * Rotate a 3D vector around the y-axis
@@ -250,7 +282,7 @@ void vec3_rotateX(float* dst, float* b, float c);
  * @param {vec3} b The origin of the rotation
  * @param {Number} c The angle of rotation
  */
-void vec3_rotateY(float* dst, float* b, float c);
+GL_MATRIX_API void vec3_rotateY(float* dst, float* b, float c);
 
 /**
  * Rotate a 3D vector around the z-axis
@@ -258,7 +290,7 @@ void vec3_rotateY(float* dst, float* b, float c);
  * @param {vec3} b The origin of the rotation
  * @param {Number} c The angle of rotation
  */
-void vec3_rotateZ(float* dst, float* b, float c);
+GL_MATRIX_API void vec3_rotateZ(float* dst, float* b, float c);
 
 /**
  * Get the angle between two 3D vectors
@@ -266,7 +298,7 @@ void vec3_rotateZ(float* dst, float* b, float c);
  * @param {vec3} b The second operand
  * @returns {Number} The angle in radians
  */
-float vec3_angle(float* a, float* b);
+GL_MATRIX_API float vec3_angle(float* a, float* b);
 
 /**
  * Returns whether or not the vectors have exactly the same elements
@@ -275,6 +307,6 @@ float vec3_angle(float* a, float* b);
  * @param {vec3} b The second vector.
  * @returns {Boolean} True if the vectors are equal, false otherwise.
  */
-uint8_t vec3_equals(float* a, float* b);
+GL_MATRIX_API uint8_t vec3_equals(float* a, float* b);
 
 #endif
@@ -0,0 +1,364 @@
+#include "vec3soa.h"
+#include "cpu.h"
+#include "simd.h"
+#include <math.h>
+
+// The AVX2 kernels handle whole blocks of 8 and return how many vectors
+// they processed; the scalar loops in the public functions finish the tail.
+static uint8_t vec3soa_use_avx2 = 0;
+
+__attribute__((constructor))
+static void vec3soa_dispatch(void) {
+    uint32_t features = cpu_features();
+    vec3soa_use_avx2 = (features & CPU_AVX2) && (features & CPU_FMA);
+}
+
+#if GL_MATRIX_SIMD
+SIMD_AVX2 static size_t vec3soa_add_avx2(vec3soa* dst, vec3soa* b, size_t n) {
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst->x + i, _mm256_add_ps(_mm256_loadu_ps(dst->x + i), _mm256_loadu_ps(b->x + i)));
+        _mm256_storeu_ps(dst->y + i, _mm256_add_ps(_mm256_loadu_ps(dst->y + i), _mm256_loadu_ps(b->y + i)));
+        _mm256_storeu_ps(dst->z + i, _mm256_add_ps(_mm256_loadu_ps(dst->z + i), _mm256_loadu_ps(b->z + i)));
+    }
+    return i;
+}
+
+SIMD_AVX2 static size_t vec3soa_scale_avx2(vec3soa* dst, float b, size_t n) {
+    __m256 s = _mm256_set1_ps(b);
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst->x + i, _mm256_mul_ps(_mm256_loadu_ps(dst->x + i), s));
+        _mm256_storeu_ps(dst->y + i, _mm256_mul_ps(_mm256_loadu_ps(dst->y + i), s));
+        _mm256_storeu_ps(dst->z + i, _mm256_mul_ps(_mm256_loadu_ps(dst->z + i), s));
+    }
+    return i;
+}
+
+SIMD_AVX2 static size_t vec3soa_scaleAndAdd_avx2(vec3soa* dst, vec3soa* b, float scale, size_t n) {
+    __m256 s = _mm256_set1_ps(scale);
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst->x + i, _mm256_fmadd_ps(_mm256_loadu_ps(b->x + i), s, _mm256_loadu_ps(dst->x + i)));
+        _mm256_storeu_ps(dst->y + i, _mm256_fmadd_ps(_mm256_loadu_ps(b->y + i), s, _mm256_loadu_ps(dst->y + i)));
+        _mm256_storeu_ps(dst->z + i, _mm256_fmadd_ps(_mm256_loadu_ps(b->z + i), s, _mm256_loadu_ps(dst->z + i)));
+    }
+    return i;
+}
+
+SIMD_AVX2 static size_t vec3soa_dot_avx2(float* dst, vec3soa* a, vec3soa* b, size_t n) {
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256 d = _mm256_mul_ps(_mm256_loadu_ps(a->x + i), _mm256_loadu_ps(b->x + i));
+        d = _mm256_fmadd_ps(_mm256_loadu_ps(a->y + i), _mm256_loadu_ps(b->y + i), d);
+        d = _mm256_fmadd_ps(_mm256_loadu_ps(a->z + i), _mm256_loadu_ps(b->z + i), d);
+        _mm256_storeu_ps(dst + i, d);
+    }
+    return i;
+}
+
+SIMD_AVX2 static size_t vec3soa_cross_avx2(vec3soa* dst, vec3soa* b, size_t n) {
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256 ax = _mm256_loadu_ps(dst->x + i), ay = _mm256_loadu_ps(dst->y + i), az = _mm256_loadu_ps(dst->z + i);
+        __m256 bx = _mm256_loadu_ps(b->x + i), by = _mm256_loadu_ps(b->y + i), bz = _mm256_loadu_ps(b->z + i);
+        _mm256_storeu_ps(dst->x + i, _mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by)));
+        _mm256_storeu_ps(dst->y + i, _mm256_fmsub_ps(az, bx, _mm256_mul_ps(ax, bz)));
+        _mm256_storeu_ps(dst->z + i, _mm256_fmsub_ps(ax, by, _mm256_mul_ps(ay, bx)));
+    }
+    return i;
+}
+
+SIMD_AVX2 static size_t vec3soa_normalize_avx2(vec3soa* dst, size_t n) {
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(dst->x + i), y = _mm256_loadu_ps(dst->y + i), z = _mm256_loadu_ps(dst->z + i);
+        __m256 len = _mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x)));
+        // Lanes with a zero length scale by 1 and stay unchanged
+        __m256 nonzero = _mm256_cmp_ps(len, zero, _CMP_GT_OQ);
+        __m256 inv = _mm256_blendv_ps(one, _mm256_div_ps(one, _mm256_sqrt_ps(len)), nonzero);
+        _mm256_storeu_ps(dst->x + i, _mm256_mul_ps(x, inv));
+        _mm256_storeu_ps(dst->y + i, _mm256_mul_ps(y, inv));
+        _mm256_storeu_ps(dst->z + i, _mm256_mul_ps(z, inv));
+    }
+    return i;
+}
+
+SIMD_AVX2 static size_t vec3soa_length_avx2(float* dst, vec3soa* a, size_t n) {
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(a->x + i), y = _mm256_loadu_ps(a->y + i), z = _mm256_loadu_ps(a->z + i);
+        _mm256_storeu_ps(dst + i, _mm256_sqrt_ps(_mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x)))));
+    }
+    return i;
+}
+
+SIMD_AVX2 static size_t vec3soa_lerp_avx2(vec3soa* dst, vec3soa* b, float t, size_t n) {
+    __m256 vt = _mm256_set1_ps(t);
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256 ax = _mm256_loadu_ps(dst->x + i), ay = _mm256_loadu_ps(dst->y + i), az = _mm256_loadu_ps(dst->z + i);
+        _mm256_storeu_ps(dst->x + i, _mm256_fmadd_ps(vt, _mm256_sub_ps(_mm256_loadu_ps(b->x + i), ax), ax));
+        _mm256_storeu_ps(dst->y + i, _mm256_fmadd_ps(vt, _mm256_sub_ps(_mm256_loadu_ps(b->y + i), ay), ay));
+        _mm256_storeu_ps(dst->z + i, _mm256_fmadd_ps(vt, _mm256_sub_ps(_mm256_loadu_ps(b->z + i), az), az));
+    }
+    return i;
+}
+
+SIMD_AVX2 static size_t vec3soa_transformMat4_avx2(vec3soa* dst, float* m, size_t n) {
+    __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]), m3 = _mm256_set1_ps(m[3]);
+    __m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]), m7 = _mm256_set1_ps(m[7]);
+    __m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]), m11 = _mm256_set1_ps(m[11]);
+    __m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]), m14 = _mm256_set1_ps(m[14]), m15 = _mm256_set1_ps(m[15]);
+    __m256 one = _mm256_set1_ps(1.0f);
+    size_t i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(dst->x + i), y = _mm256_loadu_ps(dst->y + i), z = _mm256_loadu_ps(dst->z + i);
+        __m256 w = _mm256_add_ps(_mm256_fmadd_ps(m11, z, _mm256_fmadd_ps(m7, y, _mm256_mul_ps(m3, x))), m15);
+        w = _mm256_blendv_ps(w, one, _mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_EQ_OQ));
+        _mm256_storeu_ps(dst->x + i, _mm256_div_ps(_mm256_add_ps(_mm256_fmadd_ps(m8, z, _mm256_fmadd_ps(m4, y, _mm256_mul_ps(m0, x))), m12), w));
+        _mm256_storeu_ps(dst->y + i, _mm256_div_ps(_mm256_add_ps(_mm256_fmadd_ps(m9, z, _mm256_fmadd_ps(m5, y, _mm256_mul_ps(m1, x))), m13), w));
+        _mm256_storeu_ps(dst->z + i, _mm256_div_ps(_mm256_add_ps(_mm256_fmadd_ps(m10, z, _mm256_fmadd_ps(m6, y, _mm256_mul_ps(m2, x))), m14), w));
+    }
+    return i;
+}
+#endif
+
+/**
+ * Copies interleaved vec3s into a vec3soa
+ *
+ * @param {vec3soa} out the receiving streams
+ * @param {vec3[]} a the interleaved source vectors
+ * @param {Number} stride floats between the start of each source vector, 0 if tightly packed
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_fromInterleaved(vec3soa* dst, float* a, size_t stride, size_t n) {
+    size_t i;
+    stride = stride ? stride : 3;
+    for (i = 0; i < n; i++) {
+        dst->x[i] = a[i * stride];
+        dst->y[i] = a[i * stride + 1];
+        dst->z[i] = a[i * stride + 2];
+    }
+}
+
+/**
+ * Copies a vec3soa out to interleaved vec3s
+ *
+ * @param {vec3[]} out the receiving interleaved vectors
+ * @param {Number} stride floats between the start of each receiving vector, 0 if tightly packed
+ * @param {vec3soa} a the source streams
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_toInterleaved(float* dst, size_t stride, vec3soa* a, size_t n) {
+    size_t i;
+    stride = stride ? stride : 3;
+    for (i = 0; i < n; i++) {
+        dst[i * stride] = a->x[i];
+        dst[i * stride + 1] = a->y[i];
+        dst[i * stride + 2] = a->z[i];
+    }
+}
+
+/**
+ * Adds two batches of vec3s
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {vec3soa} b the second operands
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_add(vec3soa* dst, vec3soa* b, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (vec3soa_use_avx2) {
+        i = vec3soa_add_avx2(dst, b, n);
+    }
+#endif
+    for (; i < n; i++) {
+        dst->x[i] = dst->x[i] + b->x[i];
+        dst->y[i] = dst->y[i] + b->y[i];
+        dst->z[i] = dst->z[i] + b->z[i];
+    }
+}
+
+/**
+ * Scales a batch of vec3s by a scalar number
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {Number} b amount to scale the vectors by
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_scale(vec3soa* dst, float b, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (vec3soa_use_avx2) {
+        i = vec3soa_scale_avx2(dst, b, n);
+    }
+#endif
+    for (; i < n; i++) {
+        dst->x[i] = dst->x[i] * b;
+        dst->y[i] = dst->y[i] * b;
+        dst->z[i] = dst->z[i] * b;
+    }
+}
+
+/**
+ * Adds two batches of vec3s after scaling the second operands by a scalar value
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {vec3soa} b the second operands
+ * @param {Number} scale the amount to scale b by before adding
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_scaleAndAdd(vec3soa* dst, vec3soa* b, float scale, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (vec3soa_use_avx2) {
+        i = vec3soa_scaleAndAdd_avx2(dst, b, scale, n);
+    }
+#endif
+    for (; i < n; i++) {
+        dst->x[i] = dst->x[i] + (b->x[i] * scale);
+        dst->y[i] = dst->y[i] + (b->y[i] * scale);
+        dst->z[i] = dst->z[i] + (b->z[i] * scale);
+    }
+}
+
+/**
+ * Calculates the dot products of two batches of vec3s
+ *
+ * @param {Number[]} out array of n receiving dot products
+ * @param {vec3soa} a the first operands
+ * @param {vec3soa} b the second operands
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_dot(float* dst, vec3soa* a, vec3soa* b, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (vec3soa_use_avx2) {
+        i = vec3soa_dot_avx2(dst, a, b, n);
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = a->x[i] * b->x[i] + a->y[i] * b->y[i] + a->z[i] * b->z[i];
+    }
+}
+
+/**
+ * Computes the cross products of two batches of vec3s
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {vec3soa} b the second operands
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_cross(vec3soa* dst, vec3soa* b, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (vec3soa_use_avx2) {
+        i = vec3soa_cross_avx2(dst, b, n);
+    }
+#endif
+    for (; i < n; i++) {
+        float ax = dst->x[i], ay = dst->y[i], az = dst->z[i];
+        float bx = b->x[i], by = b->y[i], bz = b->z[i];
+
+        dst->x[i] = ay * bz - az * by;
+        dst->y[i] = az * bx - ax * bz;
+        dst->z[i] = ax * by - ay * bx;
+    }
+}
+
+/**
+ * Normalize a batch of vec3s. Zero length vectors are left unchanged.
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_normalize(vec3soa* dst, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (vec3soa_use_avx2) {
+        i = vec3soa_normalize_avx2(dst, n);
+    }
+#endif
+    for (; i < n; i++) {
+        float x = dst->x[i], y = dst->y[i], z = dst->z[i];
+        float len = x*x + y*y + z*z;
+        if (len > 0) {
+            len = 1 / sqrtf(len);
+            dst->x[i] = x * len;
+            dst->y[i] = y * len;
+            dst->z[i] = z * len;
+        }
+    }
+}
+
+/**
+ * Calculates the lengths of a batch of vec3s
+ *
+ * @param {Number[]} out array of n receiving lengths
+ * @param {vec3soa} a vectors to calculate length of
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_length(float* dst, vec3soa* a, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (vec3soa_use_avx2) {
+        i = vec3soa_length_avx2(dst, a, n);
+    }
+#endif
+    for (; i < n; i++) {
+        float x = a->x[i], y = a->y[i], z = a->z[i];
+        dst[i] = sqrtf(x*x + y*y + z*z);
+    }
+}
+
+/**
+ * Performs a linear interpolation between two batches of vec3s
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {vec3soa} b the second operands
+ * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_lerp(vec3soa* dst, vec3soa* b, float t, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (vec3soa_use_avx2) {
+        i = vec3soa_lerp_avx2(dst, b, t, n);
+    }
+#endif
+    for (; i < n; i++) {
+        float ax = dst->x[i], ay = dst->y[i], az = dst->z[i];
+        dst->x[i] = ax + t * (b->x[i] - ax);
+        dst->y[i] = ay + t * (b->y[i] - ay);
+        dst->z[i] = az + t * (b->z[i] - az);
+    }
+}
+
+/**
+ * Transforms a batch of vec3s with a mat4.
+ * 4th vector component is implicitly '1'
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {mat4} m matrix to transform with
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_transformMat4(vec3soa* dst, float* m, size_t n) {
+    size_t i = 0;
+#if GL_MATRIX_SIMD
+    if (vec3soa_use_avx2) {
+        i = vec3soa_transformMat4_avx2(dst, m, n);
+    }
+#endif
+    for (; i < n; i++) {
+        float x = dst->x[i], y = dst->y[i], z = dst->z[i];
+        float w = m[3] * x + m[7] * y + m[11] * z + m[15];
+        w = w ? w : 1.0;
+        dst->x[i] = (m[0] * x + m[4] * y + m[8] * z + m[12]) / w;
+        dst->y[i] = (m[1] * x + m[5] * y + m[9] * z + m[13]) / w;
+        dst->z[i] = (m[2] * x + m[6] * y + m[10] * z + m[14]) / w;
+    }
+}
@@ -0,0 +1,127 @@
+#ifndef VEC3SOA_H
+#define VEC3SOA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+
+/**
+ * A batch of vec3s stored as three separate component streams
+ * (structure of arrays). Each stream holds at least n floats for the
+ * functions it is passed to. The struct only points at caller storage.
+ *
+ * The batch functions run 8 lanes at a time with AVX2/FMA when the CPU
+ * supports it. Fused multiply-adds may make results differ from the
+ * single vector functions by a few ULP.
+ */
+typedef struct {
+    float* x;
+    float* y;
+    float* z;
+} vec3soa;
+
+/**
+ * Copies interleaved vec3s into a vec3soa
+ *
+ * @param {vec3soa} out the receiving streams
+ * @param {vec3[]} a the interleaved source vectors
+ * @param {Number} stride floats between the start of each source vector, 0 if tightly packed
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_fromInterleaved(vec3soa* dst, float* a, size_t stride, size_t n);
+
+/**
+ * Copies a vec3soa out to interleaved vec3s
+ *
+ * @param {vec3[]} out the receiving interleaved vectors
+ * @param {Number} stride floats between the start of each receiving vector, 0 if tightly packed
+ * @param {vec3soa} a the source streams
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_toInterleaved(float* dst, size_t stride, vec3soa* a, size_t n);
+
+/**
+ * Adds two batches of vec3s
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {vec3soa} b the second operands
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_add(vec3soa* dst, vec3soa* b, size_t n);
+
+/**
+ * Scales a batch of vec3s by a scalar number
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {Number} b amount to scale the vectors by
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_scale(vec3soa* dst, float b, size_t n);
+
+/**
+ * Adds two batches of vec3s after scaling the second operands by a scalar value
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {vec3soa} b the second operands
+ * @param {Number} scale the amount to scale b by before adding
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_scaleAndAdd(vec3soa* dst, vec3soa* b, float scale, size_t n);
+
+/**
+ * Calculates the dot products of two batches of vec3s
+ *
+ * @param {Number[]} out array of n receiving dot products
+ * @param {vec3soa} a the first operands
+ * @param {vec3soa} b the second operands
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_dot(float* dst, vec3soa* a, vec3soa* b, size_t n);
+
+/**
+ * Computes the cross products of two batches of vec3s
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {vec3soa} b the second operands
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_cross(vec3soa* dst, vec3soa* b, size_t n);
+
+/**
+ * Normalize a batch of vec3s. Zero length vectors are left unchanged.
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_normalize(vec3soa* dst, size_t n);
+
+/**
+ * Calculates the lengths of a batch of vec3s
+ *
+ * @param {Number[]} out array of n receiving lengths
+ * @param {vec3soa} a vectors to calculate length of
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_length(float* dst, vec3soa* a, size_t n);
+
+/**
+ * Performs a linear interpolation between two batches of vec3s
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {vec3soa} b the second operands
+ * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_lerp(vec3soa* dst, vec3soa* b, float t, size_t n);
+
+/**
+ * Transforms a batch of vec3s with a mat4.
+ * 4th vector component is implicitly '1'
+ *
+ * @param {vec3soa} out the receiving vectors
+ * @param {mat4} m matrix to transform with
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec3soa_transformMat4(vec3soa* dst, float* m, size_t n);
+
+#endif
@@ -1,4 +1,6 @@
 #include "vec4.h"
+#include "cpu.h"
+#include "simd.h"
 #include <math.h>
 
 /**
@@ -7,7 +9,7 @@
  * @param {vec4} out the receiving vector
  * @param {vec4} a the source vector
  */
-void vec4_copy(float* dst, float* a) {
+GL_MATRIX_API void vec4_copy(float* dst, float* a) {
     dst[0] = a[0];
     dst[1] = a[1];
     dst[2] = a[2];
@@ -23,7 +25,7 @@ void vec4_copy(float* dst, float* a) {
  * @param {Number} z Z component
  * @param {Number} w W component
  */
-void vec4_set(float* dst, float x, float y, float z, float w) {
+GL_MATRIX_API void vec4_set(float* dst, float x, float y, float z, float w) {
     dst[0] = x;
     dst[1] = y;
     dst[2] = z;
@@ -37,7 +39,7 @@ void vec4_set(float* dst, float x, float y, float z, float w) {
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_add(float* dst, float* b) {
+GL_MATRIX_API void vec4_add(float* dst, float* b) {
     dst[0] = dst[0] + b[0];
     dst[1] = dst[1] + b[1];
     dst[2] = dst[2] + b[2];
@@ -51,7 +53,7 @@ void vec4_add(float* dst, float* b) {
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_subtract(float* dst, float* b) {
+GL_MATRIX_API void vec4_subtract(float* dst, float* b) {
     dst[0] = dst[0] - b[0];
     dst[1] = dst[1] - b[1];
     dst[2] = dst[2] - b[2];
@@ -65,7 +67,7 @@ void vec4_subtract(float* dst, float* b) {
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_multiply(float* dst, float* b) {
+GL_MATRIX_API void vec4_multiply(float* dst, float* b) {
     dst[0] = dst[0] * b[0];
     dst[1] = dst[1] * b[1];
     dst[2] = dst[2] * b[2];
@@ -79,7 +81,7 @@ void vec4_multiply(float* dst, float* b) {
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_divide(float* dst, float* b) {
+GL_MATRIX_API void vec4_divide(float* dst, float* b) {
     dst[0] = dst[0] / b[0];
     dst[1] = dst[1] / b[1];
     dst[2] = dst[2] / b[2];
@@ -92,7 +94,7 @@ void vec4_divide(float* dst, float* b) {
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to ceil
  */
-void vec4_ceil(float* dst) {
+GL_MATRIX_API void vec4_ceil(float* dst) {
     dst[0] = ceilf(dst[0]);
     dst[1] = ceilf(dst[1]);
     dst[2] = ceilf(dst[2]);
@@ -105,7 +107,7 @@ void vec4_ceil(float* dst) {
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to floor
  */
-void vec4_floor(float* dst) {
+GL_MATRIX_API void vec4_floor(float* dst) {
     dst[0] = floorf(dst[0]);
     dst[1] = floorf(dst[1]);
     dst[2] = floorf(dst[2]);
@@ -119,7 +121,7 @@ void vec4_floor(float* dst) {
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_min(float* dst, float* b) {
+GL_MATRIX_API void vec4_min(float* dst, float* b) {
     dst[0] = fmin(dst[0], b[0]);
     dst[1] = fmin(dst[1], b[1]);
     dst[2] = fmin(dst[2], b[2]);
@@ -133,7 +135,7 @@ void vec4_min(float* dst, float* b) {
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_max(float* dst, float* b) {
+GL_MATRIX_API void vec4_max(float* dst, float* b) {
     dst[0] = fmax(dst[0], b[0]);
     dst[1] = fmax(dst[1], b[1]);
     dst[2] = fmax(dst[2], b[2]);
@@ -146,7 +148,7 @@ void vec4_max(float* dst, float* b) {
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to round
  */
-void vec4_round(float* dst) {
+GL_MATRIX_API void vec4_round(float* dst) {
     dst[0] = roundf(dst[0]);
     dst[1] = roundf(dst[1]);
     dst[2] = roundf(dst[2]);
@@ -160,7 +162,7 @@ void vec4_round(float* dst) {
  * @param {vec4} a the vector to scale
  * @param {Number} b amount to scale the vector by
  */
-void vec4_scale(float* dst, float b) {
+GL_MATRIX_API void vec4_scale(float* dst, float b) {
     dst[0] = dst[0] * b;
     dst[1] = dst[1] * b;
     dst[2] = dst[2] * b;
@@ -174,7 +176,7 @@ void vec4_scale(float* dst, float b) {
  * @param {vec4} b the second operand
  * @param {Number} scale the amount to scale b by before adding
  */
-void vec4_scaleAndAdd(float* dst, float* b, float scale) {
+GL_MATRIX_API void vec4_scaleAndAdd(float* dst, float* b, float scale) {
     dst[0] = dst[0] + (b[0] * scale);
     dst[1] = dst[1] + (b[1] * scale);
     dst[2] = dst[2] + (b[2] * scale);
@@ -188,7 +190,7 @@ void vec4_scaleAndAdd(float* dst, float* b, float scale) {
  * @param {vec4} b the second operand
  * @returns {Number} distance between a and b
  */
-float vec4_distance(float* a, float* b) {
+GL_MATRIX_API float vec4_distance(float* a, float* b) {
     float x = b[0] - a[0];
     float y = b[1] - a[1];
     float z = b[2] - a[2];
@@ -203,7 +205,7 @@ float vec4_distance(float* a, float* b) {
  * @param {vec4} b the second operand
  * @returns {Number} squared distance between a and b
  */
-float vec4_squaredDistance(float* a, float* b) {
+GL_MATRIX_API float vec4_squaredDistance(float* a, float* b) {
     float x = b[0] - a[0];
     float y = b[1] - a[1];
     float z = b[2] - a[2];
@@ -217,7 +219,7 @@ float vec4_squaredDistance(float* a, float* b) {
  * @param {vec4} a vector to calculate length of
  * @returns {Number} length of a
  */
-float vec4_length(float* a) {
+GL_MATRIX_API float vec4_length(float* a) {
     float x = a[0];
     float y = a[1];
     float z = a[2];
@@ -231,7 +233,7 @@ float vec4_length(float* a) {
  * @param {vec4} a vector to calculate squared length of
  * @returns {Number} squared length of a
  */
-float vec4_squaredLength(float* a) {
+GL_MATRIX_API float vec4_squaredLength(float* a) {
     float x = a[0];
     float y = a[1];
     float z = a[2];
@@ -245,7 +247,7 @@ float vec4_squaredLength(float* a) {
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to negate
  */
-void vec4_negate(float* dst) {
+GL_MATRIX_API void vec4_negate(float* dst) {
     dst[0] = -dst[0];
     dst[1] = -dst[1];
     dst[2] = -dst[2];
@@ -258,7 +260,7 @@ void vec4_negate(float* dst) {
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to invert
  */
-void vec4_inverse(float* dst) {
+GL_MATRIX_API void vec4_inverse(float* dst) {
     dst[0] = 1.0 / dst[0];
     dst[1] = 1.0 / dst[1];
     dst[2] = 1.0 / dst[2];
@@ -271,7 +273,7 @@ void vec4_inverse(float* dst) {
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to normalize
  */
-void vec4_normalize(float* dst) {
+GL_MATRIX_API void vec4_normalize(float* dst) {
     float x = dst[0];
     float y = dst[1];
     float z = dst[2];
@@ -293,7 +295,7 @@ void vec4_normalize(float* dst) {
  * @param {vec4} b the second operand
  * @returns {Number} dot product of a and b
  */
-float vec4_dot(float* a, float* b) {
+GL_MATRIX_API float vec4_dot(float* a, float* b) {
     return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
 }
 
@@ -304,7 +306,7 @@ float vec4_dot(float* a, float* b) {
  * @param {vec4} b the second operand
  * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
  */
-void vec4_lerp(float* dst, float* b, float t) {
+GL_MATRIX_API void vec4_lerp(float* dst, float* b, float t) {
     float ax = dst[0];
     float ay = dst[1];
     float az = dst[2];
@@ -321,7 +323,7 @@ void vec4_lerp(float* dst, float* b, float t) {
  * @param {vec4} out the receiving vector
  * @param {mat4} m matrix to transform with
  */
-void vec4_transformMat4(float* dst, float* m) {
+GL_MATRIX_API void vec4_transformMat4(float* dst, float* m) {
     float x = dst[0], y = dst[1], z = dst[2], w = dst[3];
     dst[0] = m[0] * x + m[4] * y + m[8] * z + m[12] * w;
     dst[1] = m[1] * x + m[5] * y + m[9] * z + m[13] * w;
@@ -329,13 +331,105 @@ void vec4_transformMat4(float* dst, float* m) {
     dst[3] = m[3] * x + m[7] * y + m[11] * z + m[15] * w;
 }
 
+#if GL_MATRIX_SIMD
+// Same evaluation order as vec4_transformMat4, so results are bit-identical
+SIMD_SSE41 static void vec4_transformMat4_sse41(float* dst, float* m) {
+    __m128 v = _mm_load_ps(dst);
+    __m128 r = _mm_mul_ps(_mm_load_ps(m), _mm_shuffle_ps(v, v, 0x00));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 4), _mm_shuffle_ps(v, v, 0x55)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 8), _mm_shuffle_ps(v, v, 0xaa)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 12), _mm_shuffle_ps(v, v, 0xff)));
+    _mm_store_ps(dst, r);
+}
+#endif
+
+static uint8_t vec4_use_sse41 = 0;
+
+__attribute__((constructor))
+static void vec4_dispatch(void) {
+    vec4_use_sse41 = (cpu_features() & CPU_SSE41) != 0;
+}
+
+// Float only
+/**
+ * vec4_transformMat4 for a vector and a matrix aligned to VEC4_ALIGNMENT
+ *
+ * @param {vec4} out the receiving vector
+ * @param {mat4} m matrix to transform with
+ */
+GL_MATRIX_API void vec4_transformMat4_aligned(float* dst, float* m) {
+    SIMD_ASSERT_ALIGNED(dst, VEC4_ALIGNMENT);
+    SIMD_ASSERT_ALIGNED(m, VEC4_ALIGNMENT);
+#if GL_MATRIX_SIMD
+    if (vec4_use_sse41) {
+        vec4_transformMat4_sse41(dst, m);
+        return;
+    }
+#endif
+    vec4_transformMat4(dst, m);
+}
+// End float only
+
+static void vec4_transformMat4_n_scalar(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        float* s = src + i * src_stride;
+        float* d = dst + i * dst_stride;
+        float x = s[0], y = s[1], z = s[2], w = s[3];
+        d[0] = m[0] * x + m[4] * y + m[8] * z + m[12] * w;
+        d[1] = m[1] * x + m[5] * y + m[9] * z + m[13] * w;
+        d[2] = m[2] * x + m[6] * y + m[10] * z + m[14] * w;
+        d[3] = m[3] * x + m[7] * y + m[11] * z + m[15] * w;
+    }
+}
+
+#if GL_MATRIX_SIMD
+// The matrix stays in registers for the whole array, same order as vec4_transformMat4
+SIMD_SSE41 static void vec4_transformMat4_n_sse41(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n) {
+    __m128 c0 = _mm_loadu_ps(m), c1 = _mm_loadu_ps(m + 4), c2 = _mm_loadu_ps(m + 8), c3 = _mm_loadu_ps(m + 12);
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        __m128 v = _mm_loadu_ps(src + i * src_stride);
+        __m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(v, v, 0x55)));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(v, v, 0xaa)));
+        r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(v, v, 0xff)));
+        _mm_storeu_ps(dst + i * dst_stride, r);
+    }
+}
+#endif
+
+/**
+ * Transforms an array of vec4s with a mat4
+ *
+ * @param {vec4[]} out the receiving vectors
+ * @param {Number} dst_stride floats between the start of each receiving vector, 0 if tightly packed
+ * @param {vec4[]} a the source vectors, may be out itself when the strides match
+ * @param {Number} src_stride floats between the start of each source vector, 0 if tightly packed
+ * @param {mat4} m matrix to transform with
+ * @param {Number} n number of vectors to transform
+ */
+GL_MATRIX_API void vec4_transformMat4_n(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n) {
+    dst_stride = dst_stride ? dst_stride : 4;
+    src_stride = src_stride ? src_stride : 4;
+#if GL_MATRIX_SIMD
+    if (vec4_use_sse41) {
+        vec4_transformMat4_n_sse41(dst, dst_stride, src, src_stride, m, n);
+        return;
+    }
+#endif
+    vec4_transformMat4_n_scalar(dst, dst_stride, src, src_stride, m, n);
+}
+
 /**
  * Transforms the vec4 with a quat
  *
  * @param {vec4} out the receiving vector
  * @param {quat} q quaternion to transform with
  */
-void vec4_transformQuat(float* dst, float* q) {
+GL_MATRIX_API void vec4_transformQuat(float* dst, float* q) {
     float x = dst[0], y = dst[1], z = dst[2];
     float qx = q[0], qy = q[1], qz = q[2], qw = q[3];
 
@@ -359,6 +453,6 @@ void vec4_transformQuat(float* dst, float* q) {
  * @param {vec4} b The second vector.
  * @returns {Boolean} True if the vectors are equal, false otherwise.
  */
-uint8_t vec4_equals(float* a, float* b) {
+GL_MATRIX_API uint8_t vec4_equals(float* a, float* b) {
     return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
 }
@@ -1,7 +1,22 @@
 #ifndef VEC4_H
 #define VEC4_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include "api.h"
+
+// Float only
+/**
+ * Alignment in bytes of the vectors the _aligned functions take, one SSE
+ * register.
+ */
+#define VEC4_ALIGNMENT (4 * sizeof(float))
+
+/**
+ * A vec4 with VEC4_ALIGNMENT. Passes to every vec4 function.
+ */
+typedef float vec4_aligned[4] GL_MATRIX_ALIGNED(VEC4_ALIGNMENT);
+// End float only
 
 /**
  * Copy the values from one vec4 to another
@@ -9,7 +24,7 @@
  * @param {vec4} out the receiving vector
  * @param {vec4} a the source vector
  */
-void vec4_copy(float* dst, float* a);
+GL_MATRIX_API void vec4_copy(float* dst, float* a);
 
 /**
  * Set the components of a vec4 to the given values
@@ -20,7 +35,7 @@ void vec4_copy(float* dst, float* a);
  * @param {Number} z Z component
  * @param {Number} w W component
  */
-void vec4_set(float* dst, float x, float y, float z, float w);
+GL_MATRIX_API void vec4_set(float* dst, float x, float y, float z, float w);
 
 /**
  * Adds two vec4's
@@ -29,7 +44,7 @@ void vec4_set(float* dst, float x, float y, float z, float w);
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_add(float* dst, float* b);
+GL_MATRIX_API void vec4_add(float* dst, float* b);
 
 /**
  * Subtracts vector b from vector a
@@ -38,7 +53,7 @@ void vec4_add(float* dst, float* b);
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_subtract(float* dst, float* b);
+GL_MATRIX_API void vec4_subtract(float* dst, float* b);
 
 /**
  * Multiplies two vec4's
@@ -47,7 +62,7 @@ void vec4_subtract(float* dst, float* b);
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_multiply(float* dst, float* b);
+GL_MATRIX_API void vec4_multiply(float* dst, float* b);
 
 /**
  * Divides two vec4's
@@ -56,7 +71,7 @@ void vec4_multiply(float* dst, float* b);
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_divide(float* dst, float* b);
+GL_MATRIX_API void vec4_divide(float* dst, float* b);
 
 /**
  * ceilf the components of a vec4
@@ -64,7 +79,7 @@ void vec4_divide(float* dst, float* b);
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to ceil
  */
-void vec4_ceil(float* dst);
+GL_MATRIX_API void vec4_ceil(float* dst);
 
 /**
  * floorf the components of a vec4
@@ -72,7 +87,7 @@ void vec4_ceil(float* dst);
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to floor
  */
-void vec4_floor(float* dst);
+GL_MATRIX_API void vec4_floor(float* dst);
 
 /**
  * Returns the minimum of two vec4's
@@ -81,7 +96,7 @@ void vec4_floor(float* dst);
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_min(float* dst, float* b);
+GL_MATRIX_API void vec4_min(float* dst, float* b);
 
 /**
  * Returns the maximum of two vec4's
@@ -90,7 +105,7 @@ void vec4_min(float* dst, float* b);
  * @param {vec4} a the first operand
  * @param {vec4} b the second operand
  */
-void vec4_max(float* dst, float* b);
+GL_MATRIX_API void vec4_max(float* dst, float* b);
 
 /**
  * roundf the components of a vec4
@@ -98,7 +113,7 @@ void vec4_max(float* dst, float* b);
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to round
  */
-void vec4_round(float* dst);
+GL_MATRIX_API void vec4_round(float* dst);
 
 /**
  * Scales a vec4 by a scalar number
@@ -107,7 +122,7 @@ void vec4_round(float* dst);
  * @param {vec4} a the vector to scale
  * @param {Number} b amount to scale the vector by
  */
-void vec4_scale(float* dst, float b);
+GL_MATRIX_API void vec4_scale(float* dst, float b);
 
 /**
  * Adds two vec4's after scaling the second operand by a scalar value
@@ -116,7 +131,7 @@ void vec4_scale(float* dst, float b);
  * @param {vec4} b the second operand
  * @param {Number} scale the amount to scale b by before adding
  */
-void vec4_scaleAndAdd(float* dst, float* b, float scale);
+GL_MATRIX_API void vec4_scaleAndAdd(float* dst, float* b, float scale);
 
 /**
  * Calculates the euclidian distance between two vec4's
@@ -125,7 +140,7 @@ void vec4_scaleAndAdd(float* dst, float* b, float scale);
  * @param {vec4} b the second operand
  * @returns {Number} distance between a and b
  */
-float vec4_distance(float* a, float* b);
+GL_MATRIX_API float vec4_distance(float* a, float* b);
 
 /**
  * Calculates the squared euclidian distance between two vec4's
@@ -134,7 +149,7 @@ float vec4_distance(float* a, float* b);
  * @param {vec4} b the second operand
  * @returns {Number} squared distance between a and b
  */
-float vec4_squaredDistance(float* a, float* b);
+GL_MATRIX_API float vec4_squaredDistance(float* a, float* b);
 
 /**
  * Calculates the length of a vec4
@@ -142,7 +157,7 @@ float vec4_squaredDistance(float* a, float* b);
  * @param {vec4} a vector to calculate length of
  * @returns {Number} length of a
  */
-float vec4_length(float* a);
+GL_MATRIX_API float vec4_length(float* a);
 
 /**
  * Calculates the squared length of a vec4
@@ -150,7 +165,7 @@ float vec4_length(float* a);
  * @param {vec4} a vector to calculate squared length of
  * @returns {Number} squared length of a
  */
-float vec4_squaredLength(float* a);
+GL_MATRIX_API float vec4_squaredLength(float* a);
 
 /**
  * Negates the components of a vec4
@@ -158,7 +173,7 @@ float vec4_squaredLength(float* a);
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to negate
  */
-void vec4_negate(float* dst);
+GL_MATRIX_API void vec4_negate(float* dst);
 
 /**
  * Returns the inverse of the components of a vec4
@@ -166,7 +181,7 @@ void vec4_negate(float* dst);
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to invert
  */
-void vec4_inverse(float* dst);
+GL_MATRIX_API void vec4_inverse(float* dst);
 
 /**
  * Normalize a vec4
@@ -174,7 +189,7 @@ void vec4_inverse(float* dst);
  * @param {vec4} out the receiving vector
  * @param {vec4} a vector to normalize
  */
-void vec4_normalize(float* dst);
+GL_MATRIX_API void vec4_normalize(float* dst);
 
 /**
  * Calculates the dot product of two vec4's
@@ -183,7 +198,7 @@ void vec4_normalize(float* dst);
  * @param {vec4} b the second operand
  * @returns {Number} dot product of a and b
  */
-float vec4_dot(float* a, float* b);
+GL_MATRIX_API float vec4_dot(float* a, float* b);
 
 /**
  * Performs a linear interpolation between two vec4's
@@ -192,7 +207,7 @@ float vec4_dot(float* a, float* b);
  * @param {vec4} b the second operand
  * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
  */
-void vec4_lerp(float* dst, float* b, float t);
+GL_MATRIX_API void vec4_lerp(float* dst, float* b, float t);
 
 /**
  * Transforms the vec4 with a mat4.
@@ -200,7 +215,35 @@ void vec4_lerp(float* dst, float* b, float t);
  * @param {vec4} out the receiving vector
  * @param {mat4} m matrix to transform with
  */
-void vec4_transformMat4(float* dst, float* m);
+GL_MATRIX_API void vec4_transformMat4(float* dst, float* m);
+
+// Float only
+/**
+ * vec4_transformMat4 for a vector and a matrix aligned to VEC4_ALIGNMENT,
+ * as vec4_aligned and mat4_aligned are. Uses an SSE4.1 kernel when the CPU
+ * supports it, bit-identical to the scalar code. Debug builds assert the
+ * alignment.
+ *
+ * @param {vec4} out the receiving vector
+ * @param {mat4} m matrix to transform with
+ */
+GL_MATRIX_API void vec4_transformMat4_aligned(float* dst, float* m);
+// End float only
+
+/**
+ * Transforms an array of vec4s with a mat4
+ *
+ * Uses an SSE4.1 kernel when the CPU supports it, bit-identical to
+ * vec4_transformMat4 on each vector.
+ *
+ * @param {vec4[]} out the receiving vectors
+ * @param {Number} dst_stride floats between the start of each receiving vector, 0 if tightly packed
+ * @param {vec4[]} a the source vectors, may be out itself when the strides match
+ * @param {Number} src_stride floats between the start of each source vector, 0 if tightly packed
+ * @param {mat4} m matrix to transform with
+ * @param {Number} n number of vectors to transform
+ */
+GL_MATRIX_API void vec4_transformMat4_n(float* dst, size_t dst_stride, float* src, size_t src_stride, float* m, size_t n);
 
 /**
  * Transforms the vec4 with a quat
@@ -208,7 +251,7 @@ void vec4_transformMat4(float* dst, float* m);
  * @param {vec4} out the receiving vector
  * @param {quat} q quaternion to transform with
  */
-void vec4_transformQuat(float* dst, float* q);
+GL_MATRIX_API void vec4_transformQuat(float* dst, float* q);
 
 /**
  * Returns whether or not the vectors have exactly the same elements
@@ -217,6 +260,6 @@ void vec4_transformQuat(float* dst, float* q);
  * @param {vec4} b The second vector.
  * @returns {Boolean} True if the vectors are equal, false otherwise.
  */
-uint8_t vec4_equals(float* a, float* b);
+GL_MATRIX_API uint8_t vec4_equals(float* a, float* b);
 
 #endif
@@ -0,0 +1,118 @@
+#ifndef VEC4SOA_H
+#define VEC4SOA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+
+/**
+ * A batch of vec4s stored as four separate component streams
+ * (structure of arrays). Each stream holds at least n floats for the
+ * functions it is passed to. The struct only points at caller storage.
+ *
+ * The batch functions run 8 lanes at a time with AVX2/FMA when the CPU
+ * supports it. Fused multiply-adds may make results differ from the
+ * single vector functions by a few ULP.
+ */
+typedef struct {
+    float* x;
+    float* y;
+    float* z;
+    float* w;
+} vec4soa;
+
+/**
+ * Copies interleaved vec4s into a vec4soa
+ *
+ * @param {vec4soa} out the receiving streams
+ * @param {vec4[]} a the interleaved source vectors
+ * @param {Number} stride floats between the start of each source vector, 0 if tightly packed
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec4soa_fromInterleaved(vec4soa* dst, float* a, size_t stride, size_t n);
+
+/**
+ * Copies a vec4soa out to interleaved vec4s
+ *
+ * @param {vec4[]} out the receiving interleaved vectors
+ * @param {Number} stride floats between the start of each receiving vector, 0 if tightly packed
+ * @param {vec4soa} a the source streams
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec4soa_toInterleaved(float* dst, size_t stride, vec4soa* a, size_t n);
+
+/**
+ * Adds two batches of vec4s
+ *
+ * @param {vec4soa} out the receiving vectors
+ * @param {vec4soa} b the second operands
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec4soa_add(vec4soa* dst, vec4soa* b, size_t n);
+
+/**
+ * Scales a batch of vec4s by a scalar number
+ *
+ * @param {vec4soa} out the receiving vectors
+ * @param {Number} b amount to scale the vectors by
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec4soa_scale(vec4soa* dst, float b, size_t n);
+
+/**
+ * Adds two batches of vec4s after scaling the second operands by a scalar value
+ *
+ * @param {vec4soa} out the receiving vectors
+ * @param {vec4soa} b the second operands
+ * @param {Number} scale the amount to scale b by before adding
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec4soa_scaleAndAdd(vec4soa* dst, vec4soa* b, float scale, size_t n);
+
+/**
+ * Calculates the dot products of two batches of vec4s
+ *
+ * @param {Number[]} out array of n receiving dot products
+ * @param {vec4soa} a the first operands
+ * @param {vec4soa} b the second operands
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec4soa_dot(float* dst, vec4soa* a, vec4soa* b, size_t n);
+
+/**
+ * Normalize a batch of vec4s. Zero length vectors are left unchanged.
+ *
+ * @param {vec4soa} out the receiving vectors
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec4soa_normalize(vec4soa* dst, size_t n);
+
+/**
+ * Calculates the lengths of a batch of vec4s
+ *
+ * @param {Number[]} out array of n receiving lengths
+ * @param {vec4soa} a vectors to calculate length of
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec4soa_length(float* dst, vec4soa* a, size_t n);
+
+/**
+ * Performs a linear interpolation between two batches of vec4s
+ *
+ * @param {vec4soa} out the receiving vectors
+ * @param {vec4soa} b the second operands
+ * @param {Number} t interpolation amount, in the range [0-1], between the two inputs
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec4soa_lerp(vec4soa* dst, vec4soa* b, float t, size_t n);
+
+/**
+ * Transforms a batch of vec4s with a mat4.
+ *
+ * @param {vec4soa} out the receiving vectors
+ * @param {mat4} m matrix to transform with
+ * @param {Number} n number of vectors
+ */
+GL_MATRIX_API void vec4soa_transformMat4(vec4soa* dst, float* m, size_t n);
+
+#endif